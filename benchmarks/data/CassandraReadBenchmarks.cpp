@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/BackendCounters.hpp"
+#include "data/Types.hpp"
+#include "data/cassandra/Error.hpp"
+#include "data/cassandra/impl/Cluster.hpp"
+#include "data/cassandra/impl/ExecutionStrategy.hpp"
+#include "data/cassandra/impl/KeyBatches.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <cassandra.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using data::cassandra::CassandraError;
+using data::cassandra::Settings;
+
+// roughly the size of an average ledger object
+constexpr std::size_t OBJECT_SIZE = 256;
+
+struct FakeStatement {
+    std::vector<ripple::uint256> keys;
+};
+
+struct FakeResult {
+    std::vector<std::pair<ripple::uint256, data::Blob>> rows;
+};
+
+struct FakeResultOrError {
+    FakeResult result;
+
+    operator bool() const
+    {
+        return true;
+    }
+
+    FakeResult&
+    value()
+    {
+        return result;
+    }
+
+    static CassandraError
+    error()
+    {
+        return CassandraError{"<none>", CASS_OK};
+    }
+};
+
+struct FakeFuture {
+    std::shared_future<FakeResultOrError> future;
+
+    FakeResultOrError
+    get() const
+    {
+        return future.get();
+    }
+};
+
+/**
+ * @brief A handle that answers every query with one row per key, on its own threads like the driver does.
+ *
+ * There is no network involved, so the benchmark only measures what the client side pays per request: a future, a
+ * callback hopping threads, an atomic decrement and a result object.
+ */
+class MockHandle {
+    mutable boost::asio::thread_pool driverThreads_{2};
+    data::Blob object_ = data::Blob(OBJECT_SIZE, 'x');
+
+public:
+    using ResultOrErrorType = FakeResultOrError;
+    using MaybeErrorType = FakeResultOrError;
+    using FutureWithCallbackType = FakeFuture;
+    using FutureType = FakeFuture;
+    using StatementType = FakeStatement;
+    using PreparedStatementType = FakeStatement;
+    using ResultType = FakeResult;
+
+    ~MockHandle()
+    {
+        driverThreads_.join();
+    }
+
+    MockHandle() = default;
+    MockHandle(MockHandle const&) = delete;
+    MockHandle&
+    operator=(MockHandle const&) = delete;
+
+    template <typename HandlerType>
+    FutureWithCallbackType
+    asyncExecute(StatementType const& statement, HandlerType&& handler) const
+    {
+        auto promise = std::make_shared<std::promise<FakeResultOrError>>();
+        auto future = FakeFuture{promise->get_future().share()};
+
+        boost::asio::post(driverThreads_, [this, &statement, promise, handler]() mutable {
+            FakeResultOrError response;
+            for (auto const& key : statement.keys)
+                response.result.rows.emplace_back(key, object_);
+
+            promise->set_value(response);
+            handler(response);
+        });
+
+        return future;
+    }
+};
+
+using ExecutionStrategy = data::cassandra::impl::DefaultExecutionStrategy<MockHandle, data::BackendCounters>;
+
+void
+initPrometheus()
+{
+    static bool const initialized = [] {
+        PrometheusService::init();
+        return true;
+    }();
+    (void)initialized;
+}
+
+std::vector<ripple::uint256>
+generateKeys(std::size_t count)
+{
+    std::mt19937_64 engine{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<ripple::uint256> keys(count);
+    for (auto& key : keys)
+        std::generate(key.begin(), key.end(), [&engine]() { return static_cast<unsigned char>(engine()); });
+
+    return keys;
+}
+
+// the way objects were read before: one statement per key
+std::vector<data::Blob>
+fetchPerKey(ExecutionStrategy& executor, std::vector<ripple::uint256> const& keys, boost::asio::yield_context yield)
+{
+    std::vector<FakeStatement> statements;
+    statements.reserve(keys.size());
+    std::ranges::transform(keys, std::back_inserter(statements), [](auto const& key) {
+        return FakeStatement{.keys = {key}};
+    });
+
+    std::vector<data::Blob> results;
+    results.reserve(keys.size());
+    for (auto const& result : executor.readEach(yield, statements))
+        results.push_back(result.rows.empty() ? data::Blob{} : result.rows.front().second);
+
+    return results;
+}
+
+// one IN query per batch of keys grouped by token, results put back in the order of the keys
+std::vector<data::Blob>
+fetchBatched(ExecutionStrategy& executor, std::vector<ripple::uint256> const& keys, boost::asio::yield_context yield)
+{
+    std::vector<FakeStatement> statements;
+    for (auto& batch : data::cassandra::impl::makeKeyBatches(keys, Settings::DEFAULT_READ_BATCH_SIZE))
+        statements.push_back(FakeStatement{.keys = std::move(batch)});
+
+    std::unordered_map<ripple::uint256, data::Blob, ripple::hardened_hash<>> fetched;
+    fetched.reserve(keys.size());
+    for (auto& result : executor.readEach(yield, statements)) {
+        for (auto& [key, object] : result.rows)
+            fetched.try_emplace(key, std::move(object));
+    }
+
+    std::vector<data::Blob> results;
+    results.reserve(keys.size());
+    std::ranges::transform(keys, std::back_inserter(results), [&fetched](auto const& key) -> data::Blob {
+        if (auto const it = fetched.find(key); it != fetched.end())
+            return it->second;
+
+        return {};
+    });
+
+    return results;
+}
+
+template <auto Fetch>
+void
+benchmarkFetchObjects(benchmark::State& state)
+{
+    initPrometheus();
+    auto const keys = generateKeys(state.range(0));
+
+    MockHandle const handle;
+    ExecutionStrategy executor{Settings{}, handle};
+
+    // results arrive on the driver threads, so the context has to be kept alive while waiting for them
+    boost::asio::io_context ioc;
+    auto work = std::optional{boost::asio::make_work_guard(ioc)};
+
+    boost::asio::spawn(ioc, [&](boost::asio::yield_context yield) {
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Fetch(executor, keys, yield));
+
+        work.reset();
+    });
+    ioc.run();
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+// 2000 keys is what a full `ledger` or a large `account_objects` request reads at once
+BENCHMARK(benchmarkFetchObjects<fetchPerKey>)->Arg(100)->Arg(2'000)->Arg(10'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(benchmarkFetchObjects<fetchBatched>)->Arg(100)->Arg(2'000)->Arg(10'000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,585 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/DBHelpers.hpp"
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/LedgerFormats.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STObject.h>
+#include <xrpl/protocol/STVector256.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <set>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t LOAD_PAGE_SIZE = 512;
+constexpr std::uint32_t SEQ = 100;
+
+/** @brief The cache implementation that was used before the B+tree based one; kept as a baseline */
+class MapCache {
+    struct CacheEntry {
+        std::uint32_t seq = 0;
+        data::Blob blob;
+    };
+
+    mutable std::shared_mutex mtx_;
+    std::map<ripple::uint256, CacheEntry> map_;
+    std::uint32_t latestSeq_ = 0;
+
+public:
+    void
+    update(std::vector<data::LedgerObject> const& objs, std::uint32_t seq, bool)
+    {
+        std::scoped_lock const lck{mtx_};
+        latestSeq_ = std::max(latestSeq_, seq);
+        for (auto const& obj : objs) {
+            auto& e = map_[obj.key];
+            if (seq > e.seq)
+                e = {seq, obj.blob};
+        }
+    }
+
+    std::optional<data::Blob>
+    get(ripple::uint256 const& key, std::uint32_t seq) const
+    {
+        std::shared_lock const lck{mtx_};
+        if (seq > latestSeq_)
+            return std::nullopt;
+        auto e = map_.find(key);
+        if (e == map_.end() or seq < e->second.seq)
+            return std::nullopt;
+        return e->second.blob;
+    }
+
+    std::optional<data::LedgerObject>
+    getSuccessor(ripple::uint256 const& key, std::uint32_t) const
+    {
+        std::shared_lock const lck{mtx_};
+        auto e = map_.upper_bound(key);
+        if (e == map_.end())
+            return std::nullopt;
+        return data::LedgerObject{e->first, e->second.blob};
+    }
+
+    std::uint32_t
+    latestLedgerSequence() const
+    {
+        std::shared_lock const lck{mtx_};
+        return latestSeq_;
+    }
+};
+
+std::vector<data::LedgerObject>
+generateObjects(std::size_t count)
+{
+    std::mt19937_64 rng{count};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> blobSize{80, 400};
+
+    std::vector<data::LedgerObject> objects(count);
+    for (auto& obj : objects) {
+        for (auto& byte : obj.key)
+            byte = static_cast<unsigned char>(rng());
+        obj.blob.resize(blobSize(rng));
+        for (auto& byte : obj.blob)
+            byte = static_cast<unsigned char>(rng());
+    }
+
+    return objects;
+}
+
+/**
+ * @brief Generate objects laid out like serialized AccountRoot, RippleState and Offer ledger entries.
+ *
+ * Unlike random bytes these compress like real ledger objects do: field headers repeat in every object, accounts and
+ * currencies come from a limited set and hashes are incompressible.
+ */
+std::vector<data::LedgerObject>
+generateLedgerLikeObjects(std::size_t count)
+{
+    static constexpr std::size_t NUM_ACCOUNTS = 50'000;
+    static constexpr std::size_t NUM_CURRENCIES = 200;
+
+    std::mt19937_64 rng{count};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    auto const randomBytes = [&rng](std::size_t size) {
+        data::Blob bytes(size);
+        for (auto& byte : bytes)
+            byte = static_cast<unsigned char>(rng());
+        return bytes;
+    };
+
+    std::vector<data::Blob> accounts;
+    for (std::size_t i = 0; i < NUM_ACCOUNTS; ++i)
+        accounts.push_back(randomBytes(20));
+    std::vector<data::Blob> currencies;
+    for (std::size_t i = 0; i < NUM_CURRENCIES; ++i) {
+        data::Blob currency(20, 0);
+        std::ranges::copy(randomBytes(3), currency.begin() + 12);
+        currencies.push_back(std::move(currency));
+    }
+
+    auto const append =
+        [](data::Blob& blob, std::initializer_list<unsigned char> fieldHeader, data::Blob const& value) {
+            blob.insert(blob.end(), fieldHeader);
+            blob.insert(blob.end(), value.begin(), value.end());
+        };
+    auto const smallNumber = [&rng](std::size_t size) {
+        data::Blob bytes(size, 0);
+        bytes.back() = static_cast<unsigned char>(rng() % 16);
+        return bytes;
+    };
+    auto const amount = [&](bool issued) {
+        if (not issued)
+            return data::Blob{0x40, 0x00, 0x00, 0x00, 0x05, 0xF5, 0xE1, 0x00};
+
+        auto value = randomBytes(8);
+        value[0] = 0xD4;
+        auto const& currency = currencies[rng() % currencies.size()];
+        value.insert(value.end(), currency.begin(), currency.end());
+        auto const& issuer = accounts[rng() % 100];
+        value.insert(value.end(), issuer.begin(), issuer.end());
+        return value;
+    };
+
+    std::vector<data::LedgerObject> objects(count);
+    for (auto& obj : objects) {
+        for (auto& byte : obj.key)
+            byte = static_cast<unsigned char>(rng());
+
+        auto& blob = obj.blob;
+        switch (rng() % 3) {
+            case 0:  // AccountRoot
+                append(blob, {0x11}, {0x00, 0x61});
+                append(blob, {0x22}, smallNumber(4));
+                append(blob, {0x24}, randomBytes(4));
+                append(blob, {0x25}, randomBytes(4));
+                append(blob, {0x2D}, smallNumber(4));
+                append(blob, {0x55}, randomBytes(32));
+                append(blob, {0x62}, amount(false));
+                append(blob, {0x81, 0x14}, accounts[rng() % accounts.size()]);
+                break;
+            case 1:  // RippleState
+                append(blob, {0x11}, {0x00, 0x72});
+                append(blob, {0x22}, {0x00, 0x02, 0x00, 0x00});
+                append(blob, {0x25}, randomBytes(4));
+                append(blob, {0x37}, smallNumber(8));
+                append(blob, {0x38}, smallNumber(8));
+                append(blob, {0x55}, randomBytes(32));
+                append(blob, {0x61}, amount(true));
+                append(blob, {0x66}, amount(true));
+                append(blob, {0x67}, amount(true));
+                break;
+            default:  // Offer
+                append(blob, {0x11}, {0x00, 0x6F});
+                append(blob, {0x22}, smallNumber(4));
+                append(blob, {0x24}, randomBytes(4));
+                append(blob, {0x25}, randomBytes(4));
+                append(blob, {0x34}, smallNumber(8));
+                append(blob, {0x35}, smallNumber(8));
+                append(blob, {0x50, 0x10}, randomBytes(32));
+                append(blob, {0x55}, randomBytes(32));
+                append(blob, {0x64}, amount(true));
+                append(blob, {0x65}, amount(false));
+                append(blob, {0x81, 0x14}, accounts[rng() % accounts.size()]);
+                break;
+        }
+    }
+
+    return objects;
+}
+
+/** @brief LedgerCache storing its objects compressed */
+struct CompressedLedgerCache : data::LedgerCache {
+    CompressedLedgerCache()
+    {
+        enableCompression();
+    }
+};
+
+std::size_t
+residentBytes()
+{
+    std::size_t pages = 0;
+    std::size_t resident = 0;
+    std::ifstream statm{"/proc/self/statm"};
+    statm >> pages >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+void
+initPrometheus()
+{
+    static bool const initialized = [] {
+        PrometheusService::init();
+        return true;
+    }();
+    (void)initialized;
+}
+
+template <typename CacheType>
+void
+load(CacheType& cache, std::vector<data::LedgerObject> const& objects)
+{
+    // same page size the cache loader uses by default
+    for (std::size_t i = 0; i < objects.size(); i += LOAD_PAGE_SIZE) {
+        auto const end = std::min(objects.size(), i + LOAD_PAGE_SIZE);
+        std::vector<data::LedgerObject> const page(objects.begin() + i, objects.begin() + end);
+        cache.update(page, SEQ, true);
+    }
+}
+
+template <typename CacheType, auto Generate = generateObjects>
+void
+benchmarkCacheLoad(benchmark::State& state)
+{
+    initPrometheus();
+    auto const objects = Generate(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        malloc_trim(0);
+        auto const rssBefore = residentBytes();
+        state.ResumeTiming();
+
+        auto cache = std::make_unique<CacheType>();
+        load(*cache, objects);
+
+        state.PauseTiming();
+        state.counters["rss_mb"] = static_cast<double>(residentBytes() - rssBefore) / (1024. * 1024.);
+        cache.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename CacheType>
+void
+benchmarkCacheSuccessor(benchmark::State& state)
+{
+    initPrometheus();
+    auto const objects = generateObjects(state.range(0));
+    CacheType cache;
+    load(cache, objects);
+    if constexpr (requires { cache.setFull(); })
+        cache.setFull();
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto const& key = objects[i++ % objects.size()].key;
+        benchmark::DoNotOptimize(cache.getSuccessor(key, SEQ));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename CacheType>
+void
+benchmarkCacheGet(benchmark::State& state)
+{
+    initPrometheus();
+    auto const objects = generateLedgerLikeObjects(state.range(0));
+    CacheType cache;
+    load(cache, objects);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto const& key = objects[i++ % objects.size()].key;
+        benchmark::DoNotOptimize(cache.get(key, SEQ));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Reads from many threads while another thread keeps applying ledger diffs, like the ETL does on a live node.
+ */
+template <typename CacheType>
+struct ConcurrentReadsFixture {
+    static constexpr std::size_t NUM_OBJECTS = 1'000'000;
+    static constexpr std::size_t NUM_DIFFS = 64;
+    static constexpr std::size_t DIFF_SIZE = 1'000;
+
+    std::vector<data::LedgerObject> objects = generateObjects(NUM_OBJECTS);
+    CacheType cache;
+    std::atomic_bool stop = false;
+    std::thread writer;
+
+    ConcurrentReadsFixture()
+    {
+        load(cache, objects);
+        if constexpr (requires { cache.setFull(); })
+            cache.setFull();
+
+        std::vector<std::vector<data::LedgerObject>> diffs(NUM_DIFFS);
+        std::mt19937_64 rng{NUM_DIFFS};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        for (auto& diff : diffs) {
+            diff = generateObjects(DIFF_SIZE);
+            for (auto& obj : diff)
+                obj.key = objects[rng() % objects.size()].key;
+        }
+
+        writer = std::thread{[this, diffs = std::move(diffs)] {
+            for (auto seq = SEQ + 1; not stop; ++seq)
+                cache.update(diffs[seq % diffs.size()], seq, false);
+        }};
+    }
+
+    ~ConcurrentReadsFixture()
+    {
+        stop = true;
+        writer.join();
+    }
+
+    ConcurrentReadsFixture(ConcurrentReadsFixture const&) = delete;
+    ConcurrentReadsFixture&
+    operator=(ConcurrentReadsFixture const&) = delete;
+};
+
+template <typename CacheType>
+void
+benchmarkCacheConcurrentReads(benchmark::State& state)
+{
+    static std::unique_ptr<ConcurrentReadsFixture<CacheType>> fixture;
+    if (state.thread_index() == 0) {
+        initPrometheus();
+        fixture = std::make_unique<ConcurrentReadsFixture<CacheType>>();
+    }
+
+    // every thread starts at a different key
+    auto i = static_cast<std::size_t>(state.thread_index()) * 7919;
+    for (auto _ : state) {
+        auto const& cache = fixture->cache;
+        auto const& key = fixture->objects[i++ % fixture->objects.size()].key;
+        auto const seq = cache.latestLedgerSequence();
+        benchmark::DoNotOptimize(cache.get(key, seq));
+        benchmark::DoNotOptimize(cache.getSuccessor(key, seq));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0)
+        fixture.reset();
+}
+
+/**
+ * @brief Ledger diffs as received from rippled without object neighbours, applied one after another to a full cache.
+ */
+struct LedgerReplay {
+    static constexpr std::size_t NUM_OBJECTS = 1'000'000;
+    static constexpr std::size_t NUM_DIFFS = 256;
+    static constexpr std::size_t NUM_CREATED = 100;
+    static constexpr std::size_t NUM_DELETED = 100;
+    static constexpr std::size_t NUM_MODIFIED = 400;
+    static constexpr std::size_t NUM_BOOKS = 1'000;
+
+    struct Diff {
+        std::vector<data::LedgerObject> objects;
+        std::vector<bool> modified;
+    };
+
+    data::LedgerCache cache;
+    std::vector<Diff> diffs;
+
+    LedgerReplay()
+    {
+        auto objects = generateLedgerLikeObjects(NUM_OBJECTS);
+        load(cache, objects);
+        cache.setFull();
+
+        std::mt19937_64 rng{NUM_DIFFS};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        std::vector<ripple::uint256> live;
+        for (auto const& obj : objects)
+            live.push_back(obj.key);
+
+        // a few percent of the new objects are directories of a limited set of books
+        auto const bookDir = bookDirectory();
+        auto const newObjects = generateLedgerLikeObjects(NUM_DIFFS * (NUM_CREATED + NUM_MODIFIED));
+        auto next = newObjects.begin();
+
+        for (std::size_t i = 0; i < NUM_DIFFS; ++i) {
+            auto& diff = diffs.emplace_back();
+            auto const add = [&diff](data::LedgerObject obj, bool modified) {
+                diff.objects.push_back(std::move(obj));
+                diff.modified.push_back(modified);
+            };
+
+            for (std::size_t j = 0; j < NUM_DELETED; ++j) {
+                auto const pos = rng() % live.size();
+                add({live[pos], {}}, false);
+                live[pos] = live.back();
+                live.pop_back();
+            }
+            for (std::size_t j = 0; j < NUM_MODIFIED; ++j, ++next)
+                add({live[rng() % live.size()], next->blob}, true);
+            for (std::size_t j = 0; j < NUM_CREATED; ++j, ++next) {
+                auto obj = *next;
+                if (rng() % 20 == 0) {
+                    auto const book = rng() % NUM_BOOKS;
+                    std::fill(obj.key.begin(), obj.key.begin() + 24, 0);
+                    std::memcpy(obj.key.data(), &book, sizeof(book));
+                    obj.blob = bookDir;
+                }
+                live.push_back(obj.key);
+                add(std::move(obj), false);
+            }
+        }
+    }
+
+    static data::Blob
+    bookDirectory()
+    {
+        ripple::STObject dir(ripple::sfLedgerEntry);
+        dir.setFieldU16(ripple::sfLedgerEntryType, ripple::ltDIR_NODE);
+        dir.setFieldV256(ripple::sfIndexes, ripple::STVector256{});
+        dir.setFieldH256(ripple::sfRootIndex, ripple::uint256{});
+        dir.setFieldU32(ripple::sfFlags, 0);
+        return dir.getSerializer().peekData();
+    }
+};
+
+/**
+ * @brief Derives the successor table changes with cache lookups after the update, the way the ETL did before the cache
+ * could provide them.
+ */
+std::vector<data::LedgerCache::SuccessorDelta>
+successorsFromLookups(data::LedgerCache& cache, LedgerReplay::Diff const& diff, uint32_t seq)
+{
+    std::set<ripple::uint256> bookSuccessorsToCalculate;
+    std::set<ripple::uint256> modified;
+
+    for (std::size_t i = 0; i < diff.objects.size(); ++i) {
+        auto const& obj = diff.objects[i];
+        if (diff.modified[i]) {
+            modified.insert(obj.key);
+            continue;
+        }
+
+        auto const isDeleted = obj.blob.empty();
+        auto const checkBookBase =
+            isDeleted ? isBookDir(obj.key, *cache.get(obj.key, seq - 1)) : isBookDir(obj.key, obj.blob);
+        if (checkBookBase) {
+            auto const bookBase = getBookBase(obj.key);
+            auto const oldFirstDir = cache.getSuccessor(bookBase, seq - 1);
+            if (not oldFirstDir or (isDeleted and obj.key == oldFirstDir->key) or
+                (!isDeleted and obj.key < oldFirstDir->key))
+                bookSuccessorsToCalculate.insert(bookBase);
+        }
+    }
+
+    cache.update(diff.objects, seq);
+
+    std::vector<data::LedgerCache::SuccessorDelta> deltas;
+    for (auto const& obj : diff.objects) {
+        if (modified.contains(obj.key))
+            continue;
+
+        auto const lb = cache.getPredecessor(obj.key, seq);
+        auto const lbKey = lb ? lb->key : data::firstKey;
+        auto const ub = cache.getSuccessor(obj.key, seq);
+        auto const ubKey = ub ? ub->key : data::lastKey;
+
+        if (obj.blob.empty()) {
+            deltas.push_back({.key = lbKey, .successor = ubKey});
+        } else {
+            deltas.push_back({.key = lbKey, .successor = obj.key});
+            deltas.push_back({.key = obj.key, .successor = ubKey});
+        }
+    }
+    for (auto const& base : bookSuccessorsToCalculate) {
+        auto const succ = cache.getSuccessor(base, seq);
+        deltas.push_back({.key = base, .successor = succ ? succ->key : data::lastKey});
+    }
+
+    return deltas;
+}
+
+template <bool FromUpdate>
+void
+benchmarkCacheReplaySuccessors(benchmark::State& state)
+{
+    initPrometheus();
+    LedgerReplay replay;
+
+    auto seq = SEQ;
+    std::size_t numDeltas = 0;
+    for (auto _ : state) {
+        auto const& diff = replay.diffs[(seq - SEQ) % replay.diffs.size()];
+        ++seq;
+
+        if constexpr (FromUpdate) {
+            numDeltas += replay.cache.updateAndGetSuccessors(diff.objects, seq).size();
+        } else {
+            numDeltas += successorsFromLookups(replay.cache, diff, seq).size();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["successors_per_ledger"] = static_cast<double>(numDeltas) / static_cast<double>(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(benchmarkCacheLoad<MapCache>)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmarkCacheLoad<data::LedgerCache>)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+// memory/latency trade-off of compression, on objects that compress like real ledger objects do
+BENCHMARK(benchmarkCacheLoad<data::LedgerCache, generateLedgerLikeObjects>)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmarkCacheLoad<CompressedLedgerCache, generateLedgerLikeObjects>)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmarkCacheGet<data::LedgerCache>)->Arg(1'000'000);
+BENCHMARK(benchmarkCacheGet<CompressedLedgerCache>)->Arg(1'000'000);
+
+BENCHMARK(benchmarkCacheSuccessor<MapCache>)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK(benchmarkCacheSuccessor<data::LedgerCache>)->Arg(100'000)->Arg(1'000'000);
+
+BENCHMARK(benchmarkCacheConcurrentReads<MapCache>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(benchmarkCacheConcurrentReads<data::LedgerCache>)->ThreadRange(1, 16)->UseRealTime();
+
+// every iteration applies the next recorded ledger diff, so the number of iterations is fixed
+BENCHMARK(benchmarkCacheReplaySuccessors<false>)
+    ->Iterations(LedgerReplay::NUM_DIFFS)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(benchmarkCacheReplaySuccessors<true>)
+    ->Iterations(LedgerReplay::NUM_DIFFS)
+    ->Unit(benchmark::kMicrosecond);
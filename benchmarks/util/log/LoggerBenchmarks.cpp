@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/config/Config.hpp"
+#include "util/log/Logger.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/json/object.hpp>
+#include <boost/json/value.hpp>
+#include <boost/log/core/core.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+using namespace util;
+
+namespace {
+
+enum class Mode { Sync, AsyncBlock, AsyncDrop };
+
+std::filesystem::path const LOG_DIR = std::filesystem::temp_directory_path() / "clio_logger_benchmark";
+
+void
+initLogging(Mode mode)
+{
+    boost::json::object json{
+        {"log_level", "info"},
+        {"log_directory", LOG_DIR.string()},
+        {"log_async", {{"enabled", mode != Mode::Sync}, {"overflow", mode == Mode::AsyncDrop ? "drop" : "block"}}},
+    };
+    LogService::init(Config{boost::json::value{std::move(json)}});
+}
+
+void
+resetLogging()
+{
+    LogService::shutdown();
+    boost::log::core::get()->remove_all_sinks();
+    std::filesystem::remove_all(LOG_DIR);
+}
+
+template <Mode mode>
+void
+benchmarkInfoLog(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+        initLogging(mode);
+
+    auto const droppedBefore = LogService::droppedRecords();
+    Logger const log{"RPC"};
+    std::uint64_t counter = 0;
+    for (auto _ : state)
+        LOG(log.info()) << "Received request from 127.0.0.1, counter = " << ++counter;
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        state.counters["dropped"] = static_cast<double>(LogService::droppedRecords() - droppedBefore);
+        resetLogging();
+    }
+}
+
+template <Mode mode>
+void
+benchmarkFilteredDebugLog(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+        initLogging(mode);
+
+    Logger const log{"RPC"};
+    std::uint64_t counter = 0;
+    for (auto _ : state)
+        LOG(log.debug()) << "Received request from 127.0.0.1, counter = " << ++counter;
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0)
+        resetLogging();
+}
+
+}  // namespace
+
+// Every info record is formatted and written to the log file; with the synchronous sink the calling thread does both
+// under the sink's lock
+BENCHMARK(benchmarkInfoLog<Mode::Sync>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(benchmarkInfoLog<Mode::AsyncBlock>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(benchmarkInfoLog<Mode::AsyncDrop>)->ThreadRange(1, 8)->UseRealTime();
+
+// Debug records are rejected by the severity filter before reaching any sink
+BENCHMARK(benchmarkFilteredDebugLog<Mode::Sync>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(benchmarkFilteredDebugLog<Mode::AsyncBlock>)->ThreadRange(1, 8)->UseRealTime();
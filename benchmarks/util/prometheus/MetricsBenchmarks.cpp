@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/prometheus/impl/CounterImpl.hpp"
+#include "util/prometheus/impl/HistogramImpl.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace util::prometheus::impl;
+
+namespace {
+
+// buckets of the rpc and backend duration histograms
+std::vector<std::int64_t> const BUCKETS = {1, 2, 5, 10, 20, 50, 100, 200, 500, 700, 1000};
+
+template <typename CounterType>
+void
+benchmarkCounterAdd(benchmark::State& state)
+{
+    // shared by all the threads of a run
+    static CounterType counter;
+
+    for (auto _ : state)
+        counter.add(1);
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0)
+        benchmark::DoNotOptimize(counter.value());
+}
+
+template <typename HistogramType>
+void
+benchmarkHistogramObserve(benchmark::State& state)
+{
+    static HistogramType histogram = [] {
+        HistogramType result;
+        result.setBuckets(BUCKETS);
+        return result;
+    }();
+
+    std::int64_t value = state.thread_index();
+    for (auto _ : state)
+        histogram.observe(value++ % 1000);
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}  // namespace
+
+BENCHMARK(benchmarkCounterAdd<CounterImpl<std::uint64_t>>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(benchmarkCounterAdd<ShardedCounterImpl<std::uint64_t>>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(benchmarkCounterAdd<CounterImpl<double>>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(benchmarkCounterAdd<ShardedCounterImpl<double>>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(benchmarkHistogramObserve<HistogramImpl<std::int64_t>>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(benchmarkHistogramObserve<ShardedHistogramImpl<std::int64_t>>)->ThreadRange(1, 16)->UseRealTime();
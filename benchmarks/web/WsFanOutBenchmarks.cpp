@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address_v4.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/websocket/stream.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace asio = boost::asio;
+namespace websocket = boost::beast::websocket;
+using tcp = asio::ip::tcp;
+
+// a transaction stream message with metadata is usually a few kilobytes of json
+constexpr std::size_t MESSAGE_SIZE = 8 * 1024;
+
+constexpr auto UPGRADE_REQUEST =
+    "GET / HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "Upgrade: websocket\r\n"
+    "Connection: Upgrade\r\n"
+    "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+    "Sec-WebSocket-Version: 13\r\n\r\n";
+
+/**
+ * @brief Websocket sessions connected over loopback to clients that read and drop everything they receive.
+ */
+class Subscribers {
+    struct Client {
+        tcp::socket socket;
+        std::array<char, 64 * 1024> buffer{};
+
+        explicit Client(asio::io_context& ioc) : socket{ioc}
+        {
+        }
+    };
+
+    using Session = websocket::stream<boost::beast::tcp_stream>;
+
+    asio::io_context ioc_;
+    std::vector<std::unique_ptr<Client>> clients_;
+    std::vector<std::unique_ptr<Session>> sessions_;
+
+public:
+    Subscribers(std::size_t count, bool autoFragment)
+    {
+        tcp::acceptor acceptor{ioc_, tcp::endpoint{asio::ip::address_v4::loopback(), 0}};
+
+        std::size_t accepted = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto& client = *clients_.emplace_back(std::make_unique<Client>(ioc_));
+            client.socket.connect(acceptor.local_endpoint());
+            asio::write(client.socket, asio::buffer(std::string{UPGRADE_REQUEST}));
+            drain(client);
+
+            auto& session = *sessions_.emplace_back(std::make_unique<Session>(acceptor.accept()));
+            session.auto_fragment(autoFragment);
+            session.async_accept([&accepted](boost::beast::error_code ec) {
+                if (not ec)
+                    ++accepted;
+            });
+        }
+
+        while (accepted < count)
+            ioc_.run_one();
+    }
+
+    ~Subscribers()
+    {
+        ioc_.stop();
+    }
+
+    Subscribers(Subscribers const&) = delete;
+    Subscribers&
+    operator=(Subscribers const&) = delete;
+
+    void
+    publish(std::shared_ptr<std::string const> const& message)
+    {
+        std::size_t pending = sessions_.size();
+        for (auto& session : sessions_) {
+            session->async_write(asio::buffer(*message), [&pending, message](boost::beast::error_code, std::size_t) {
+                --pending;
+            });
+        }
+
+        while (pending > 0)
+            ioc_.run_one();
+    }
+
+private:
+    void
+    drain(Client& client)
+    {
+        client.socket.async_read_some(asio::buffer(client.buffer), [this, &client](boost::beast::error_code ec, auto) {
+            if (not ec)
+                drain(client);
+        });
+    }
+};
+
+template <bool AutoFragment>
+void
+benchmarkWsFanOut(benchmark::State& state)
+{
+    auto const numSubscribers = static_cast<std::size_t>(state.range(0));
+    Subscribers subscribers{numSubscribers, AutoFragment};
+    auto const message = std::make_shared<std::string const>(MESSAGE_SIZE, 'x');
+
+    for (auto _ : state)
+        subscribers.publish(message);
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numSubscribers));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * numSubscribers * MESSAGE_SIZE));
+}
+
+}  // namespace
+
+// Sessions used to split every message into write buffer sized frames, each written (and encrypted) on its own
+BENCHMARK(benchmarkWsFanOut<true>)->RangeMultiplier(8)->Range(1, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(benchmarkWsFanOut<false>)->RangeMultiplier(8)->Range(1, 512)->Unit(benchmark::kMicrosecond);
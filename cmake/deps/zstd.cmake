@@ -0,0 +1 @@
+find_package(zstd REQUIRED CONFIG)
@@ -76,6 +76,7 @@ ClioApplication::ClioApplication(util::Config const& config) : config_(config),
 {
     LOG(util::LogService::info()) << "Clio version: " << util::build::getClioFullVersionString();
     PrometheusService::init(config);
+    util::LogService::registerMetrics();
 }
 
 int
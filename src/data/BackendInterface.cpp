@@ -28,10 +28,12 @@
 #include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/Protocol.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/STLedgerEntry.h>
 #include <xrpl/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -40,6 +42,7 @@
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -191,9 +194,6 @@ BackendInterface::fetchBookOffers(
     boost::asio::yield_context yield
 ) const
 {
-    // TODO try to speed this up. This can take a few seconds. The goal is
-    // to get it down to a few hundred milliseconds.
-    BookOffersPage page;
     ripple::uint256 const bookEnd = ripple::getQualityNext(book);
     ripple::uint256 uTipIndex = book;
     std::vector<ripple::uint256> keys;
@@ -201,62 +201,137 @@ BackendInterface::fetchBookOffers(
     auto begin = std::chrono::system_clock::now();
     std::uint32_t numSucc = 0;
     std::uint32_t numPages = 0;
-    long succMillis = 0;
-    long pageMillis = 0;
-    while (keys.size() < limit) {
-        auto mid1 = std::chrono::system_clock::now();
-        auto offerDir = fetchSuccessorObject(uTipIndex, ledgerSequence, yield);
-        auto mid2 = std::chrono::system_clock::now();
-        numSucc++;
-        succMillis += getMillis(mid2 - mid1);
-        if (!offerDir || offerDir->key >= bookEnd) {
-            LOG(gLog.trace()) << "offerDir.has_value() " << offerDir.has_value() << " breaking";
-            break;
-        }
-        uTipIndex = offerDir->key;
+    if (auto indexed = cache_.getBookOffers(book, ledgerSequence, limit); indexed.has_value()) {
+        LOG(gLog.trace()) << "Book index hit - " << ripple::strHex(book);
+        keys = std::move(*indexed);
+    } else {
         while (keys.size() < limit) {
-            ++numPages;
-            ripple::STLedgerEntry const sle{
-                ripple::SerialIter{offerDir->blob.data(), offerDir->blob.size()}, offerDir->key
-            };
-            auto indexes = sle.getFieldV256(ripple::sfIndexes);
-            keys.insert(keys.end(), indexes.begin(), indexes.end());
-            auto next = sle.getFieldU64(ripple::sfIndexNext);
-            if (next == 0u) {
-                LOG(gLog.trace()) << "Next is empty. breaking";
+            auto offerDir = fetchBookDirectory(uTipIndex, ledgerSequence, yield);
+            numSucc++;
+            if (!offerDir || offerDir->key >= bookEnd) {
+                LOG(gLog.trace()) << "offerDir.has_value() " << offerDir.has_value() << " breaking";
                 break;
             }
-            auto nextKey = ripple::keylet::page(uTipIndex, next);
-            auto nextDir = fetchLedgerObject(nextKey.key, ledgerSequence, yield);
-            ASSERT(nextDir.has_value(), "Next dir must exist");
-            offerDir->blob = *nextDir;
-            offerDir->key = nextKey.key;
+            uTipIndex = offerDir->key;
+            numPages += fetchBookDirectoryOffers(*offerDir, limit, keys, ledgerSequence, yield);
         }
-        auto mid3 = std::chrono::system_clock::now();
-        pageMillis += getMillis(mid3 - mid2);
     }
+
+    // both the book index and the directory walk stop at the end of the page that reaches the limit; only the best
+    // `limit` offers of those are returned
+    if (keys.size() > limit)
+        keys.resize(limit);
+
     auto mid = std::chrono::system_clock::now();
     auto objs = fetchLedgerObjects(keys, ledgerSequence, yield);
-    for (size_t i = 0; i < keys.size() && i < limit; ++i) {
+    BookOffersPage page;
+    for (size_t i = 0; i < keys.size(); ++i) {
         LOG(gLog.trace()) << "Key = " << ripple::strHex(keys[i]) << " blob = " << ripple::strHex(objs[i])
                           << " ledgerSequence = " << ledgerSequence;
         ASSERT(!objs[i].empty(), "Ledger object can't be empty");
         page.offers.push_back({keys[i], objs[i]});
     }
     auto end = std::chrono::system_clock::now();
-    LOG(gLog.debug()) << "Fetching " << std::to_string(keys.size()) << " offers took "
-                      << std::to_string(getMillis(mid - begin)) << " milliseconds. Fetching next dir took "
-                      << std::to_string(succMillis) << " milliseonds. Fetched next dir " << std::to_string(numSucc)
-                      << " times"
-                      << " Fetching next page of dir took " << std::to_string(pageMillis) << " milliseconds"
-                      << ". num pages = " << std::to_string(numPages) << ". Fetching all objects took "
-                      << std::to_string(getMillis(end - mid))
-                      << " milliseconds. total time = " << std::to_string(getMillis(end - begin)) << " milliseconds"
+    LOG(gLog.debug()) << "Fetching " << keys.size() << " offers took " << getMillis(mid - begin)
+                      << " milliseconds. Fetched next dir " << numSucc << " times. num pages = " << numPages
+                      << ". Fetching all objects took " << getMillis(end - mid)
+                      << " milliseconds. total time = " << getMillis(end - begin) << " milliseconds"
                       << " book = " << ripple::strHex(book);
 
     return page;
 }
 
+std::optional<LedgerObject>
+BackendInterface::fetchBookDirectory(
+    ripple::uint256 const& key,
+    std::uint32_t const ledgerSequence,
+    boost::asio::yield_context yield
+) const
+{
+    // a full cache has the directory itself along with its key, so the whole book is walked in memory
+    if (auto succ = cache_.getSuccessor(key, ledgerSequence); succ.has_value())
+        return succ;
+
+    auto const succKey = doFetchSuccessorKey(key, ledgerSequence, yield);
+    if (!succKey)
+        return std::nullopt;
+
+    auto obj = fetchLedgerObject(*succKey, ledgerSequence, yield);
+    if (!obj)
+        return LedgerObject{.key = *succKey, .blob = {}};
+
+    return LedgerObject{.key = *succKey, .blob = std::move(*obj)};
+}
+
+std::uint32_t
+BackendInterface::fetchBookDirectoryOffers(
+    LedgerObject const& root,
+    std::uint32_t const limit,
+    std::vector<ripple::uint256>& keys,
+    std::uint32_t const ledgerSequence,
+    boost::asio::yield_context yield
+) const
+{
+    // pages of the directory read ahead of the one currently walked, by page number
+    std::unordered_map<std::uint64_t, Blob> pages;
+    std::uint64_t lastPage = 0;
+
+    auto key = root.key;
+    auto blob = root.blob;
+    std::uint32_t numPages = 0;
+    while (true) {
+        ++numPages;
+        ripple::STLedgerEntry const sle{ripple::SerialIter{blob.data(), blob.size()}, key};
+        auto const& indexes = sle.getFieldV256(ripple::sfIndexes);
+        keys.insert(keys.end(), indexes.begin(), indexes.end());
+
+        auto const next = sle.getFieldU64(ripple::sfIndexNext);
+        if (next == 0u || keys.size() >= limit) {
+            LOG(gLog.trace()) << "Next is empty or limit is reached. breaking";
+            break;
+        }
+
+        // the root page links back to the last page of the directory
+        if (numPages == 1u)
+            lastPage = sle.getFieldU64(ripple::sfIndexPrevious);
+
+        if (not pages.contains(next)) {
+            // pages are mostly numbered one after another, so the ones likely needed to reach the limit are read at
+            // once instead of following the links one round trip at a time
+            auto const pagesNeeded = (limit - keys.size() + ripple::dirNodeMaxEntries - 1) / ripple::dirNodeMaxEntries;
+            auto numToFetch = std::min<std::uint64_t>(pagesNeeded, MAX_PREFETCHED_BOOK_PAGES);
+            if (lastPage >= next)
+                numToFetch = std::min(numToFetch, lastPage - next + 1);
+
+            std::vector<ripple::uint256> pageKeys;
+            pageKeys.reserve(numToFetch);
+            for (std::uint64_t i = 0; i < numToFetch; ++i)
+                pageKeys.push_back(ripple::keylet::page(root.key, next + i).key);
+
+            std::vector<Blob> blobs;
+            if (numToFetch == 1u) {
+                blobs.push_back(fetchLedgerObject(pageKeys.front(), ledgerSequence, yield).value_or(Blob{}));
+            } else {
+                blobs = fetchLedgerObjects(pageKeys, ledgerSequence, yield);
+            }
+
+            pages.clear();
+            for (std::uint64_t i = 0; i < numToFetch; ++i) {
+                if (not blobs[i].empty())
+                    pages.emplace(next + i, std::move(blobs[i]));
+            }
+        }
+
+        auto it = pages.find(next);
+        ASSERT(it != pages.end(), "Next dir must exist");
+        key = ripple::keylet::page(root.key, next).key;
+        blob = std::move(it->second);
+        pages.erase(it);
+    }
+
+    return numPages;
+}
+
 std::optional<LedgerRange>
 BackendInterface::hardFetchLedgerRange() const
 {
@@ -308,7 +383,8 @@ BackendInterface::fetchLedgerPage(
     std::uint32_t const ledgerSequence,
     std::uint32_t const limit,
     bool outOfOrder,
-    boost::asio::yield_context yield
+    boost::asio::yield_context yield,
+    std::optional<ripple::uint256> const& end
 )
 {
     LedgerPage page;
@@ -326,10 +402,11 @@ BackendInterface::fetchLedgerPage(
         std::uint32_t const seq = outOfOrder ? range->maxSequence : ledgerSequence;
         auto succ = fetchSuccessorKey(curCursor, seq, yield);
 
-        if (!succ) {
+        if (!succ || (end && *succ > *end)) {
             reachedEnd = true;
         } else {
             keys.push_back(*succ);
+            reachedEnd = end && *succ == *end;
         }
     }
 
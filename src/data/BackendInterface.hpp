@@ -136,6 +136,9 @@ synchronousAndRetryOnTimeout(FnType&& func)
  * @brief The interface to the database used by Clio.
  */
 class BackendInterface {
+    // upper bound on the pages of a single book directory read ahead in one go
+    static constexpr std::uint64_t MAX_PREFETCHED_BOOK_PAGES = 16;
+
 protected:
     mutable std::shared_mutex rngMtx_;
     std::optional<LedgerRange> range;
@@ -465,6 +468,7 @@ public:
      * @param limit The maximum number of transactions per result page
      * @param outOfOrder If set to true max available sequence is used instead of ledgerSequence
      * @param yield The coroutine context
+     * @param end The last key of the page (inclusive); the page stops there even if the limit is not reached
      * @return The ledger page
      */
     LedgerPage
@@ -473,7 +477,8 @@ public:
         std::uint32_t ledgerSequence,
         std::uint32_t limit,
         bool outOfOrder,
-        boost::asio::yield_context yield
+        boost::asio::yield_context yield,
+        std::optional<ripple::uint256> const& end = std::nullopt
     );
 
     /**
@@ -515,6 +520,10 @@ public:
     /**
      * @brief Fetches book offers.
      *
+     * The book index of the cache answers right away for the latest ledger. Otherwise quality directories are walked
+     * one successor at a time; the pages of each directory are read ahead in batches and all offers are fetched at
+     * once in the end. When the cache is full the directories come from memory.
+     *
      * @param book Unsigned 256-bit integer.
      * @param ledgerSequence The ledger sequence to fetch for
      * @param limit Pagaing limit as to how many transactions returned per page.
@@ -670,12 +679,51 @@ private:
     doWriteLedgerObject(std::string&& key, std::uint32_t seq, std::string&& blob) = 0;
 
     /**
-     * @brief The implementation should wait for all pending writes to finish
+     * @brief The implementation should wait for the pending writes of the ledger being finished and of all ledgers
+     * before it to finish; writes of later ledgers don't need to be waited for
      *
      * @return true on success; false otherwise
      */
     virtual bool
     doFinishWrites() = 0;
+
+    /**
+     * @brief Fetches the quality directory of a book following the given key.
+     *
+     * Served from the cache alone when it is full, otherwise the successor key is read from the database.
+     *
+     * @param key The key to fetch the successor directory for
+     * @param ledgerSequence The ledger sequence to fetch for
+     * @param yield The coroutine context
+     * @return The root page of the directory on success; nullopt if there is no successor
+     */
+    std::optional<LedgerObject>
+    fetchBookDirectory(
+        ripple::uint256 const& key,
+        std::uint32_t ledgerSequence,
+        boost::asio::yield_context yield
+    ) const;
+
+    /**
+     * @brief Collects the offer keys of a quality directory, walking its pages until the limit is reached.
+     *
+     * Pages following the root are read ahead in batches sized by the number of offers still needed.
+     *
+     * @param root The root page of the directory
+     * @param limit The number of offer keys wanted in total
+     * @param keys The offer keys collected so far; the keys of this directory are appended to it
+     * @param ledgerSequence The ledger sequence to fetch for
+     * @param yield The coroutine context
+     * @return The number of pages walked
+     */
+    std::uint32_t
+    fetchBookDirectoryOffers(
+        LedgerObject const& root,
+        std::uint32_t limit,
+        std::vector<ripple::uint256>& keys,
+        std::uint32_t ledgerSequence,
+        boost::asio::yield_context yield
+    ) const;
 };
 
 }  // namespace data
@@ -27,6 +27,7 @@
 #include "data/cassandra/SettingsProvider.hpp"
 #include "data/cassandra/Types.hpp"
 #include "data/cassandra/impl/ExecutionStrategy.hpp"
+#include "data/cassandra/impl/KeyBatches.hpp"
 #include "util/Assert.hpp"
 #include "util/LedgerUtils.hpp"
 #include "util/Profiler.hpp"
@@ -37,12 +38,14 @@
 #include <cassandra.h>
 #include <xrpl/basics/Blob.h>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
 #include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Indexes.h>
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/nft.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
@@ -53,6 +56,7 @@
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -77,6 +81,8 @@ class BasicCassandraBackend : public BackendInterface {
     // have to be mutable because BackendInterface constness :(
     mutable ExecutionStrategyType executor_;
 
+    std::size_t readBatchSize_;
+
     std::atomic_uint32_t ledgerSequence_ = 0u;
 
 public:
@@ -91,6 +97,7 @@ public:
         , schema_{settingsProvider_}
         , handle_{settingsProvider_.getSettings()}
         , executor_{settingsProvider_.getSettings(), handle_}
+        , readBatchSize_{settingsProvider_.getSettings().readBatchSize}
     {
         if (auto const res = handle_.connect(); not res)
             throw std::runtime_error("Could not connect to databse: " + res.error());
@@ -188,8 +195,8 @@ public:
     bool
     doFinishWrites() override
     {
-        // wait for other threads to finish their writes
-        executor_.sync();
+        // wait for the writes of this ledger; writes of the ledgers prepared after it may still be in flight
+        executor_.syncLedger(ledgerSequence_);
 
         if (!range) {
             executor_.writeSync(schema_->updateLedgerRange, ledgerSequence_, false, ledgerSequence_);
@@ -207,9 +214,9 @@ public:
     void
     writeLedger(ripple::LedgerHeader const& ledgerHeader, std::string&& blob) override
     {
-        executor_.write(schema_->insertLedgerHeader, ledgerHeader.seq, std::move(blob));
+        executor_.writeForLedger(ledgerHeader.seq, schema_->insertLedgerHeader, ledgerHeader.seq, std::move(blob));
 
-        executor_.write(schema_->insertLedgerHash, ledgerHeader.hash, ledgerHeader.seq);
+        executor_.writeForLedger(ledgerHeader.seq, schema_->insertLedgerHash, ledgerHeader.hash, ledgerHeader.seq);
 
         ledgerSequence_ = ledgerHeader.seq;
     }
@@ -631,26 +638,28 @@ public:
         std::vector<TransactionAndMetadata> results;
         results.reserve(numHashes);
 
-        std::vector<Statement> statements;
-        statements.reserve(numHashes);
+        auto const timeDiff = util::timed([this, yield, &results, &hashes]() {
+            std::vector<Statement> statements;
+            for (auto const& batch : impl::makeKeyBatches(hashes, readBatchSize_))
+                statements.push_back(schema_->selectTransactions.bind(batch));
 
-        auto const timeDiff = util::timed([this, yield, &results, &hashes, &statements]() {
-            // TODO: seems like a job for "hash IN (list of hashes)" instead?
-            std::transform(
-                std::cbegin(hashes),
-                std::cend(hashes),
-                std::back_inserter(statements),
-                [this](auto const& hash) { return schema_->selectTransaction.bind(hash); }
-            );
+            std::unordered_map<ripple::uint256, TransactionAndMetadata, ripple::hardened_hash<>> fetched;
+            fetched.reserve(hashes.size());
 
-            auto const entries = executor_.readEach(yield, statements);
-            std::transform(
-                std::cbegin(entries),
-                std::cend(entries),
+            for (auto const& result : executor_.readEach(yield, statements)) {
+                for (auto [hash, transaction, metadata, ledgerSequence, date] :
+                     extract<ripple::uint256, Blob, Blob, uint32_t, uint32_t>(result)) {
+                    fetched.try_emplace(hash, std::move(transaction), std::move(metadata), ledgerSequence, date);
+                }
+            }
+
+            // rows come back grouped by token; hashes that were not found are returned as empty entries
+            std::ranges::transform(
+                hashes,
                 std::back_inserter(results),
-                [](auto const& res) -> TransactionAndMetadata {
-                    if (auto const maybeRow = res.template get<Blob, Blob, uint32_t, uint32_t>(); maybeRow)
-                        return *maybeRow;
+                [&fetched](auto const& hash) -> TransactionAndMetadata {
+                    if (auto const it = fetched.find(hash); it != fetched.end())
+                        return it->second;
 
                     return {};
                 }
@@ -680,28 +689,24 @@ public:
         results.reserve(numKeys);
 
         std::vector<Statement> statements;
-        statements.reserve(numKeys);
+        for (auto const& batch : impl::makeKeyBatches(keys, readBatchSize_))
+            statements.push_back(schema_->selectObjects.bind(batch, sequence));
 
-        // TODO: seems like a job for "key IN (list of keys)" instead?
-        std::transform(
-            std::cbegin(keys),
-            std::cend(keys),
-            std::back_inserter(statements),
-            [this, &sequence](auto const& key) { return schema_->selectObject.bind(key, sequence); }
-        );
+        std::unordered_map<ripple::uint256, Blob, ripple::hardened_hash<>> fetched;
+        fetched.reserve(numKeys);
 
-        auto const entries = executor_.readEach(yield, statements);
-        std::transform(
-            std::cbegin(entries),
-            std::cend(entries),
-            std::back_inserter(results),
-            [](auto const& res) -> Blob {
-                if (auto const maybeValue = res.template get<Blob>(); maybeValue)
-                    return *maybeValue;
+        for (auto const& result : executor_.readEach(yield, statements)) {
+            for (auto [key, object] : extract<ripple::uint256, Blob>(result))
+                fetched.try_emplace(key, std::move(object));
+        }
 
-                return {};
-            }
-        );
+        // keys that were not found are returned as empty blobs, same as deleted objects
+        std::ranges::transform(keys, std::back_inserter(results), [&fetched](auto const& key) -> Blob {
+            if (auto const it = fetched.find(key); it != fetched.end())
+                return it->second;
+
+            return {};
+        });
 
         LOG(log_.trace()) << "Fetched " << numKeys << " objects";
         return results;
@@ -802,9 +807,9 @@ public:
         LOG(log_.trace()) << " Writing ledger object " << key.size() << ":" << seq << " [" << blob.size() << " bytes]";
 
         if (range)
-            executor_.write(schema_->insertDiff, seq, key);
+            executor_.writeForLedger(seq, schema_->insertDiff, seq, key);
 
-        executor_.write(schema_->insertObject, std::move(key), seq, std::move(blob));
+        executor_.writeForLedger(seq, schema_->insertObject, std::move(key), seq, std::move(blob));
     }
 
     void
@@ -815,7 +820,7 @@ public:
         ASSERT(!key.empty(), "Key must not be empty");
         ASSERT(!successor.empty(), "Successor must not be empty");
 
-        executor_.write(schema_->insertSuccessor, std::move(key), seq, std::move(successor));
+        executor_.writeForLedger(seq, schema_->insertSuccessor, std::move(key), seq, std::move(successor));
     }
 
     void
@@ -839,7 +844,7 @@ public:
             );
         }
 
-        executor_.write(std::move(statements));
+        executor_.writeForLedger(earliestLedgerSequence(data), std::move(statements));
     }
 
     void
@@ -854,7 +859,7 @@ public:
             );
         });
 
-        executor_.write(std::move(statements));
+        executor_.writeForLedger(earliestLedgerSequence(data), std::move(statements));
     }
 
     void
@@ -868,9 +873,9 @@ public:
     {
         LOG(log_.trace()) << "Writing txn to database";
 
-        executor_.write(schema_->insertLedgerTransaction, seq, hash);
-        executor_.write(
-            schema_->insertTransaction, std::move(hash), seq, date, std::move(transaction), std::move(metadata)
+        executor_.writeForLedger(seq, schema_->insertLedgerTransaction, seq, hash);
+        executor_.writeForLedger(
+            seq, schema_->insertTransaction, std::move(hash), seq, date, std::move(transaction), std::move(metadata)
         );
     }
 
@@ -902,7 +907,7 @@ public:
             }
         }
 
-        executor_.write(std::move(statements));
+        executor_.writeForLedger(earliestLedgerSequence(data), std::move(statements));
     }
 
     void
@@ -925,6 +930,22 @@ public:
     }
 
 private:
+    /**
+     * @brief Get the earliest ledger of the records written in one batch
+     *
+     * @param data The records to write
+     * @return The earliest ledger sequence; 0 if there are no records
+     */
+    template <typename RecordType>
+    static std::uint32_t
+    earliestLedgerSequence(std::vector<RecordType> const& data)
+    {
+        if (data.empty())
+            return 0u;
+
+        return std::ranges::min(data, {}, &RecordType::ledgerSequence).ledgerSequence;
+    }
+
     bool
     executeSyncUpdate(Statement statement)
     {
@@ -19,25 +19,218 @@
 
 #include "data/LedgerCache.hpp"
 
+#include "data/DBHelpers.hpp"
 #include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/BlobCodec.hpp"
 #include "util/Assert.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 
+#include <fmt/core.h>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/strHex.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace data {
 
+namespace {
+
+// spreads reader threads over the view slots
+std::size_t
+stripeOfThisThread(std::size_t stripes)
+{
+    static std::atomic_size_t nextStripe = 0;
+    thread_local std::size_t const stripe = nextStripe++;
+    return stripe % stripes;
+}
+
+// ages 0 and 1 get their own bucket, older ones are grouped by powers of two
+constexpr std::array<char const*, 6> AGE_BUCKETS{"0", "1", "2-3", "4-7", "8-15", "16+"};
+
+std::size_t
+ageBucket(uint32_t age)
+{
+    return std::min<std::size_t>(std::bit_width(age), AGE_BUCKETS.size() - 1);
+}
+
+}  // namespace
+
+LedgerCache::AgeCounters::AgeCounters(std::string const& fetch)
+{
+    for (auto const* bucket : AGE_BUCKETS) {
+        requests_.emplace_back(PrometheusService::counterInt(
+            "ledger_cache_age_counter_total_number",
+            util::prometheus::Labels({{"type", "request"}, {"fetch", fetch}, {"age", bucket}}),
+            "LedgerCache statistics by age of the requested ledger"
+        ));
+        hits_.emplace_back(PrometheusService::counterInt(
+            "ledger_cache_age_counter_total_number",
+            util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", fetch}, {"age", bucket}})
+        ));
+    }
+}
+
+void
+LedgerCache::AgeCounters::countRequest(uint32_t age) const
+{
+    ++requests_[ageBucket(age)].get();
+}
+
+void
+LedgerCache::AgeCounters::countHit(uint32_t age) const
+{
+    ++hits_[ageBucket(age)].get();
+}
+
+LedgerCache::Snapshot const&
+LedgerCache::View::closestTo(uint32_t seq) const
+{
+    // snapshots are one ledger apart except right after startup, so the age is usually the exact position
+    auto const age = snapshots.front()->seq - std::min(seq, snapshots.front()->seq);
+    auto pos = std::min<std::size_t>(age, snapshots.size() - 1);
+    while (pos > 0 and snapshots[pos]->seq < seq)
+        --pos;
+    return *snapshots[pos];
+}
+
+Blob
+LedgerCache::decode(CacheEntry const& entry, impl::BlobCodec const* codec)
+{
+    auto const bytes = entry.blob.bytes();
+    if (entry.compressed)
+        return codec->decompress(bytes);
+
+    return {bytes.begin(), bytes.end()};
+}
+
+LedgerCache::RetiredBlobs::~RetiredBlobs()
+{
+    {
+        std::scoped_lock const lck{released->mtx};
+        released->handles.insert(released->handles.end(), handles.begin(), handles.end());
+    }
+
+    // Unlink the rest of the chain iteratively; destroying it recursively could exhaust the stack when a reader held on
+    // to a very old snapshot. A list referenced only from here can't be referenced by anyone else anymore.
+    auto rest = std::move(next);
+    while (rest and rest.use_count() == 1)
+        rest = std::move(rest->next);
+}
+
+LedgerCache::LedgerCache()
+{
+    publish();
+}
+
+std::shared_ptr<LedgerCache::View const>
+LedgerCache::view() const
+{
+    return *slots_[stripeOfThisThread(SNAPSHOT_STRIPES)].view.lock();
+}
+
+void
+LedgerCache::setNumLedgers(std::size_t numLedgers)
+{
+    ASSERT(numLedgers >= 1, "At least the latest ledger must be cached");
+
+    std::scoped_lock const lck{mtx_};
+    numLedgers_ = numLedgers;
+}
+
+void
+LedgerCache::enableCompression()
+{
+    std::scoped_lock const lck{mtx_};
+    compressionEnabled_ = true;
+}
+
+void
+LedgerCache::enableOwnerIndex()
+{
+    ownerIndexEnabled_ = true;
+}
+
+void
+LedgerCache::retire(impl::BlobArena::Handle handle)
+{
+    retired_->handles.push_back(handle);
+}
+
+LedgerCache::CacheEntry
+LedgerCache::store(Blob const& blob, uint32_t seq)
+{
+    if (codec_ != nullptr) {
+        if (auto const compressed = codec_->compress(blob); compressed.has_value())
+            return {.seq = seq, .compressed = true, .blob = arena_.store(*compressed)};
+    } else if (compressionEnabled_) {
+        compressionSamples_.insert(compressionSamples_.end(), blob.begin(), blob.end());
+        compressionSampleSizes_.push_back(blob.size());
+
+        if (compressionSamples_.size() >= COMPRESSION_SAMPLE_BYTES) {
+            codec_ = impl::BlobCodec::train(compressionSamples_, compressionSampleSizes_);
+            if (codec_ != nullptr) {
+                LOG(log_.info()) << "Trained compression dictionary on " << compressionSampleSizes_.size()
+                                 << " objects";
+            } else {
+                LOG(log_.warn()) << "Could not train compression dictionary. Objects are stored uncompressed";
+                compressionEnabled_ = false;
+            }
+
+            compressionSamples_ = {};
+            compressionSampleSizes_ = {};
+        }
+    }
+
+    return {.seq = seq, .compressed = false, .blob = arena_.store(blob)};
+}
+
+void
+LedgerCache::publish()
+{
+    auto snap = std::make_shared<Snapshot const>(Snapshot{index_.snapshot(), latestSeq_, full_, codec_, retired_});
+
+    // updates that don't advance the sequence (e.g. the background load) replace the snapshot of that ledger
+    if (not history_.empty() and history_.front()->seq == latestSeq_) {
+        history_.front() = std::move(snap);
+    } else {
+        history_.push_front(std::move(snap));
+    }
+    while (history_.size() > numLedgers_)
+        history_.pop_back();
+
+    auto nextRetired = std::make_shared<RetiredBlobs>(released_);
+    retired_->next = nextRetired;
+    retired_ = std::move(nextRetired);
+
+    auto const view = std::make_shared<View const>(View{{history_.begin(), history_.end()}});
+
+    // every slot gets its own control block so readers of different slots don't contend on the reference count; the
+    // previous pointer is released outside of the slot's lock
+    for (auto& slot : slots_) {
+        auto const previous =
+            std::exchange(*slot.view.lock(), std::shared_ptr<View const>(view.get(), [view](View const*) {}));
+    }
+}
+
 uint32_t
 LedgerCache::latestLedgerSequence() const
 {
-    std::shared_lock const lck{mtx_};
-    return latestSeq_;
+    return view()->snapshots.front()->seq;
 }
 
 void
@@ -59,32 +252,138 @@ LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool is
 
     {
         std::scoped_lock const lck{mtx_};
-        if (seq > latestSeq_) {
-            ASSERT(
-                seq == latestSeq_ + 1 || latestSeq_ == 0,
-                "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
-                seq,
-                latestSeq_
-            );
-            latestSeq_ = seq;
+        apply(objs, seq, isBackground);
+        publish();
+        cv_.notify_all();
+    }
+}
+
+std::vector<LedgerCache::SuccessorDelta>
+LedgerCache::updateAndGetSuccessors(std::vector<LedgerObject> const& objs, uint32_t seq)
+{
+    if (disabled_)
+        return {};
+
+    std::scoped_lock const lck{mtx_};
+    ASSERT(full_, "Successors can only be derived from a full cache");
+
+    // objects of a ledger that is already applied would look modified instead of created, and deleted ones would be
+    // missing from the cache, so successors can only be derived from the ledger right after the cached one
+    if (latestSeq_ != 0 and seq != latestSeq_ + 1) {
+        throw std::logic_error(fmt::format(
+            "Successors can only be derived for the ledger after the cached one. seq = {}, latestSeq = {}",
+            seq,
+            latestSeq_
+        ));
+    }
+
+    // keys whose successor has to be written once the objects are applied
+    std::vector<ripple::uint256> anchors;
+    std::vector<ripple::uint256> changed;
+    // book bases with the first directory of the book before the update
+    std::vector<std::pair<ripple::uint256, ripple::uint256>> bookBases;
+
+    auto const firstAfter = [this](ripple::uint256 const& key) {
+        auto const next = index_.successor(key);
+        return next.has_value() ? next->first : lastKey;
+    };
+
+    for (auto const& obj : objs) {
+        auto const* existing = index_.find(obj.key);
+        if (obj.blob.empty()) {
+            ASSERT(existing != nullptr, "Deleted object {} must be in cache", ripple::strHex(obj.key));
+
+            auto const old = decode(*existing, codec_.get());
+            if (isBookDir(obj.key, old))
+                bookBases.emplace_back(getBookBase(obj.key), ripple::uint256{});
+        } else {
+            // modified objects don't change the successor table
+            if (existing != nullptr)
+                continue;
+
+            anchors.push_back(obj.key);
+            if (isBookDir(obj.key, obj.blob))
+                bookBases.emplace_back(getBookBase(obj.key), ripple::uint256{});
         }
-        for (auto const& obj : objs) {
-            if (!obj.blob.empty()) {
-                if (isBackground && deletes_.contains(obj.key))
-                    continue;
-
-                auto& e = map_[obj.key];
-                if (seq > e.seq) {
-                    e = {seq, obj.blob};
-                }
-            } else {
-                map_.erase(obj.key);
-                if (!full_ && !isBackground)
-                    deletes_.insert(obj.key);
+        changed.push_back(obj.key);
+    }
+
+    for (auto& [base, oldFirst] : bookBases)
+        oldFirst = firstAfter(base);
+
+    apply(objs, seq, false);
+
+    for (auto const& key : changed) {
+        auto const prev = index_.predecessor(key);
+        anchors.push_back(prev.has_value() ? prev->first : firstKey);
+    }
+    for (auto const& [base, oldFirst] : bookBases) {
+        if (firstAfter(base) != oldFirst)
+            anchors.push_back(base);
+    }
+
+    std::ranges::sort(anchors);
+    auto const duplicates = std::ranges::unique(anchors);
+    anchors.erase(duplicates.begin(), duplicates.end());
+
+    std::vector<SuccessorDelta> deltas;
+    deltas.reserve(anchors.size());
+    for (auto const& key : anchors)
+        deltas.push_back({.key = key, .successor = firstAfter(key)});
+
+    publish();
+    cv_.notify_all();
+    return deltas;
+}
+
+void
+LedgerCache::apply(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground)
+{
+    {
+        std::scoped_lock const releasedLck{released_->mtx};
+        for (auto const& handle : released_->handles)
+            arena_.release(handle);
+        released_->handles.clear();
+    }
+
+    if (seq > latestSeq_) {
+        ASSERT(
+            seq == latestSeq_ + 1 || latestSeq_ == 0,
+            "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
+            seq,
+            latestSeq_
+        );
+        latestSeq_ = seq;
+    }
+
+    std::vector<std::reference_wrapper<LedgerObject const>> changed;
+    changed.reserve(objs.size());
+    for (auto const& obj : objs) {
+        if (!obj.blob.empty()) {
+            if (isBackground && deletes_.contains(obj.key))
+                continue;
+
+            // don't copy the path to an entry that is not going to change
+            if (auto const* existing = index_.find(obj.key); existing != nullptr and existing->seq >= seq)
+                continue;
+
+            auto [e, inserted] = index_.emplace(obj.key);
+            if (not inserted)
+                retire(e.blob);
+            e = store(obj.blob, seq);
+            changed.emplace_back(obj);
+        } else {
+            if (auto const removed = index_.erase(obj.key); removed.has_value()) {
+                retire(removed->blob);
+                changed.emplace_back(obj);
             }
+            if (!full_ && !isBackground)
+                deletes_.insert(obj.key);
         }
-        cv_.notify_all();
     }
+    books_.update(changed, latestSeq_);
+    if (ownerIndexEnabled_)
+        owners_.update(changed, latestSeq_);
 }
 
 std::optional<LedgerObject>
@@ -93,15 +392,22 @@ LedgerCache::getSuccessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
+    auto const view = this->view();
+    auto const latestSeq = view->snapshots.front()->seq;
     ++successorReqCounter_.get();
-    if (seq != latestSeq_)
+    if (seq > latestSeq)
+        return {};
+
+    successorAgeCounters_.countRequest(latestSeq - seq);
+    auto const& snap = view->closestTo(seq);
+    if (seq != snap.seq or not snap.full)
         return {};
-    auto e = map_.upper_bound(key);
-    if (e == map_.end())
+    auto const e = snap.index.successor(key);
+    if (not e.has_value())
         return {};
     ++successorHitCounter_.get();
-    return {{e->first, e->second.blob}};
+    successorAgeCounters_.countHit(latestSeq - seq);
+    return {{e->first, snap.toBlob(e->second)}};
 }
 
 std::optional<LedgerObject>
@@ -110,14 +416,14 @@ LedgerCache::getPredecessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
-    if (seq != latestSeq_)
+    auto const view = this->view();
+    auto const& snap = view->closestTo(seq);
+    if (seq != snap.seq or not snap.full)
         return {};
-    auto e = map_.lower_bound(key);
-    if (e == map_.begin())
+    auto const e = snap.index.predecessor(key);
+    if (not e.has_value())
         return {};
-    --e;
-    return {{e->first, e->second.blob}};
+    return {{e->first, snap.toBlob(e->second)}};
 }
 
 std::optional<Blob>
@@ -126,17 +432,54 @@ LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_)
         return {};
 
-    std::shared_lock const lck{mtx_};
-    if (seq > latestSeq_)
+    auto const view = this->view();
+    auto const latestSeq = view->snapshots.front()->seq;
+    if (seq > latestSeq)
         return {};
     ++objectReqCounter_.get();
-    auto e = map_.find(key);
-    if (e == map_.end())
+    objectAgeCounters_.countRequest(latestSeq - seq);
+
+    // an entry that was not modified since seq is valid for seq even if the snapshot is of a later ledger
+    auto const& snap = view->closestTo(seq);
+    auto const* e = snap.index.find(key);
+    if (e == nullptr)
         return {};
-    if (seq < e->second.seq)
+    if (seq < e->seq)
         return {};
     ++objectHitCounter_.get();
-    return {e->second.blob};
+    objectAgeCounters_.countHit(latestSeq - seq);
+    return {snap.toBlob(*e)};
+}
+
+std::optional<std::vector<ripple::uint256>>
+LedgerCache::getBookOffers(ripple::uint256 const& book, uint32_t seq, std::size_t limit) const
+{
+    if (disabled_ or not full_)
+        return {};
+
+    return books_.getOffers(book, seq, limit);
+}
+
+std::optional<std::vector<impl::OwnerIndex::Page>>
+LedgerCache::getOwnerDirPages(
+    ripple::uint256 const& root,
+    std::uint64_t startPage,
+    uint32_t seq,
+    std::size_t minEntries
+) const
+{
+    if (disabled_ or not full_ or not ownerIndexEnabled_)
+        return {};
+
+    return owners_.getPages(root, startPage, seq, minEntries);
+}
+
+uint32_t
+LedgerCache::forEach(std::function<void(ripple::uint256 const&, Blob const&)> const& fn) const
+{
+    auto const snap = view()->snapshots.front();
+    snap->index.forEach([&](auto const& key, auto const& entry) { fn(key, snap->toBlob(entry)); });
+    return snap->seq;
 }
 
 void
@@ -157,9 +500,10 @@ LedgerCache::setFull()
     if (disabled_)
         return;
 
-    full_ = true;
     std::scoped_lock const lck{mtx_};
+    full_ = true;
     deletes_.clear();
+    publish();
 }
 
 bool
@@ -171,8 +515,7 @@ LedgerCache::isFull() const
 size_t
 LedgerCache::size() const
 {
-    std::shared_lock const lck{mtx_};
-    return map_.size();
+    return view()->snapshots.front()->index.size();
 }
 
 float
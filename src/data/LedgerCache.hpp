@@ -20,6 +20,13 @@
 #pragma once
 
 #include "data/Types.hpp"
+#include "data/impl/BTreeIndex.hpp"
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/BlobCodec.hpp"
+#include "data/impl/BookIndex.hpp"
+#include "data/impl/OwnerIndex.hpp"
+#include "util/Mutex.hpp"
+#include "util/log/Logger.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
@@ -27,26 +34,116 @@
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/basics/hardened_hash.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
-#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <shared_mutex>
+#include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace data {
 
 /**
- * @brief Cache for an entire ledger.
+ * @brief Cache for an entire ledger and the state of a few ledgers before it.
+ *
+ * Keys are kept in a B+tree with contiguously packed nodes while the blobs themselves live in a slab arena. This keeps
+ * lookups cache friendly and avoids one heap allocation per object for the tens of millions of objects on mainnet.
+ *
+ * Readers never wait for an update to be built: every call to @ref update publishes an immutable snapshot of the index
+ * (the B+tree is copy-on-write so this is cheap) and all lookups are served from published snapshots. Getting the
+ * current snapshot takes a short per-slot lock that the writer only holds to swap the pointer. The snapshots of the
+ * most recent ledgers (see @ref setNumLedgers) are retained so that requests for slightly older ledgers are served from
+ * memory too. Blobs that are replaced or removed by an update are only given back to the arena once no snapshot that
+ * can see them is alive, i.e. once the ledger they were replaced in is out of the window and no reader uses it anymore.
  */
 class LedgerCache {
     struct CacheEntry {
         uint32_t seq = 0;
-        Blob blob;
+        bool compressed = false;
+        impl::BlobArena::Handle blob;
+    };
+
+    using Index = impl::BTreeIndex<ripple::uint256, CacheEntry>;
+
+    // Blobs whose last snapshot is gone; handed back to the arena by the next update
+    struct ReleasedBlobs {
+        std::mutex mtx;
+        std::vector<impl::BlobArena::Handle> handles;
+    };
+
+    // Blobs dropped by the update that followed a snapshot. Every list keeps the list of the next snapshot alive so
+    // that a blob is only released once all snapshots up to the one it was dropped after are destroyed.
+    struct RetiredBlobs {
+        std::shared_ptr<ReleasedBlobs> released;
+        std::vector<impl::BlobArena::Handle> handles;
+        std::shared_ptr<RetiredBlobs> next;
+
+        explicit RetiredBlobs(std::shared_ptr<ReleasedBlobs> released) : released{std::move(released)}
+        {
+        }
+
+        RetiredBlobs(RetiredBlobs const&) = delete;
+        RetiredBlobs&
+        operator=(RetiredBlobs const&) = delete;
+
+        ~RetiredBlobs();
+    };
+
+    struct Snapshot {
+        Index index;
+        uint32_t seq = 0;
+        bool full = false;
+        std::shared_ptr<impl::BlobCodec const> codec;
+        std::shared_ptr<RetiredBlobs> retired;
+
+        [[nodiscard]] Blob
+        toBlob(CacheEntry const& entry) const
+        {
+            return decode(entry, codec.get());
+        }
+    };
+
+    // The retained snapshots, one per ledger and newest first
+    struct View {
+        std::vector<std::shared_ptr<Snapshot const>> snapshots;
+
+        // the oldest snapshot that is not older than the given sequence; or the newest one if there is none
+        Snapshot const&
+        closestTo(uint32_t seq) const;
+    };
+
+    // Readers are spread over a few copies of the latest view pointer, each with its own reference count, so that
+    // they don't all bounce the same cache line. Copying the pointer out of a slot takes that slot's mutex: one short,
+    // usually uncontended critical section per read that only the readers of the same stripe and the writer's publish
+    // (once per ledger) compete for. std::atomic<std::shared_ptr> would not be lock-free either and is not available
+    // in every standard library Clio is built with.
+    static constexpr std::size_t SNAPSHOT_STRIPES = 16;
+
+    struct alignas(64) ViewSlot {
+        util::Mutex<std::shared_ptr<View const>> view;
+    };
+
+    // Hit rate counters broken down by the age of the requested ledger relative to the latest one
+    class AgeCounters {
+        std::vector<std::reference_wrapper<util::prometheus::CounterInt>> requests_;
+        std::vector<std::reference_wrapper<util::prometheus::CounterInt>> hits_;
+
+    public:
+        explicit AgeCounters(std::string const& fetch);
+
+        void
+        countRequest(uint32_t age) const;
+
+        void
+        countHit(uint32_t age) const;
     };
 
     // counters for fetchLedgerObject(s) hit rate
@@ -71,18 +168,83 @@ class LedgerCache {
         util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "successor_key"}})
     )};
 
-    std::map<ripple::uint256, CacheEntry> map_;
+    AgeCounters objectAgeCounters_{"ledger_objects"};
+    AgeCounters successorAgeCounters_{"successor_key"};
 
-    mutable std::shared_mutex mtx_;
-    std::condition_variable_any cv_;
+    // writer state, guarded by mtx_
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    Index index_;
+    impl::BookIndex books_;
+    impl::OwnerIndex owners_;
+    impl::BlobArena arena_;
+    std::shared_ptr<ReleasedBlobs> released_ = std::make_shared<ReleasedBlobs>();
+    std::shared_ptr<RetiredBlobs> retired_ = std::make_shared<RetiredBlobs>(released_);
     uint32_t latestSeq_ = 0;
-    std::atomic_bool full_ = false;
-    std::atomic_bool disabled_ = false;
+    std::size_t numLedgers_ = DEFAULT_NUM_LEDGERS;
+    std::deque<std::shared_ptr<Snapshot const>> history_;
 
     // temporary set to prevent background thread from writing already deleted data. not used when cache is full
     std::unordered_set<ripple::uint256, ripple::hardened_hash<>> deletes_;
 
+    // compression is enabled on demand; the dictionary is trained on the first objects stored after that
+    bool compressionEnabled_ = false;
+    std::shared_ptr<impl::BlobCodec const> codec_;
+    std::vector<unsigned char> compressionSamples_;
+    std::vector<std::size_t> compressionSampleSizes_;
+
+    std::atomic_bool full_ = false;
+    std::atomic_bool ownerIndexEnabled_ = false;
+    std::atomic_bool disabled_ = false;
+
+    std::array<ViewSlot, SNAPSHOT_STRIPES> slots_;
+
+    util::Logger log_{"Backend"};
+
 public:
+    static constexpr std::size_t DEFAULT_NUM_LEDGERS = 4;
+    static constexpr std::size_t COMPRESSION_SAMPLE_BYTES = 4 * 1024 * 1024;
+
+    /**
+     * @brief An entry of the successor table.
+     */
+    struct SuccessorDelta {
+        ripple::uint256 key;
+        ripple::uint256 successor;
+
+        bool
+        operator==(SuccessorDelta const&) const = default;
+    };
+
+    LedgerCache();
+
+    /**
+     * @brief Sets the number of most recent ledgers served from the cache.
+     *
+     * Takes effect with the next update. Objects of older ledgers are still served if they were not modified since.
+     *
+     * @param numLedgers The number of ledgers; must be at least 1
+     */
+    void
+    setNumLedgers(std::size_t numLedgers);
+
+    /**
+     * @brief Enables compression of the stored objects.
+     *
+     * Objects are stored uncompressed until enough of them were seen to train a compression dictionary; objects that
+     * are already in the cache at that point stay uncompressed. Objects are decompressed whenever they are read.
+     */
+    void
+    enableCompression();
+
+    /**
+     * @brief Enables the index of owner directories.
+     *
+     * The index only sees objects stored after this call, so it must be enabled before the cache is loaded.
+     */
+    void
+    enableOwnerIndex();
+
     /**
      * @brief Update the cache with new ledger objects.
      *
@@ -93,9 +255,28 @@ public:
     void
     update(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground = false);
 
+    /**
+     * @brief Update the full cache with the objects of a new ledger and compute the changes to the successor table.
+     *
+     * Objects that are not in the cache yet are created, objects with an empty blob are deleted. The successor of the
+     * neighbours of every created or deleted object is returned, as well as the successor of the book base of every
+     * book whose first directory changed. Keys at the ends of the ledger are linked to @ref firstKey and @ref lastKey.
+     *
+     * @note The cache must be full.
+     *
+     * @param objs The ledger objects to update cache with
+     * @param seq The sequence to update cache for
+     * @return The successor table entries that changed, ordered by key
+     * @throws std::logic_error if seq is not the ledger right after the latest cached one
+     */
+    std::vector<SuccessorDelta>
+    updateAndGetSuccessors(std::vector<LedgerObject> const& objs, uint32_t seq);
+
     /**
      * @brief Fetch a cached object by its key and sequence number.
      *
+     * Objects are found for any of the most recent ledgers and for older ledgers if the object was not modified since.
+     *
      * @param key The key to fetch for
      * @param seq The sequence to fetch for
      * @return If found in cache, will return the cached Blob; otherwise nullopt is returned
@@ -106,7 +287,8 @@ public:
     /**
      * @brief Gets a cached successor.
      *
-     * Note: This function always returns std::nullopt when @ref isFull() returns false.
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or when the sequence is not one
+     * of the most recent ledgers.
      *
      * @param key The key to fetch for
      * @param seq The sequence to fetch for
@@ -118,7 +300,8 @@ public:
     /**
      * @brief Gets a cached predcessor.
      *
-     * Note: This function always returns std::nullopt when @ref isFull() returns false.
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or when the sequence is not one
+     * of the most recent ledgers.
      *
      * @param key The key to fetch for
      * @param seq The sequence to fetch for
@@ -127,6 +310,49 @@ public:
     std::optional<LedgerObject>
     getPredecessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Gets the keys of the best offers of a book.
+     *
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or when the sequence is not the
+     * latest ledger.
+     *
+     * @param book The book base of the book
+     * @param seq The sequence to fetch for
+     * @param limit The number of offers after which no further directory page is read
+     * @return The offer keys of whole pages, best quality first; nullopt if the book can't be served from the cache
+     */
+    std::optional<std::vector<ripple::uint256>>
+    getBookOffers(ripple::uint256 const& book, uint32_t seq, std::size_t limit) const;
+
+    /**
+     * @brief Gets the pages of an owner directory.
+     *
+     * Note: This function always returns std::nullopt when the owner index is not enabled, when @ref isFull() returns
+     * false or when the sequence is not the latest ledger.
+     *
+     * @param root The key of the owner directory
+     * @param startPage The number of the first page to return
+     * @param seq The sequence to fetch for
+     * @param minEntries The number of entries after which no more pages are returned
+     * @return The pages in the order they are linked; nullopt if the directory can't be served from the cache
+     */
+    std::optional<std::vector<impl::OwnerIndex::Page>>
+    getOwnerDirPages(
+        ripple::uint256 const& root,
+        std::uint64_t startPage,
+        uint32_t seq,
+        std::size_t minEntries
+    ) const;
+
+    /**
+     * @brief Calls the given function for every object of the latest ledger, in key order.
+     *
+     * @param fn The function to call with the key and the blob of each object
+     * @return The sequence of the ledger the objects belong to
+     */
+    uint32_t
+    forEach(std::function<void(ripple::uint256 const&, Blob const&)> const& fn) const;
+
     /**
      * @brief Disables the cache.
      */
@@ -186,6 +412,25 @@ public:
      */
     void
     waitUntilCacheContainsSeq(uint32_t seq);
+
+private:
+    [[nodiscard]] static Blob
+    decode(CacheEntry const& entry, impl::BlobCodec const* codec);
+
+    [[nodiscard]] std::shared_ptr<View const>
+    view() const;
+
+    void
+    apply(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground);
+
+    void
+    retire(impl::BlobArena::Handle handle);
+
+    [[nodiscard]] CacheEntry
+    store(Blob const& blob, uint32_t seq);
+
+    void
+    publish();
 };
 
 }  // namespace data
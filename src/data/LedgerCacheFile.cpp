@@ -0,0 +1,261 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCacheFile.hpp"
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+
+#include <boost/crc.hpp>
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <fmt/core.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC{'C', 'L', 'I', 'O', 'C', 'A', 'C', 'H'};
+
+// all integers are stored in native byte order
+struct Header {
+    std::array<char, 8> magic = MAGIC;
+    std::uint32_t version = LedgerCacheFile::VERSION;
+    std::uint32_t seq = 0;
+    std::uint64_t numObjects = 0;
+};
+
+constexpr std::size_t HEADER_SIZE = sizeof(Header::magic) + sizeof(Header::version) + sizeof(Header::seq) +
+    sizeof(Header::numObjects);
+constexpr std::size_t KEY_SIZE = ripple::uint256::size();
+using BlobSize = std::uint32_t;
+using Checksum = std::uint32_t;
+
+template <typename T>
+T
+readValue(std::span<unsigned char const> bytes, std::size_t offset)
+{
+    T value{};
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+unsigned char*
+writeValue(unsigned char* out, T const& value)
+{
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+std::array<unsigned char, HEADER_SIZE>
+serialize(Header const& header)
+{
+    std::array<unsigned char, HEADER_SIZE> bytes{};
+    auto* out = writeValue(bytes.data(), header.magic);
+    out = writeValue(out, header.version);
+    out = writeValue(out, header.seq);
+    writeValue(out, header.numObjects);
+    return bytes;
+}
+
+void
+writeBytes(std::ofstream& out, void const* data, std::size_t size)
+{
+    out.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+}
+
+std::expected<Header, std::string>
+parseHeader(std::span<unsigned char const> bytes)
+{
+    if (bytes.size() < HEADER_SIZE + sizeof(Checksum))
+        return std::unexpected{"File is too small"};
+
+    Header header;
+    std::memcpy(header.magic.data(), bytes.data(), sizeof(header.magic));
+    header.version = readValue<std::uint32_t>(bytes, sizeof(header.magic));
+    header.seq = readValue<std::uint32_t>(bytes, sizeof(header.magic) + sizeof(header.version));
+    header.numObjects =
+        readValue<std::uint64_t>(bytes, sizeof(header.magic) + sizeof(header.version) + sizeof(header.seq));
+
+    if (header.magic != MAGIC)
+        return std::unexpected{"Not a cache snapshot"};
+    if (header.version != LedgerCacheFile::VERSION)
+        return std::unexpected{fmt::format("Unsupported version {}", header.version)};
+
+    return header;
+}
+
+// read-only mapping of a whole file
+class MappedFile {
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+
+public:
+    explicit MappedFile(std::string const& path)
+        : file_{path.c_str(), boost::interprocess::read_only}, region_{file_, boost::interprocess::read_only}
+    {
+    }
+
+    [[nodiscard]] std::span<unsigned char const>
+    bytes() const
+    {
+        return {static_cast<unsigned char const*>(region_.get_address()), region_.get_size()};
+    }
+};
+
+}  // namespace
+
+LedgerCacheFile::LedgerCacheFile(std::string path) : path_{std::move(path)}
+{
+}
+
+std::expected<std::uint32_t, std::string>
+LedgerCacheFile::write(LedgerCache const& cache) const
+{
+    auto const tmpPath = path_ + ".tmp";
+    std::ofstream out{tmpPath, std::ios::binary | std::ios::trunc};
+    if (not out)
+        return std::unexpected{fmt::format("Could not open {}", tmpPath)};
+
+    // the header is only known once all objects are written; the checksum covers the objects followed by the header
+    boost::crc_32_type crc;
+    auto const put = [&out, &crc](void const* data, std::size_t size) {
+        writeBytes(out, data, size);
+        crc.process_bytes(data, size);
+    };
+
+    Header header;
+    std::array<unsigned char, HEADER_SIZE> const placeholder{};
+    writeBytes(out, placeholder.data(), placeholder.size());
+    header.seq = cache.forEach([&](ripple::uint256 const& key, Blob const& blob) {
+        auto const size = static_cast<BlobSize>(blob.size());
+        put(key.data(), KEY_SIZE);
+        put(&size, sizeof(size));
+        put(blob.data(), blob.size());
+        ++header.numObjects;
+    });
+
+    auto const headerBytes = serialize(header);
+    crc.process_bytes(headerBytes.data(), headerBytes.size());
+    Checksum const checksum = crc.checksum();
+    writeBytes(out, &checksum, sizeof(checksum));
+    out.seekp(0);
+    writeBytes(out, headerBytes.data(), headerBytes.size());
+    out.close();
+
+    if (not out)
+        return std::unexpected{fmt::format("Could not write {}", tmpPath)};
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path_, ec);
+    if (ec)
+        return std::unexpected{fmt::format("Could not move {} to {}: {}", tmpPath, path_, ec.message())};
+
+    return header.seq;
+}
+
+std::expected<std::uint32_t, std::string>
+LedgerCacheFile::readSequence() const
+{
+    try {
+        // only the pages of the header are actually read
+        MappedFile const file{path_};
+        auto const header = parseHeader(file.bytes());
+        if (not header.has_value())
+            return std::unexpected{header.error()};
+
+        return header->seq;
+    } catch (boost::interprocess::interprocess_exception const& e) {
+        return std::unexpected{fmt::format("Could not map {}: {}", path_, e.what())};
+    }
+}
+
+std::expected<std::uint32_t, std::string>
+LedgerCacheFile::read(PageCallback const& onPage, std::size_t pageSize) const
+{
+    try {
+        MappedFile const file{path_};
+        auto const bytes = file.bytes();
+
+        auto const header = parseHeader(bytes);
+        if (not header.has_value())
+            return std::unexpected{header.error()};
+
+        auto const objects = bytes.subspan(HEADER_SIZE, bytes.size() - HEADER_SIZE - sizeof(Checksum));
+        boost::crc_32_type crc;
+        crc.process_bytes(objects.data(), objects.size());
+        crc.process_bytes(bytes.data(), HEADER_SIZE);
+        if (crc.checksum() != readValue<Checksum>(bytes, bytes.size() - sizeof(Checksum)))
+            return std::unexpected{"Checksum mismatch"};
+
+        // the checksum only guards against corruption; the structure is checked before anything is handed out
+        std::uint64_t numObjects = 0;
+        for (std::size_t offset = 0; offset < objects.size(); ++numObjects) {
+            if (objects.size() - offset < KEY_SIZE + sizeof(BlobSize))
+                return std::unexpected{"Truncated object"};
+            offset += KEY_SIZE + sizeof(BlobSize) + readValue<BlobSize>(objects, offset + KEY_SIZE);
+            if (offset > objects.size())
+                return std::unexpected{"Truncated object"};
+        }
+        if (numObjects != header->numObjects)
+            return std::unexpected{fmt::format("Expected {} objects, found {}", header->numObjects, numObjects)};
+
+        std::vector<LedgerObject> page;
+        page.reserve(pageSize);
+        for (std::size_t offset = 0; offset < objects.size();) {
+            auto const size = readValue<BlobSize>(objects, offset + KEY_SIZE);
+            auto const* blob = objects.data() + offset + KEY_SIZE + sizeof(BlobSize);
+
+            auto& obj = page.emplace_back();
+            std::copy_n(objects.data() + offset, KEY_SIZE, obj.key.begin());
+            obj.blob.assign(blob, blob + size);
+            offset += KEY_SIZE + sizeof(BlobSize) + size;
+
+            if (page.size() == pageSize or offset == objects.size()) {
+                onPage(page, header->seq);
+                page.clear();
+            }
+        }
+
+        return header->seq;
+    } catch (boost::interprocess::interprocess_exception const& e) {
+        return std::unexpected{fmt::format("Could not map {}: {}", path_, e.what())};
+    }
+}
+
+}  // namespace data
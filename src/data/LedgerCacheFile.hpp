@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief On-disk snapshot of the latest ledger held by a LedgerCache.
+ *
+ * The file starts with a header holding a magic number, the format version, the ledger sequence and the number of
+ * objects. It is followed by the objects in key order and a CRC-32 of everything before it. A file is written to a
+ * temporary location first and then moved in place, so a crash while writing never leaves a truncated snapshot behind.
+ */
+class LedgerCacheFile {
+    std::string path_;
+
+public:
+    static constexpr std::uint32_t VERSION = 1;
+
+    /** @brief Callback receiving the objects of a snapshot page by page, together with the ledger sequence */
+    using PageCallback = std::function<void(std::vector<LedgerObject> const&, std::uint32_t)>;
+
+    /**
+     * @brief Construct a new LedgerCacheFile object.
+     *
+     * @param path The path of the file
+     */
+    explicit LedgerCacheFile(std::string path);
+
+    /**
+     * @brief Write the latest ledger of the cache to the file, replacing any previous snapshot.
+     *
+     * @param cache The cache to write; should be full
+     * @return The sequence of the written ledger on success; error message otherwise
+     */
+    [[nodiscard]] std::expected<std::uint32_t, std::string>
+    write(LedgerCache const& cache) const;
+
+    /**
+     * @brief Read the ledger sequence stored in the file.
+     *
+     * Only the header is checked; the objects are validated by @ref read.
+     *
+     * @return The sequence on success; error message otherwise
+     */
+    [[nodiscard]] std::expected<std::uint32_t, std::string>
+    readSequence() const;
+
+    /**
+     * @brief Validate the whole file and read all objects from it.
+     *
+     * Nothing is passed to the callback unless the entire file is valid.
+     *
+     * @param onPage Called for every page of objects
+     * @param pageSize The number of objects per page
+     * @return The sequence of the stored ledger on success; error message otherwise
+     */
+    [[nodiscard]] std::expected<std::uint32_t, std::string>
+    read(PageCallback const& onPage, std::size_t pageSize) const;
+};
+
+}  // namespace data
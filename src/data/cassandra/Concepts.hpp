@@ -58,15 +58,19 @@ concept SomeExecutionStrategy = requires(
     Statement statement,
     std::vector<Statement> statements,
     PreparedStatement prepared,
+    std::uint32_t ledgerSequence,
     boost::asio::yield_context token
 ) {
     { T(settings, handle) };
     { a.sync() } -> std::same_as<void>;
+    { a.syncLedger(ledgerSequence) } -> std::same_as<void>;
     { a.isTooBusy() } -> std::same_as<bool>;
     { a.writeSync(statement) } -> std::same_as<ResultOrError>;
     { a.writeSync(prepared) } -> std::same_as<ResultOrError>;
     { a.write(prepared) } -> std::same_as<void>;
     { a.write(std::move(statements)) } -> std::same_as<void>;
+    { a.writeForLedger(ledgerSequence, prepared) } -> std::same_as<void>;
+    { a.writeForLedger(ledgerSequence, std::move(statements)) } -> std::same_as<void>;
     { a.read(token, prepared) } -> std::same_as<ResultOrError>;
     { a.read(token, statement) } -> std::same_as<ResultOrError>;
     { a.read(token, statements) } -> std::same_as<ResultOrError>;
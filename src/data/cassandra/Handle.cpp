@@ -152,6 +152,14 @@ Handle::asyncExecute(std::vector<StatementType> const& statements, std::function
     return Handle::FutureWithCallbackType{cass_session_execute_batch(session_, Batch{statements}), std::move(cb)};
 }
 
+Handle::FutureWithCallbackType
+Handle::asyncExecute(impl::UnloggedBatch<StatementType> const& batch, std::function<void(ResultOrErrorType)>&& cb) const
+{
+    return Handle::FutureWithCallbackType{
+        cass_session_execute_batch(session_, Batch{batch.statements, CASS_BATCH_TYPE_UNLOGGED}), std::move(cb)
+    };
+}
+
 Handle::PreparedStatementType
 Handle::prepare(std::string_view query) const
 {
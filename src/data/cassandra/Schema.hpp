@@ -485,6 +485,20 @@ public:
             ));
         }();
 
+        PreparedStatement selectObjects = [this]() {
+            // clustering order is sequence DESC, so the first row of each partition is the latest version
+            return handle_.get().prepare(fmt::format(
+                R"(
+                SELECT key, object
+                  FROM {}
+                 WHERE key IN ?
+                   AND sequence <= ?
+     PER PARTITION LIMIT 1
+                )",
+                qualifiedTableName(settingsProvider_.get(), "objects")
+            ));
+        }();
+
         PreparedStatement selectTransaction = [this]() {
             return handle_.get().prepare(fmt::format(
                 R"(
@@ -496,6 +510,17 @@ public:
             ));
         }();
 
+        PreparedStatement selectTransactions = [this]() {
+            return handle_.get().prepare(fmt::format(
+                R"(
+                SELECT hash, transaction, metadata, ledger_sequence, date
+                  FROM {}
+                 WHERE hash IN ?
+                )",
+                qualifiedTableName(settingsProvider_.get(), "transactions")
+            ));
+        }();
+
         PreparedStatement selectAllTransactionHashesInLedger = [this]() {
             return handle_.get().prepare(fmt::format(
                 R"(
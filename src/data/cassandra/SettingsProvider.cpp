@@ -27,6 +27,7 @@
 #include <boost/json/conversion.hpp>
 #include <boost/json/value.hpp>
 
+#include <algorithm>
 #include <cerrno>
 #include <chrono>
 #include <cstddef>
@@ -124,6 +125,12 @@ SettingsProvider::parseSettings() const
         config_.valueOr<uint32_t>("core_connections_per_host", settings.coreConnectionsPerHost);
     settings.queueSizeIO = config_.maybeValue<uint32_t>("queue_size_io");
     settings.writeBatchSize = config_.valueOr<std::size_t>("write_batch_size", settings.writeBatchSize);
+    settings.writeCoalescingWindow = std::chrono::milliseconds{
+        config_.valueOr<uint32_t>("write_coalescing_window", Settings::DEFAULT_WRITE_COALESCING_WINDOW)
+    };
+    settings.readBatchSize = std::max<std::size_t>(
+        config_.valueOr<std::size_t>("read_batch_size", settings.readBatchSize), 1
+    );
 
     auto const connectTimeoutSecond = config_.maybeValue<uint32_t>("connect_timeout");
     if (connectTimeoutSecond)
@@ -36,9 +36,8 @@ constexpr auto batchDeleter = [](CassBatch* ptr) { cass_batch_free(ptr); };
 
 namespace data::cassandra::impl {
 
-// TODO: Use an appropriate value instead of CASS_BATCH_TYPE_LOGGED for different use cases
-Batch::Batch(std::vector<Statement> const& statements)
-    : ManagedObject{cass_batch_new(CASS_BATCH_TYPE_LOGGED), batchDeleter}
+Batch::Batch(std::vector<Statement> const& statements, CassBatchType type)
+    : ManagedObject{cass_batch_new(type), batchDeleter}
 {
     cass_batch_set_is_idempotent(*this, cass_true);
 
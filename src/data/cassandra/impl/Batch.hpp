@@ -28,8 +28,20 @@
 
 namespace data::cassandra::impl {
 
+/**
+ * @brief Statements to execute as an unlogged batch, i.e. without going through the batchlog.
+ *
+ * Only meant for statements that write to the same partition, which the database applies as a single mutation anyway.
+ *
+ * @tparam StatementType The type of the statements
+ */
+template <typename StatementType>
+struct UnloggedBatch {
+    std::vector<StatementType> statements;
+};
+
 struct Batch : public ManagedObject<CassBatch> {
-    Batch(std::vector<Statement> const& statements);
+    Batch(std::vector<Statement> const& statements, CassBatchType type = CASS_BATCH_TYPE_LOGGED);
 
     MaybeError
     add(Statement const& statement);
@@ -43,6 +43,8 @@ struct Settings {
     static constexpr uint32_t DEFAULT_MAX_WRITE_REQUESTS_OUTSTANDING = 10'000;
     static constexpr uint32_t DEFAULT_MAX_READ_REQUESTS_OUTSTANDING = 100'000;
     static constexpr std::size_t DEFAULT_BATCH_SIZE = 20;
+    static constexpr std::size_t DEFAULT_READ_BATCH_SIZE = 100;
+    static constexpr uint32_t DEFAULT_WRITE_COALESCING_WINDOW = 1;
 
     /**
      * @brief Represents the configuration of contact points for cassandra.
@@ -86,6 +88,12 @@ struct Settings {
     /** @brief Size of batches when writing */
     std::size_t writeBatchSize = DEFAULT_BATCH_SIZE;
 
+    /** @brief Maximum number of keys read by a single multi-key query */
+    std::size_t readBatchSize = DEFAULT_READ_BATCH_SIZE;
+
+    /** @brief How long a write may be held back to be batched with other writes to its partition; 0 disables it */
+    std::chrono::milliseconds writeCoalescingWindow = std::chrono::milliseconds{DEFAULT_WRITE_COALESCING_WINDOW};
+
     /** @brief Size of the IO queue */
     std::optional<uint32_t> queueSizeIO = std::nullopt;  // NOLINT(readability-redundant-member-init)
 
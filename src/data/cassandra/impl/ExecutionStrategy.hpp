@@ -24,6 +24,9 @@
 #include "data/cassandra/Handle.hpp"
 #include "data/cassandra/Types.hpp"
 #include "data/cassandra/impl/AsyncExecutor.hpp"
+#include "data/cassandra/impl/Batch.hpp"
+#include "data/cassandra/impl/ReadConcurrencyLimiter.hpp"
+#include "data/cassandra/impl/WriteCoalescer.hpp"
 #include "util/Assert.hpp"
 #include "util/Batching.hpp"
 #include "util/log/Logger.hpp"
@@ -35,16 +38,19 @@
 #include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -66,7 +72,7 @@ class DefaultExecutionStrategy {
     std::uint32_t maxWriteRequestsOutstanding_;
     std::atomic_uint32_t numWriteRequestsOutstanding_ = 0;
 
-    std::uint32_t maxReadRequestsOutstanding_;
+    ReadConcurrencyLimiter readLimiter_;
     std::atomic_uint32_t numReadRequestsOutstanding_ = 0;
 
     std::size_t writeBatchSize_;
@@ -76,6 +82,8 @@ class DefaultExecutionStrategy {
 
     std::mutex syncMutex_;
     std::condition_variable syncCv_;
+    // outstanding writes by the ledger they belong to; untagged writes count as ledger 0
+    std::map<std::uint32_t, std::size_t> outstandingByLedger_;
 
     boost::asio::io_context ioc_;
     std::optional<boost::asio::io_service::work> work_;
@@ -85,6 +93,14 @@ class DefaultExecutionStrategy {
 
     typename BackendCountersType::PtrType counters_;
 
+    struct LedgerStatement {
+        std::uint32_t ledgerSequence;
+        typename HandleType::StatementType statement;
+    };
+
+    // declared last so it is gone before the io_context its timer runs on
+    std::optional<WriteCoalescer<LedgerStatement>> coalescer_;
+
 public:
     using ResultOrErrorType = typename HandleType::ResultOrErrorType;
     using StatementType = typename HandleType::StatementType;
@@ -104,7 +120,7 @@ public:
         typename BackendCountersType::PtrType counters = BackendCountersType::make()
     )
         : maxWriteRequestsOutstanding_{settings.maxWriteRequestsOutstanding}
-        , maxReadRequestsOutstanding_{settings.maxReadRequestsOutstanding}
+        , readLimiter_{settings.maxReadRequestsOutstanding}
         , writeBatchSize_{settings.writeBatchSize}
         , work_{ioc_}
         , handle_{std::cref(handle)}
@@ -112,7 +128,16 @@ public:
         , counters_{std::move(counters)}
     {
         LOG(log_.info()) << "Max write requests outstanding is " << maxWriteRequestsOutstanding_
-                         << "; Max read requests outstanding is " << maxReadRequestsOutstanding_;
+                         << "; Max read requests outstanding is " << readLimiter_.limit();
+
+        if (settings.writeCoalescingWindow > std::chrono::milliseconds::zero()) {
+            coalescer_.emplace(
+                ioc_,
+                writeBatchSize_,
+                settings.writeCoalescingWindow,
+                [this](std::vector<LedgerStatement>&& batch) { executeCoalesced(std::move(batch)); }
+            );
+        }
     }
 
     ~DefaultExecutionStrategy()
@@ -129,18 +154,47 @@ public:
     sync()
     {
         LOG(log_.debug()) << "Waiting to sync all writes...";
+        if (coalescer_.has_value())
+            coalescer_->flush();
+
         std::unique_lock<std::mutex> lck(syncMutex_);
         syncCv_.wait(lck, [this]() { return finishedAllWriteRequests(); });
         LOG(log_.debug()) << "Sync done.";
     }
 
     /**
+     * @brief Wait for the async writes of the given ledger and all ledgers before it to finish before unblocking.
+     *
+     * Writes issued for later ledgers in the meantime are not waited for. Writes that were not issued for a specific
+     * ledger are always waited for.
+     *
+     * @param ledgerSequence The latest ledger to wait for
+     */
+    void
+    syncLedger(std::uint32_t ledgerSequence)
+    {
+        LOG(log_.debug()) << "Waiting to sync writes up to ledger " << ledgerSequence << "...";
+        if (coalescer_.has_value())
+            coalescer_->flush();
+
+        std::unique_lock<std::mutex> lck(syncMutex_);
+        syncCv_.wait(lck, [this, ledgerSequence]() {
+            return outstandingByLedger_.empty() or outstandingByLedger_.begin()->first > ledgerSequence;
+        });
+        LOG(log_.debug()) << "Sync done.";
+    }
+
+    /**
+     * @brief Check whether the adaptive limit of outstanding read requests is reached.
+     *
+     * The limit starts at the configured maximum and shrinks when the read latency rises above its baseline.
+     *
      * @return true if outstanding read requests allowance is exhausted; false otherwise
      */
     bool
     isTooBusy() const
     {
-        bool const result = numReadRequestsOutstanding_ >= maxReadRequestsOutstanding_;
+        bool const result = readLimiter_.isExhausted(numReadRequestsOutstanding_);
         if (result)
             counters_->registerTooBusy();
         return result;
@@ -183,7 +237,9 @@ public:
     /**
      * @brief Non-blocking query execution used for writing data.
      *
-     * Retries forever with retry policy specified by @ref AsyncExecutor
+     * Retries forever with retry policy specified by @ref AsyncExecutor.
+     * Unless write coalescing is disabled, the statement is held back for up to the coalescing window and executed in
+     * an unlogged batch together with other writes of the same statement to the same partition.
      *
      * @param preparedStatement Statement to prepare and execute
      * @param args Args to bind to the prepared statement
@@ -193,24 +249,35 @@ public:
     void
     write(PreparedStatementType const& preparedStatement, Args&&... args)
     {
-        auto const startTime = std::chrono::steady_clock::now();
+        writeForLedger(0u, preparedStatement, std::forward<Args>(args)...);
+    }
 
+    /**
+     * @brief Non-blocking query execution used for writing the data of a ledger.
+     *
+     * Same as @ref write but the write is only waited for by @ref syncLedger for the given ledger or a later one.
+     *
+     * @param ledgerSequence The ledger the written data belongs to
+     * @param preparedStatement Statement to prepare and execute
+     * @param args Args to bind to the prepared statement
+     * @throw DatabaseTimeout on timeout
+     */
+    template <typename... Args>
+    void
+    writeForLedger(std::uint32_t ledgerSequence, PreparedStatementType const& preparedStatement, Args&&... args)
+    {
+        auto const partitionKey = coalescer_.has_value() ? partitionKeyOf(args...) : std::nullopt;
         auto statement = preparedStatement.bind(std::forward<Args>(args)...);
-        incrementOutstandingRequestCount();
+        incrementOutstandingRequestCount(ledgerSequence);
 
-        counters_->registerWriteStarted();
-        // Note: lifetime is controlled by std::shared_from_this internally
-        AsyncExecutor<std::decay_t<decltype(statement)>, HandleType>::run(
-            ioc_,
-            handle_,
-            std::move(statement),
-            [this, startTime](auto const&) {
-                decrementOutstandingRequestCount();
-
-                counters_->registerWriteFinished(startTime);
-            },
-            [this]() { counters_->registerWriteRetry(); }
-        );
+        if (partitionKey.has_value()) {
+            coalescer_->add(
+                {.statement = &preparedStatement, .partition = *partitionKey},
+                LedgerStatement{ledgerSequence, std::move(statement)}
+            );
+        } else {
+            executeWrite(std::move(statement), ledgerSequence);
+        }
     }
 
     /**
@@ -223,31 +290,33 @@ public:
      */
     void
     write(std::vector<StatementType>&& statements)
+    {
+        writeForLedger(0u, std::move(statements));
+    }
+
+    /**
+     * @brief Non-blocking batched query execution used for writing the data of a ledger.
+     *
+     * Same as @ref write but the batches are only waited for by @ref syncLedger for the given ledger or a later one.
+     *
+     * @param ledgerSequence The earliest ledger the written data belongs to
+     * @param statements Vector of statements to execute as a batch
+     * @throw DatabaseTimeout on timeout
+     */
+    void
+    writeForLedger(std::uint32_t ledgerSequence, std::vector<StatementType>&& statements)
     {
         if (statements.empty())
             return;
 
-        util::forEachBatch(std::move(statements), writeBatchSize_, [this](auto begin, auto end) {
-            auto const startTime = std::chrono::steady_clock::now();
+        util::forEachBatch(std::move(statements), writeBatchSize_, [this, ledgerSequence](auto begin, auto end) {
             auto chunk = std::vector<StatementType>{};
 
             chunk.reserve(std::distance(begin, end));
             std::move(begin, end, std::back_inserter(chunk));
 
-            incrementOutstandingRequestCount();
-            counters_->registerWriteStarted();
-
-            // Note: lifetime is controlled by std::shared_from_this internally
-            AsyncExecutor<std::decay_t<decltype(chunk)>, HandleType>::run(
-                ioc_,
-                handle_,
-                std::move(chunk),
-                [this, startTime](auto const&) {
-                    decrementOutstandingRequestCount();
-                    counters_->registerWriteFinished(startTime);
-                },
-                [this]() { counters_->registerWriteRetry(); }
-            );
+            incrementOutstandingRequestCount(ledgerSequence);
+            executeWrite(std::move(chunk), ledgerSequence);
         });
     }
 
@@ -309,7 +378,7 @@ public:
             numReadRequestsOutstanding_ -= numStatements;
 
             if (res) {
-                counters_->registerReadFinished(startTime, numStatements);
+                registerReadFinished(startTime, numStatements);
                 return res;
             }
 
@@ -362,7 +431,7 @@ public:
             --numReadRequestsOutstanding_;
 
             if (res) {
-                counters_->registerReadFinished(startTime);
+                registerReadFinished(startTime);
                 return res;
             }
 
@@ -433,10 +502,10 @@ public:
         if (errorsCount > 0) {
             ASSERT(errorsCount <= statements.size(), "Errors number cannot exceed statements number");
             counters_->registerReadError(errorsCount);
-            counters_->registerReadFinished(startTime, statements.size() - errorsCount);
+            registerReadFinished(startTime, statements.size() - errorsCount);
             throw DatabaseTimeout{};
         }
-        counters_->registerReadFinished(startTime, statements.size());
+        registerReadFinished(startTime, statements.size());
 
         std::vector<ResultType> results;
         results.reserve(futures.size());
@@ -478,8 +547,70 @@ public:
     }
 
 private:
+    /**
+     * @brief Execute a statement or a batch of statements that already took its outstanding request slots.
+     *
+     * @param data The statement or batch to execute
+     * @param ledgerSequence The ledger the outstanding request slots were taken for
+     * @param startTime The time the write was requested
+     * @param numRequests The number of outstanding request slots to release once done
+     */
+    template <typename DataType>
     void
-    incrementOutstandingRequestCount()
+    executeWrite(
+        DataType&& data,
+        std::uint32_t ledgerSequence,
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now(),
+        std::size_t numRequests = 1u
+    )
+    {
+        counters_->registerWriteStarted();
+
+        // Note: lifetime is controlled by std::shared_from_this internally
+        AsyncExecutor<std::decay_t<DataType>, HandleType>::run(
+            ioc_,
+            handle_,
+            std::forward<DataType>(data),
+            [this, ledgerSequence, startTime, numRequests](auto const&) {
+                decrementOutstandingRequestCount(ledgerSequence, numRequests);
+                counters_->registerWriteFinished(startTime);
+            },
+            [this]() { counters_->registerWriteRetry(); }
+        );
+    }
+
+    void
+    executeCoalesced(std::vector<LedgerStatement>&& batch)
+    {
+        auto const numRequests = batch.size();
+
+        // a batch of one is cheaper to execute as a plain statement
+        if (numRequests == 1u) {
+            executeWrite(std::move(batch.front().statement), batch.front().ledgerSequence);
+            return;
+        }
+
+        // a batch can hold writes of consecutive ledgers; it is released for the earliest one so that syncing any of
+        // them waits for the whole batch
+        auto const earliest = std::ranges::min(batch, {}, &LedgerStatement::ledgerSequence).ledgerSequence;
+
+        std::vector<StatementType> statements;
+        statements.reserve(numRequests);
+        for (auto& item : batch) {
+            if (item.ledgerSequence != earliest)
+                moveOutstandingRequest(item.ledgerSequence, earliest);
+
+            statements.push_back(std::move(item.statement));
+        }
+
+        // all statements write to a single partition of a single table, so the batchlog would only add overhead
+        executeWrite(
+            UnloggedBatch<StatementType>{std::move(statements)}, earliest, std::chrono::steady_clock::now(), numRequests
+        );
+    }
+
+    void
+    incrementOutstandingRequestCount(std::uint32_t ledgerSequence)
     {
         {
             std::unique_lock<std::mutex> lck(throttleMutex_);
@@ -490,28 +621,53 @@ private:
             }
         }
         ++numWriteRequestsOutstanding_;
+
+        std::lock_guard const lck(syncMutex_);
+        ++outstandingByLedger_[ledgerSequence];
     }
 
     void
-    decrementOutstandingRequestCount()
+    decrementOutstandingRequestCount(std::uint32_t ledgerSequence, std::size_t count = 1u)
     {
         // sanity check
-        ASSERT(numWriteRequestsOutstanding_ > 0, "Decrementing num outstanding below 0");
-        size_t const cur = (--numWriteRequestsOutstanding_);
+        ASSERT(numWriteRequestsOutstanding_ >= count, "Decrementing num outstanding below 0");
+        numWriteRequestsOutstanding_ -= static_cast<std::uint32_t>(count);
         {
             // mutex lock required to prevent race condition around spurious
             // wakeup
             std::lock_guard const lck(throttleMutex_);
-            throttleCv_.notify_one();
+            throttleCv_.notify_all();
         }
-        if (cur == 0) {
-            // mutex lock required to prevent race condition around spurious
-            // wakeup
-            std::lock_guard const lck(syncMutex_);
-            syncCv_.notify_one();
+
+        // mutex lock required to prevent race condition around spurious
+        // wakeup
+        std::lock_guard const lck(syncMutex_);
+        auto const it = outstandingByLedger_.find(ledgerSequence);
+        ASSERT(
+            it != outstandingByLedger_.end() and it->second >= count,
+            "Decrementing num outstanding below 0 for ledger {}",
+            ledgerSequence
+        );
+
+        it->second -= count;
+        if (it->second == 0) {
+            outstandingByLedger_.erase(it);
+            syncCv_.notify_all();
         }
     }
 
+    void
+    moveOutstandingRequest(std::uint32_t fromLedgerSequence, std::uint32_t toLedgerSequence)
+    {
+        std::lock_guard const lck(syncMutex_);
+        ++outstandingByLedger_[toLedgerSequence];
+
+        auto const it = outstandingByLedger_.find(fromLedgerSequence);
+        ASSERT(it != outstandingByLedger_.end(), "No outstanding requests for ledger {}", fromLedgerSequence);
+        if (--it->second == 0)
+            outstandingByLedger_.erase(it);
+    }
+
     bool
     canAddWriteRequest() const
     {
@@ -521,7 +677,20 @@ private:
     bool
     finishedAllWriteRequests() const
     {
-        return numWriteRequestsOutstanding_ == 0;
+        // must be called with syncMutex_ locked
+        return outstandingByLedger_.empty();
+    }
+
+    void
+    registerReadFinished(std::chrono::steady_clock::time_point startTime, std::uint64_t count = 1u)
+    {
+        counters_->registerReadFinished(startTime, count);
+
+        // the finished reads were already subtracted from the outstanding ones but were in flight the whole time
+        readLimiter_.addSample(
+            std::chrono::steady_clock::now() - startTime,
+            numReadRequestsOutstanding_ + static_cast<std::uint32_t>(count)
+        );
     }
 
     void
@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/KeyBatches.hpp"
+
+#include "util/Assert.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace data::cassandra::impl {
+
+namespace {
+
+constexpr std::uint64_t C1 = 0x87c3'7b91'1142'53d5ULL;
+constexpr std::uint64_t C2 = 0x4cf5'ad43'2745'937fULL;
+
+std::uint64_t
+readBlock(std::span<std::uint8_t const> key, std::size_t offset)
+{
+    std::uint64_t block = 0;
+    for (std::size_t i = 0; i < sizeof(block); ++i)
+        block |= static_cast<std::uint64_t>(key[offset + i]) << (8 * i);
+
+    return block;
+}
+
+// the partitioner reads the tail as signed bytes, so bytes above 0x7f are sign extended
+std::uint64_t
+tailByte(std::span<std::uint8_t const> key, std::size_t offset)
+{
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int8_t>(key[offset])));
+}
+
+std::uint64_t
+mixK1(std::uint64_t k1)
+{
+    return std::rotl(k1 * C1, 31) * C2;
+}
+
+std::uint64_t
+mixK2(std::uint64_t k2)
+{
+    return std::rotl(k2 * C2, 33) * C1;
+}
+
+std::uint64_t
+finalMix(std::uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51'afd7'ed55'8ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ce'b9fe'1a85'ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+}  // namespace
+
+std::int64_t
+murmur3Token(std::span<std::uint8_t const> key)
+{
+    static constexpr std::size_t BLOCK_SIZE = 16;
+
+    std::uint64_t h1 = 0;
+    std::uint64_t h2 = 0;
+
+    auto const numBlocks = key.size() / BLOCK_SIZE;
+    for (std::size_t i = 0; i < numBlocks; ++i) {
+        auto const offset = i * BLOCK_SIZE;
+
+        h1 ^= mixK1(readBlock(key, offset));
+        h1 = std::rotl(h1, 27) + h2;
+        h1 = h1 * 5 + 0x52dc'e729;
+
+        h2 ^= mixK2(readBlock(key, offset + 8));
+        h2 = std::rotl(h2, 31) + h1;
+        h2 = h2 * 5 + 0x3849'5ab5;
+    }
+
+    auto const tail = numBlocks * BLOCK_SIZE;
+    auto const tailSize = key.size() - tail;
+
+    std::uint64_t k1 = 0;
+    std::uint64_t k2 = 0;
+    for (auto i = tailSize; i > 8; --i)
+        k2 ^= tailByte(key, tail + i - 1) << (8 * (i - 9));
+    for (auto i = std::min<std::size_t>(tailSize, 8); i > 0; --i)
+        k1 ^= tailByte(key, tail + i - 1) << (8 * (i - 1));
+
+    if (tailSize > 8)
+        h2 ^= mixK2(k2);
+    if (tailSize > 0)
+        h1 ^= mixK1(k1);
+
+    h1 ^= key.size();
+    h2 ^= key.size();
+    h1 += h2;
+    h2 += h1;
+    h1 = finalMix(h1);
+    h2 = finalMix(h2);
+    h1 += h2;
+
+    auto const token = static_cast<std::int64_t>(h1);
+
+    // the minimum token is reserved by the partitioner
+    if (token == std::numeric_limits<std::int64_t>::min())
+        return std::numeric_limits<std::int64_t>::max();
+
+    return token;
+}
+
+std::vector<std::vector<ripple::uint256>>
+makeKeyBatches(std::vector<ripple::uint256> const& keys, std::size_t batchSize)
+{
+    ASSERT(batchSize > 0, "Batch size must be greater than 0");
+
+    std::vector<std::pair<std::int64_t, ripple::uint256>> tokens;
+    tokens.reserve(keys.size());
+    for (auto const& key : keys)
+        tokens.emplace_back(murmur3Token({key.data(), key.size()}), key);
+
+    std::ranges::sort(tokens);
+    auto const duplicates = std::ranges::unique(tokens);
+    tokens.erase(duplicates.begin(), duplicates.end());
+
+    std::vector<std::vector<ripple::uint256>> batches;
+    batches.reserve((tokens.size() + batchSize - 1) / batchSize);
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        if (i % batchSize == 0) {
+            batches.emplace_back();
+            batches.back().reserve(std::min(batchSize, tokens.size() - i));
+        }
+
+        batches.back().push_back(tokens[i].second);
+    }
+
+    return batches;
+}
+
+}  // namespace data::cassandra::impl
@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace data::cassandra::impl {
+
+/**
+ * @brief Calculate the token the Murmur3Partitioner assigns to a partition key.
+ *
+ * This matches the partitioner bit for bit, including the sign extension it applies to the trailing bytes of the key.
+ *
+ * @param key The serialized partition key
+ * @return The token of the partition
+ */
+[[nodiscard]] std::int64_t
+murmur3Token(std::span<std::uint8_t const> key);
+
+/**
+ * @brief Group keys into batches read with a single multi-key (IN) query each.
+ *
+ * Keys are ordered by token so every batch covers a contiguous range of the token ring and is served by as few
+ * replicas as possible. Duplicate keys are only read once.
+ *
+ * @param keys The partition keys to read
+ * @param batchSize The maximum number of keys in a batch
+ * @return The batches of unique keys
+ */
+[[nodiscard]] std::vector<std::vector<ripple::uint256>>
+makeKeyBatches(std::vector<ripple::uint256> const& keys, std::size_t batchSize);
+
+}  // namespace data::cassandra::impl
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/ReadConcurrencyLimiter.hpp"
+
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+namespace data::cassandra::impl {
+
+ReadConcurrencyLimiter::ReadConcurrencyLimiter(std::uint32_t maxLimit, std::uint32_t minLimit)
+    : minLimit_{std::min(minLimit, maxLimit)}
+    , maxLimit_{maxLimit}
+    , limit_{maxLimit}
+    , estimatedLimit_{static_cast<double>(maxLimit)}
+    , limitGauge_{PrometheusService::gaugeInt(
+          "backend_read_concurrency_limit",
+          util::prometheus::Labels(),
+          "The current maximum number of outstanding read requests"
+      )}
+    , queueingDelayGauge_{PrometheusService::gaugeInt(
+          "backend_read_queueing_delay_microseconds",
+          util::prometheus::Labels(),
+          "The estimated time reads spend queueing in the database, i.e. the recent read latency above its baseline"
+      )}
+{
+    limitGauge_.get().set(maxLimit_);
+}
+
+std::uint32_t
+ReadConcurrencyLimiter::limit() const
+{
+    return limit_;
+}
+
+bool
+ReadConcurrencyLimiter::isExhausted(std::uint32_t outstanding) const
+{
+    return outstanding >= limit_;
+}
+
+void
+ReadConcurrencyLimiter::addSample(std::chrono::steady_clock::duration latency, std::uint32_t outstanding)
+{
+    auto const sample = std::chrono::duration<double, std::micro>(latency).count();
+
+    std::scoped_lock const lock{mtx_};
+
+    if (longLatency_ == 0.) {
+        shortLatency_ = sample;
+        longLatency_ = sample;
+    } else {
+        shortLatency_ += (sample - shortLatency_) * SHORT_WINDOW_WEIGHT;
+        longLatency_ += (sample - longLatency_) * LONG_WINDOW_WEIGHT;
+    }
+
+    // the baseline only follows slowly; once the latency dropped well below it let it catch up faster
+    if (longLatency_ > 2 * shortLatency_)
+        longLatency_ *= 0.95;
+
+    queueingDelayGauge_.get().set(static_cast<std::int64_t>(std::max(shortLatency_ - longLatency_, 0.)));
+
+    if (shortLatency_ <= 0.)
+        return;
+
+    auto const gradient = std::clamp(LATENCY_TOLERANCE * longLatency_ / shortLatency_, 0.5, 1.);
+    auto const newLimit = estimatedLimit_ * gradient + std::sqrt(estimatedLimit_);
+
+    // there is no evidence more reads would be fine if the current limit is not even used
+    if (newLimit > estimatedLimit_ and outstanding < estimatedLimit_ / 2)
+        return;
+
+    estimatedLimit_ = std::clamp(
+        estimatedLimit_ * (1 - SMOOTHING) + newLimit * SMOOTHING,
+        static_cast<double>(minLimit_),
+        static_cast<double>(maxLimit_)
+    );
+
+    limit_ = static_cast<std::uint32_t>(std::lround(estimatedLimit_));
+    limitGauge_.get().set(limit_);
+}
+
+}  // namespace data::cassandra::impl
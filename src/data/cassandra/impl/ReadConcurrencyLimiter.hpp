@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Gauge.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace data::cassandra::impl {
+
+/**
+ * @brief Limits the number of outstanding read requests based on how the database responds.
+ *
+ * The limit follows the gradient between a short and a long moving average of the read latency: while the latency
+ * stays close to its long term baseline the limit grows, once requests start queueing up in the database the latency
+ * rises above the baseline and the limit shrinks proportionally. The limit only grows while the reads actually use at
+ * least half of it, so a quiet period does not leave a limit nothing has been tested against.
+ *
+ * @note This class is thread-safe.
+ */
+class ReadConcurrencyLimiter {
+public:
+    static constexpr std::uint32_t DEFAULT_MIN_LIMIT = 100;
+
+private:
+    // the average of the last few samples and the baseline over the last few hundred samples
+    static constexpr double SHORT_WINDOW_WEIGHT = 2. / (10 + 1);
+    static constexpr double LONG_WINDOW_WEIGHT = 2. / (600 + 1);
+
+    // the latency may exceed the baseline by this factor before the limit starts to shrink
+    static constexpr double LATENCY_TOLERANCE = 1.5;
+
+    // how much of a new estimate is applied at once
+    static constexpr double SMOOTHING = 0.2;
+
+    std::uint32_t minLimit_;
+    std::uint32_t maxLimit_;
+    std::atomic_uint32_t limit_;
+
+    std::mutex mtx_;
+    double estimatedLimit_;
+    double shortLatency_ = 0.;
+    double longLatency_ = 0.;
+
+    std::reference_wrapper<util::prometheus::GaugeInt> limitGauge_;
+    std::reference_wrapper<util::prometheus::GaugeInt> queueingDelayGauge_;
+
+public:
+    /**
+     * @brief Construct a new limiter starting at its maximum
+     *
+     * @param maxLimit The highest the limit can go
+     * @param minLimit The lowest the limit can go; capped by maxLimit
+     */
+    explicit ReadConcurrencyLimiter(std::uint32_t maxLimit, std::uint32_t minLimit = DEFAULT_MIN_LIMIT);
+
+    /**
+     * @return The current maximum number of outstanding read requests
+     */
+    [[nodiscard]] std::uint32_t
+    limit() const;
+
+    /**
+     * @brief Check whether another read would exceed the limit
+     *
+     * @param outstanding The number of read requests currently outstanding
+     * @return true if the limit is reached; false otherwise
+     */
+    [[nodiscard]] bool
+    isExhausted(std::uint32_t outstanding) const;
+
+    /**
+     * @brief Update the limit with the latency of a finished read
+     *
+     * @param latency The time it took the read to complete
+     * @param outstanding The number of read requests that were outstanding at the time, including this one
+     */
+    void
+    addSample(std::chrono::steady_clock::duration latency, std::uint32_t outstanding);
+};
+
+}  // namespace data::cassandra::impl
@@ -0,0 +1,264 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Histogram.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace data::cassandra::impl {
+
+/**
+ * @brief Get the partition key of a write from the values bound to its statement.
+ *
+ * Every insert in the schema binds the partition key first, so that is the only value looked at. Only integers and
+ * byte sequences (keys, hashes, account ids, blobs) are supported.
+ *
+ * @param value The first value bound to the statement
+ * @return The bytes identifying the partition; std::nullopt if the value can't be used as a partition key
+ */
+template <typename Type, typename... Rest>
+[[nodiscard]] std::optional<std::string>
+partitionKeyOf(Type const& value, Rest const&...)
+{
+    using DecayedType = std::decay_t<Type>;
+
+    if constexpr (std::is_integral_v<DecayedType>) {
+        auto const bytes = std::bit_cast<std::array<char, sizeof(DecayedType)>>(value);
+        return std::string{bytes.begin(), bytes.end()};
+    } else if constexpr (requires { requires sizeof(*std::begin(value)) == 1; }) {
+        return std::string{std::begin(value), std::end(value)};
+    } else {
+        return std::nullopt;
+    }
+}
+
+/**
+ * @brief A statement without bound values has no partition key to group by.
+ *
+ * @return std::nullopt
+ */
+[[nodiscard]] inline std::optional<std::string>
+partitionKeyOf()
+{
+    return std::nullopt;
+}
+
+/**
+ * @brief Identifies the writes that may share a batch: those of the same prepared statement to the same partition.
+ *
+ * Several tables use the same kind of partition key (e.g. a ledger sequence or an object key), so the partition key
+ * alone would put writes to different tables into one multi-partition batch.
+ */
+struct CoalescingKey {
+    void const* statement = nullptr;  // the prepared statement, and with it the table written to
+    std::string partition;
+
+    bool
+    operator==(CoalescingKey const&) const = default;
+};
+
+/**
+ * @brief Hash of a @ref CoalescingKey
+ */
+struct CoalescingKeyHash {
+    std::size_t
+    operator()(CoalescingKey const& key) const
+    {
+        auto const hash = std::hash<std::string>{}(key.partition);
+        return hash ^ (std::hash<void const*>{}(key.statement) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+    }
+};
+
+/**
+ * @brief Groups writes of the same statement to the same partition into batches.
+ *
+ * A batch is handed over as soon as it holds the maximum number of statements. Partially filled batches are handed
+ * over once the window that started with the first pending write has passed, so no write waits longer than that.
+ * Batches only ever contain statements for a single partition of a single table, which the database applies as a
+ * single mutation.
+ *
+ * @note This class is thread-safe.
+ *
+ * @tparam StatementType The type of the statements to group
+ */
+template <typename StatementType>
+class WriteCoalescer {
+public:
+    using FlushCallbackType = std::function<void(std::vector<StatementType>&&)>;
+
+private:
+    boost::asio::io_context& ioc_;
+    boost::asio::steady_timer timer_;
+
+    std::size_t maxBatchSize_;
+    std::chrono::steady_clock::duration window_;
+    FlushCallbackType onFlush_;
+
+    std::mutex mtx_;
+    std::unordered_map<CoalescingKey, std::vector<StatementType>, CoalescingKeyHash> pending_;
+    bool flushScheduled_ = false;
+
+    std::reference_wrapper<util::prometheus::HistogramDouble> fillRatio_;
+    std::reference_wrapper<util::prometheus::CounterInt> fullBatches_;
+    std::reference_wrapper<util::prometheus::CounterInt> windowBatches_;
+    std::reference_wrapper<util::prometheus::CounterInt> syncBatches_;
+
+public:
+    /**
+     * @brief Construct a new WriteCoalescer
+     *
+     * @param ioc The io_context the flush timer runs on
+     * @param maxBatchSize The maximum number of statements in a batch
+     * @param window The maximum time a write is held back
+     * @param onFlush Called with every batch that is ready to be executed
+     */
+    WriteCoalescer(
+        boost::asio::io_context& ioc,
+        std::size_t maxBatchSize,
+        std::chrono::steady_clock::duration window,
+        FlushCallbackType onFlush
+    )
+        : ioc_{ioc}
+        , timer_{ioc}
+        , maxBatchSize_{maxBatchSize}
+        , window_{window}
+        , onFlush_{std::move(onFlush)}
+        , fillRatio_{PrometheusService::histogramDouble(
+              "backend_write_batch_fill_ratio",
+              util::prometheus::Labels(),
+              {0.1, 0.25, 0.5, 0.75, 0.9, 1.},
+              "The number of statements in coalesced write batches relative to the maximum batch size"
+          )}
+        , fullBatches_{makeBatchCounter("full")}
+        , windowBatches_{makeBatchCounter("window")}
+        , syncBatches_{makeBatchCounter("sync")}
+    {
+    }
+
+    /**
+     * @brief Add a write to the batch of its statement and partition
+     *
+     * @param key The statement and the partition it writes to
+     * @param statement The statement to execute
+     */
+    void
+    add(CoalescingKey const& key, StatementType&& statement)
+    {
+        std::optional<std::vector<StatementType>> full;
+        {
+            std::scoped_lock const lock{mtx_};
+
+            auto& batch = pending_[key];
+            batch.push_back(std::move(statement));
+
+            if (batch.size() >= maxBatchSize_) {
+                full = std::move(batch);
+                pending_.erase(key);
+            } else if (not flushScheduled_) {
+                flushScheduled_ = true;
+                scheduleFlush();
+            }
+        }
+
+        if (full.has_value()) {
+            ++fullBatches_.get();
+            emit(std::move(*full));
+        }
+    }
+
+    /**
+     * @brief Hand over all pending batches right away
+     */
+    void
+    flush()
+    {
+        flushAll(syncBatches_);
+    }
+
+private:
+    static util::prometheus::CounterInt&
+    makeBatchCounter(std::string reason)
+    {
+        return PrometheusService::counterInt(
+            "backend_write_batches_total_number",
+            util::prometheus::Labels({util::prometheus::Label{"reason", std::move(reason)}}),
+            "The total number of coalesced write batches by the reason they were executed"
+        );
+    }
+
+    void
+    scheduleFlush()
+    {
+        // the timer is only ever touched from the io_context thread
+        boost::asio::post(ioc_, [this]() {
+            timer_.expires_after(window_);
+            timer_.async_wait([this](boost::system::error_code const& ec) {
+                if (not ec)
+                    flushAll(windowBatches_);
+            });
+        });
+    }
+
+    void
+    flushAll(util::prometheus::CounterInt& reason)
+    {
+        decltype(pending_) batches;
+        {
+            std::scoped_lock const lock{mtx_};
+            batches.swap(pending_);
+            flushScheduled_ = false;
+        }
+
+        for (auto& [_, batch] : batches) {
+            ++reason;
+            emit(std::move(batch));
+        }
+    }
+
+    void
+    emit(std::vector<StatementType>&& batch)
+    {
+        fillRatio_.get().observe(static_cast<double>(batch.size()) / static_cast<double>(maxBatchSize_));
+        onFlush_(std::move(batch));
+    }
+};
+
+}  // namespace data::cassandra::impl
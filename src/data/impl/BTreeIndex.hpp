@@ -0,0 +1,546 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief An ordered index implemented as a persistent (copy-on-write) B+tree.
+ *
+ * Keys of a node are stored contiguously so that a lookup touches a handful of cache lines per level instead of one
+ * heap node per key like std::map does. Values live next to the keys in the leaves.
+ *
+ * Nodes are shared between an index and the snapshots taken from it. Every node remembers the version of the index that
+ * created it and is only modified in place by that same version; any other node on the path of a modification is copied
+ * first. Taking a snapshot is therefore O(1) and a snapshot is never affected by later modifications of the index.
+ *
+ * @note Not thread safe; synchronization is the responsibility of the owner. A snapshot however can be read from any
+ * number of threads while the index it was taken from is being modified.
+ *
+ * @tparam KeyType The type of the key; must be totally ordered
+ * @tparam ValueType The type of the value; must be default constructible and copyable
+ * @tparam Capacity The maximum number of keys in a single node
+ */
+template <typename KeyType, typename ValueType, std::size_t Capacity = 64>
+class BTreeIndex {
+    static_assert(Capacity >= 4, "Capacity must be at least 4");
+
+    static constexpr std::size_t MERGE_THRESHOLD = Capacity / 4;
+
+    struct Node {
+        bool const isLeaf;
+        std::uint16_t count = 0;
+        std::uint64_t version = 0;
+        std::array<KeyType, Capacity> keys{};
+
+        explicit Node(bool leaf) : isLeaf{leaf}
+        {
+        }
+
+        Node(Node const&) = default;
+        virtual ~Node() = default;
+    };
+
+    struct Leaf : Node {
+        std::array<ValueType, Capacity> values{};
+
+        Leaf() : Node{true}
+        {
+        }
+    };
+
+    // keys[i] is a lower bound for all keys of children[i]; keys[0] is never used for routing
+    struct Inner : Node {
+        std::array<std::shared_ptr<Node>, Capacity> children{};
+
+        Inner() : Node{false}
+        {
+        }
+    };
+
+    using Split = std::optional<std::pair<KeyType, std::shared_ptr<Node>>>;
+    using Path = std::vector<std::pair<Inner const*, std::size_t>>;
+
+    std::uint64_t version_ = nextVersion();
+    std::shared_ptr<Node> root_ = makeNode<Leaf>();
+    std::size_t size_ = 0;
+
+public:
+    /** @brief A key and a reference to its value */
+    using Item = std::pair<KeyType const&, ValueType const&>;
+
+    BTreeIndex() = default;
+
+    // copies would share nodes with the same version; use snapshot() instead
+    BTreeIndex(BTreeIndex const&) = delete;
+    BTreeIndex&
+    operator=(BTreeIndex const&) = delete;
+
+    BTreeIndex(BTreeIndex&&) noexcept = default;
+    BTreeIndex&
+    operator=(BTreeIndex&&) noexcept = default;
+
+    /**
+     * @brief Take a snapshot of the index.
+     *
+     * The snapshot shares all nodes with this index. Nodes are copied lazily by whichever of the two is modified later.
+     *
+     * @return The snapshot
+     */
+    [[nodiscard]] BTreeIndex
+    snapshot()
+    {
+        version_ = nextVersion();
+        return BTreeIndex{root_, size_};
+    }
+
+    /**
+     * @brief Find the value for the given key.
+     *
+     * @param key The key to look for
+     * @return Pointer to the value if found; nullptr otherwise
+     */
+    [[nodiscard]] ValueType const*
+    find(KeyType const& key) const
+    {
+        auto const* leaf = findLeaf(key, nullptr);
+        auto const pos = std::lower_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count, key);
+        if (pos == leaf->keys.begin() + leaf->count or *pos != key)
+            return nullptr;
+
+        return &leaf->values[pos - leaf->keys.begin()];
+    }
+
+    /**
+     * @brief Find the first item with a key strictly greater than the given one.
+     *
+     * @param key The key to start from
+     * @return The item if found; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<Item>
+    successor(KeyType const& key) const
+    {
+        Path path;
+        auto const* leaf = findLeaf(key, &path);
+        auto const pos = std::upper_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count, key);
+        if (auto const idx = static_cast<std::size_t>(pos - leaf->keys.begin()); idx < leaf->count)
+            return Item{leaf->keys[idx], leaf->values[idx]};
+
+        while (not path.empty()) {
+            auto const [inner, idx] = path.back();
+            path.pop_back();
+
+            if (idx + 1 < inner->count) {
+                auto const* next = leftmostLeaf(inner->children[idx + 1].get());
+                return Item{next->keys[0], next->values[0]};
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Find the last item with a key strictly less than the given one.
+     *
+     * @param key The key to start from
+     * @return The item if found; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<Item>
+    predecessor(KeyType const& key) const
+    {
+        Path path;
+        auto const* leaf = findLeaf(key, &path);
+        auto const pos = std::lower_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count, key);
+        if (auto const idx = static_cast<std::size_t>(pos - leaf->keys.begin()); idx > 0)
+            return Item{leaf->keys[idx - 1], leaf->values[idx - 1]};
+
+        while (not path.empty()) {
+            auto const [inner, idx] = path.back();
+            path.pop_back();
+
+            if (idx > 0) {
+                auto const* prev = rightmostLeaf(inner->children[idx - 1].get());
+                return Item{prev->keys[prev->count - 1], prev->values[prev->count - 1]};
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Get the value for the given key, inserting a default constructed one if it does not exist.
+     *
+     * @param key The key to look for
+     * @return Reference to the value (valid until the next modification) and whether it was inserted
+     */
+    std::pair<ValueType&, bool>
+    emplace(KeyType const& key)
+    {
+        ValueType* value = nullptr;
+        bool inserted = false;
+
+        if (auto split = insert(root_, key, value, inserted); split.has_value()) {
+            auto newRoot = makeNode<Inner>();
+            newRoot->keys[0] = root_->keys[0];
+            newRoot->children[0] = std::move(root_);
+            newRoot->keys[1] = std::move(split->first);
+            newRoot->children[1] = std::move(split->second);
+            newRoot->count = 2;
+            root_ = std::move(newRoot);
+        }
+
+        if (inserted)
+            ++size_;
+
+        return {*value, inserted};
+    }
+
+    /**
+     * @brief Remove the given key from the index.
+     *
+     * @param key The key to remove
+     * @return The value that was removed if the key was found; nullopt otherwise
+     */
+    std::optional<ValueType>
+    erase(KeyType const& key)
+    {
+        // check first so that a miss does not copy any shared nodes
+        if (find(key) == nullptr)
+            return std::nullopt;
+
+        auto removed = erase(root_, key);
+        --size_;
+
+        // shrink the tree from the top once the root is left with a single child
+        while (not root_->isLeaf and root_->count <= 1) {
+            auto const& inner = static_cast<Inner const&>(*root_);
+            if (inner.count == 1) {
+                root_ = inner.children[0];
+            } else {
+                root_ = makeNode<Leaf>();
+            }
+        }
+
+        return removed;
+    }
+
+    /**
+     * @brief Invoke a function on every item in key order.
+     *
+     * @param fn The function to call with the key and the value
+     */
+    void
+    forEach(std::function<void(KeyType const&, ValueType const&)> const& fn) const
+    {
+        forEach(*root_, fn);
+    }
+
+    /** @return The number of items in the index */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** @return true if the index is empty; false otherwise */
+    [[nodiscard]] bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+private:
+    BTreeIndex(std::shared_ptr<Node> root, std::size_t size) : root_{std::move(root)}, size_{size}
+    {
+    }
+
+    static std::uint64_t
+    nextVersion()
+    {
+        static std::atomic_uint64_t counter = 0;
+        return ++counter;
+    }
+
+    template <typename NodeType>
+    std::shared_ptr<NodeType>
+    makeNode() const
+    {
+        auto node = std::make_shared<NodeType>();
+        node->version = version_;
+        return node;
+    }
+
+    // Makes the node owned by this version of the index, copying it if it is shared with a snapshot
+    Node&
+    own(std::shared_ptr<Node>& node) const
+    {
+        if (node->version != version_) {
+            if (node->isLeaf) {
+                node = std::make_shared<Leaf>(static_cast<Leaf const&>(*node));
+            } else {
+                node = std::make_shared<Inner>(static_cast<Inner const&>(*node));
+            }
+            node->version = version_;
+        }
+
+        return *node;
+    }
+
+    static std::size_t
+    childIndex(Inner const& inner, KeyType const& key)
+    {
+        auto const begin = inner.keys.begin() + 1;
+        return static_cast<std::size_t>(std::upper_bound(begin, inner.keys.begin() + inner.count, key) - begin);
+    }
+
+    Leaf const*
+    findLeaf(KeyType const& key, Path* path) const
+    {
+        Node const* node = root_.get();
+        while (not node->isLeaf) {
+            auto const& inner = static_cast<Inner const&>(*node);
+            auto const idx = childIndex(inner, key);
+            if (path != nullptr)
+                path->emplace_back(&inner, idx);
+
+            node = inner.children[idx].get();
+        }
+
+        return static_cast<Leaf const*>(node);
+    }
+
+    static Leaf const*
+    leftmostLeaf(Node const* node)
+    {
+        while (not node->isLeaf)
+            node = static_cast<Inner const*>(node)->children[0].get();
+
+        return static_cast<Leaf const*>(node);
+    }
+
+    static Leaf const*
+    rightmostLeaf(Node const* node)
+    {
+        while (not node->isLeaf) {
+            auto const* inner = static_cast<Inner const*>(node);
+            node = inner->children[inner->count - 1].get();
+        }
+
+        return static_cast<Leaf const*>(node);
+    }
+
+    template <typename Array>
+    static void
+    shiftRight(Array& arr, std::size_t from, std::size_t count)
+    {
+        std::move_backward(arr.begin() + from, arr.begin() + count, arr.begin() + count + 1);
+    }
+
+    template <typename Array>
+    static void
+    shiftLeft(Array& arr, std::size_t from, std::size_t count)
+    {
+        std::move(arr.begin() + from + 1, arr.begin() + count, arr.begin() + from);
+    }
+
+    Split
+    insert(std::shared_ptr<Node>& nodePtr, KeyType const& key, ValueType*& value, bool& inserted) const
+    {
+        auto& node = own(nodePtr);
+        if (node.isLeaf)
+            return insertIntoLeaf(static_cast<Leaf&>(node), key, value, inserted);
+
+        auto& inner = static_cast<Inner&>(node);
+        auto const idx = childIndex(inner, key);
+        auto split = insert(inner.children[idx], key, value, inserted);
+        if (not split.has_value())
+            return std::nullopt;
+
+        // the value pointer stays valid because only the child's sibling is created here
+        auto const pos = idx + 1;
+        if (inner.count < Capacity) {
+            shiftRight(inner.keys, pos, inner.count);
+            shiftRight(inner.children, pos, inner.count);
+            inner.keys[pos] = std::move(split->first);
+            inner.children[pos] = std::move(split->second);
+            ++inner.count;
+            return std::nullopt;
+        }
+
+        auto right = makeNode<Inner>();
+        auto const half = Capacity / 2;
+        std::move(inner.keys.begin() + half, inner.keys.end(), right->keys.begin());
+        std::move(inner.children.begin() + half, inner.children.end(), right->children.begin());
+        right->count = static_cast<std::uint16_t>(Capacity - half);
+        inner.count = static_cast<std::uint16_t>(half);
+
+        auto& target = pos <= half ? inner : *right;
+        auto const targetPos = pos <= half ? pos : pos - half;
+        shiftRight(target.keys, targetPos, target.count);
+        shiftRight(target.children, targetPos, target.count);
+        target.keys[targetPos] = std::move(split->first);
+        target.children[targetPos] = std::move(split->second);
+        ++target.count;
+
+        auto separator = right->keys[0];
+        return std::make_pair(std::move(separator), std::shared_ptr<Node>{std::move(right)});
+    }
+
+    Split
+    insertIntoLeaf(Leaf& leaf, KeyType const& key, ValueType*& value, bool& inserted) const
+    {
+        auto const it = std::lower_bound(leaf.keys.begin(), leaf.keys.begin() + leaf.count, key);
+        auto const pos = static_cast<std::size_t>(it - leaf.keys.begin());
+        if (pos < leaf.count and leaf.keys[pos] == key) {
+            value = &leaf.values[pos];
+            return std::nullopt;
+        }
+
+        inserted = true;
+        if (leaf.count < Capacity) {
+            shiftRight(leaf.keys, pos, leaf.count);
+            shiftRight(leaf.values, pos, leaf.count);
+            leaf.keys[pos] = key;
+            leaf.values[pos] = ValueType{};
+            ++leaf.count;
+            value = &leaf.values[pos];
+            return std::nullopt;
+        }
+
+        auto right = makeNode<Leaf>();
+        auto const half = Capacity / 2;
+        std::move(leaf.keys.begin() + half, leaf.keys.end(), right->keys.begin());
+        std::move(leaf.values.begin() + half, leaf.values.end(), right->values.begin());
+        right->count = static_cast<std::uint16_t>(Capacity - half);
+        leaf.count = static_cast<std::uint16_t>(half);
+
+        auto& target = pos <= half ? leaf : *right;
+        auto const targetPos = pos <= half ? pos : pos - half;
+        shiftRight(target.keys, targetPos, target.count);
+        shiftRight(target.values, targetPos, target.count);
+        target.keys[targetPos] = key;
+        target.values[targetPos] = ValueType{};
+        ++target.count;
+        value = &target.values[targetPos];
+
+        auto separator = right->keys[0];
+        return std::make_pair(std::move(separator), std::shared_ptr<Node>{std::move(right)});
+    }
+
+    // only called for keys that are known to exist
+    ValueType
+    erase(std::shared_ptr<Node>& nodePtr, KeyType const& key) const
+    {
+        auto& node = own(nodePtr);
+        if (node.isLeaf) {
+            auto& leaf = static_cast<Leaf&>(node);
+            auto const it = std::lower_bound(leaf.keys.begin(), leaf.keys.begin() + leaf.count, key);
+            auto const pos = static_cast<std::size_t>(it - leaf.keys.begin());
+
+            auto removed = std::move(leaf.values[pos]);
+            shiftLeft(leaf.keys, pos, leaf.count);
+            shiftLeft(leaf.values, pos, leaf.count);
+            --leaf.count;
+            return removed;
+        }
+
+        auto& inner = static_cast<Inner&>(node);
+        auto const idx = childIndex(inner, key);
+        auto removed = erase(inner.children[idx], key);
+        if (inner.children[idx]->count < MERGE_THRESHOLD)
+            rebalance(inner, idx);
+
+        return removed;
+    }
+
+    // Merges an underfull child into its neighbour when both fit into one node. Children never stay empty.
+    void
+    rebalance(Inner& parent, std::size_t idx) const
+    {
+        if (parent.children[idx]->count == 0) {
+            removeChild(parent, idx);
+            return;
+        }
+
+        if (parent.count < 2)
+            return;
+
+        auto const left = idx + 1 < parent.count ? idx : idx - 1;
+        if (parent.children[left]->count + parent.children[left + 1]->count > Capacity)
+            return;
+
+        auto& leftNode = own(parent.children[left]);
+        auto const& rightNode = *parent.children[left + 1];
+
+        auto const offset = leftNode.count;
+        std::copy(rightNode.keys.begin(), rightNode.keys.begin() + rightNode.count, leftNode.keys.begin() + offset);
+        if (leftNode.isLeaf) {
+            auto const& from = static_cast<Leaf const&>(rightNode);
+            auto& to = static_cast<Leaf&>(leftNode);
+            std::copy(from.values.begin(), from.values.begin() + from.count, to.values.begin() + offset);
+        } else {
+            auto const& from = static_cast<Inner const&>(rightNode);
+            auto& to = static_cast<Inner&>(leftNode);
+            // the first key of an inner node is not maintained so take the separator from the parent instead
+            to.keys[offset] = parent.keys[left + 1];
+            std::copy(from.children.begin(), from.children.begin() + from.count, to.children.begin() + offset);
+        }
+
+        leftNode.count = static_cast<std::uint16_t>(leftNode.count + rightNode.count);
+        removeChild(parent, left + 1);
+    }
+
+    static void
+    removeChild(Inner& parent, std::size_t idx)
+    {
+        shiftLeft(parent.keys, idx, parent.count);
+        shiftLeft(parent.children, idx, parent.count);
+        parent.children[parent.count - 1].reset();
+        --parent.count;
+    }
+
+    static void
+    forEach(Node const& node, std::function<void(KeyType const&, ValueType const&)> const& fn)
+    {
+        if (node.isLeaf) {
+            auto const& leaf = static_cast<Leaf const&>(node);
+            for (std::size_t i = 0; i < leaf.count; ++i)
+                fn(leaf.keys[i], leaf.values[i]);
+            return;
+        }
+
+        auto const& inner = static_cast<Inner const&>(node);
+        for (std::size_t i = 0; i < inner.count; ++i)
+            forEach(*inner.children[i], fn);
+    }
+};
+
+}  // namespace data::impl
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BlobArena.hpp"
+
+#include "util/Assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace data::impl {
+
+namespace {
+
+// every slot starts with the size of the blob it holds
+using SizeHeader = std::uint32_t;
+
+SizeHeader
+readHeader(unsigned char const* slot)
+{
+    SizeHeader size = 0;
+    std::memcpy(&size, slot, sizeof(SizeHeader));
+    return size;
+}
+
+}  // namespace
+
+std::span<unsigned char const>
+BlobArena::Handle::bytes() const
+{
+    if (slot_ == nullptr)
+        return {};
+
+    return {slot_ + sizeof(SizeHeader), readHeader(slot_)};
+}
+
+std::size_t
+BlobArena::slotSize(std::size_t blobSize)
+{
+    auto const total = blobSize + sizeof(SizeHeader);
+    return (total + CLASS_GRANULARITY - 1) / CLASS_GRANULARITY * CLASS_GRANULARITY;
+}
+
+BlobArena::Handle
+BlobArena::store(std::span<unsigned char const> bytes)
+{
+    ASSERT(bytes.size() <= UINT32_MAX, "Blob is too large to be stored in the arena: {}", bytes.size());
+
+    auto const size = slotSize(bytes.size());
+    unsigned char* slot = nullptr;
+
+    if (size > MAX_CLASS_SIZE) {
+        auto memory = std::make_unique<unsigned char[]>(size);
+        slot = memory.get();
+        oversized_.emplace(slot, std::move(memory));
+        reservedBytes_ += size;
+    } else if (auto& freeList = freeLists_[(size / CLASS_GRANULARITY) - 1]; not freeList.empty()) {
+        slot = freeList.back();
+        freeList.pop_back();
+    } else {
+        if (chunks_.empty() or chunks_.back().used + size > CHUNK_SIZE) {
+            chunks_.push_back({std::make_unique<unsigned char[]>(CHUNK_SIZE), 0});
+            reservedBytes_ += CHUNK_SIZE;
+        }
+
+        auto& chunk = chunks_.back();
+        slot = chunk.memory.get() + chunk.used;
+        chunk.used += size;
+    }
+
+    auto const header = static_cast<SizeHeader>(bytes.size());
+    std::memcpy(slot, &header, sizeof(SizeHeader));
+    std::ranges::copy(bytes, slot + sizeof(SizeHeader));
+    usedBytes_ += size;
+
+    return Handle{slot};
+}
+
+void
+BlobArena::release(Handle handle)
+{
+    if (not handle.isValid())
+        return;
+
+    auto const size = slotSize(readHeader(handle.slot_));
+    usedBytes_ -= size;
+
+    if (size > MAX_CLASS_SIZE) {
+        oversized_.erase(handle.slot_);
+        reservedBytes_ -= size;
+        return;
+    }
+
+    freeLists_[(size / CLASS_GRANULARITY) - 1].push_back(handle.slot_);
+}
+
+std::size_t
+BlobArena::reservedBytes() const
+{
+    return reservedBytes_;
+}
+
+std::size_t
+BlobArena::usedBytes() const
+{
+    return usedBytes_;
+}
+
+}  // namespace data::impl
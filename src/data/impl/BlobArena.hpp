@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Slab allocator for immutable blobs.
+ *
+ * Blobs are rounded up to a size class and carved out of large chunks. Released slots go to a per-class free list and
+ * are reused by later blobs of the same class, so a long running cache does not fragment the general purpose heap.
+ * Blobs larger than the biggest size class get their own allocation.
+ *
+ * @note Not thread safe; synchronization is the responsibility of the owner.
+ */
+class BlobArena {
+public:
+    /**
+     * @brief Reference to a blob stored in the arena.
+     *
+     * A handle is only valid until it is released. Copying a handle does not copy the blob.
+     */
+    class Handle {
+        friend class BlobArena;
+        unsigned char* slot_ = nullptr;
+
+        explicit Handle(unsigned char* slot) : slot_{slot}
+        {
+        }
+
+    public:
+        Handle() = default;
+
+        /** @return The stored bytes */
+        [[nodiscard]] std::span<unsigned char const>
+        bytes() const;
+
+        /** @return true if the handle refers to a blob; false otherwise */
+        [[nodiscard]] bool
+        isValid() const
+        {
+            return slot_ != nullptr;
+        }
+
+        bool
+        operator==(Handle const&) const = default;
+    };
+
+    static constexpr std::size_t CLASS_GRANULARITY = 16;
+    static constexpr std::size_t MAX_CLASS_SIZE = 4096;
+    static constexpr std::size_t CHUNK_SIZE = 1024 * 1024;
+
+    BlobArena() = default;
+
+    BlobArena(BlobArena const&) = delete;
+    BlobArena&
+    operator=(BlobArena const&) = delete;
+
+    /**
+     * @brief Copy the given bytes into the arena.
+     *
+     * @param bytes The bytes to store
+     * @return Handle to the stored copy
+     */
+    [[nodiscard]] Handle
+    store(std::span<unsigned char const> bytes);
+
+    /**
+     * @brief Give the slot of a blob back to the arena.
+     *
+     * @param handle The handle to release; becomes invalid after this call
+     */
+    void
+    release(Handle handle);
+
+    /** @return Number of bytes requested from the system, including free slots */
+    [[nodiscard]] std::size_t
+    reservedBytes() const;
+
+    /** @return Number of bytes occupied by live blobs, including per-blob overhead */
+    [[nodiscard]] std::size_t
+    usedBytes() const;
+
+private:
+    static constexpr std::size_t NUM_CLASSES = MAX_CLASS_SIZE / CLASS_GRANULARITY;
+
+    struct Chunk {
+        std::unique_ptr<unsigned char[]> memory;
+        std::size_t used = 0;
+    };
+
+    static std::size_t
+    slotSize(std::size_t blobSize);
+
+    std::vector<Chunk> chunks_;
+    std::array<std::vector<unsigned char*>, NUM_CLASSES> freeLists_;
+    std::unordered_map<unsigned char*, std::unique_ptr<unsigned char[]>> oversized_;
+    std::size_t reservedBytes_ = 0;
+    std::size_t usedBytes_ = 0;
+};
+
+}  // namespace data::impl
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BlobCodec.hpp"
+
+#include "data/Types.hpp"
+#include "util/Assert.hpp"
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace data::impl {
+
+namespace {
+
+struct CCtxDeleter {
+    void
+    operator()(ZSTD_CCtx* ctx) const
+    {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct DCtxDeleter {
+    void
+    operator()(ZSTD_DCtx* ctx) const
+    {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+ZSTD_CCtx*
+compressionContext()
+{
+    thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> const ctx{ZSTD_createCCtx()};
+    return ctx.get();
+}
+
+ZSTD_DCtx*
+decompressionContext()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> const ctx{ZSTD_createDCtx()};
+    return ctx.get();
+}
+
+}  // namespace
+
+void
+BlobCodec::CDictDeleter::operator()(ZSTD_CDict_s* dict) const
+{
+    ZSTD_freeCDict(dict);
+}
+
+void
+BlobCodec::DDictDeleter::operator()(ZSTD_DDict_s* dict) const
+{
+    ZSTD_freeDDict(dict);
+}
+
+BlobCodec::BlobCodec(std::span<unsigned char const> dictionary)
+    : cdict_{ZSTD_createCDict(dictionary.data(), dictionary.size(), COMPRESSION_LEVEL)}
+    , ddict_{ZSTD_createDDict(dictionary.data(), dictionary.size())}
+{
+    ASSERT(cdict_ != nullptr and ddict_ != nullptr, "Could not load zstd dictionary");
+}
+
+std::shared_ptr<BlobCodec const>
+BlobCodec::train(std::span<unsigned char const> samples, std::span<std::size_t const> sampleSizes)
+{
+    std::vector<unsigned char> dictionary(DICTIONARY_SIZE);
+    auto const size = ZDICT_trainFromBuffer(
+        dictionary.data(),
+        dictionary.size(),
+        samples.data(),
+        sampleSizes.data(),
+        static_cast<unsigned>(sampleSizes.size())
+    );
+    if (ZDICT_isError(size) != 0u)
+        return nullptr;
+
+    dictionary.resize(size);
+    return std::make_shared<BlobCodec const>(dictionary);
+}
+
+std::optional<Blob>
+BlobCodec::compress(std::span<unsigned char const> bytes) const
+{
+    Blob compressed(ZSTD_compressBound(bytes.size()));
+    auto const size = ZSTD_compress_usingCDict(
+        compressionContext(), compressed.data(), compressed.size(), bytes.data(), bytes.size(), cdict_.get()
+    );
+    if (ZSTD_isError(size) != 0u or size >= bytes.size())
+        return std::nullopt;
+
+    compressed.resize(size);
+    return compressed;
+}
+
+Blob
+BlobCodec::decompress(std::span<unsigned char const> bytes) const
+{
+    auto const originalSize = ZSTD_getFrameContentSize(bytes.data(), bytes.size());
+    ASSERT(
+        originalSize != ZSTD_CONTENTSIZE_ERROR and originalSize != ZSTD_CONTENTSIZE_UNKNOWN,
+        "Compressed blob has no valid zstd frame header"
+    );
+
+    Blob blob(originalSize);
+    auto const size = ZSTD_decompress_usingDDict(
+        decompressionContext(), blob.data(), blob.size(), bytes.data(), bytes.size(), ddict_.get()
+    );
+    ASSERT(ZSTD_isError(size) == 0u and size == blob.size(), "Could not decompress blob: {}", ZSTD_getErrorName(size));
+
+    return blob;
+}
+
+}  // namespace data::impl
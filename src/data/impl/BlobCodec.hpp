@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace data::impl {
+
+/**
+ * @brief Compresses ledger object blobs with a zstd dictionary trained on a sample of them.
+ *
+ * Serialized ledger objects are small and compress poorly on their own, but they share field headers, account IDs,
+ * currency codes and the like. A dictionary captures those once so that every blob only stores what is unique to it.
+ *
+ * Compression and decompression are thread safe; every thread uses its own zstd context.
+ */
+class BlobCodec {
+    struct CDictDeleter {
+        void
+        operator()(ZSTD_CDict_s* dict) const;
+    };
+
+    struct DDictDeleter {
+        void
+        operator()(ZSTD_DDict_s* dict) const;
+    };
+
+    std::unique_ptr<ZSTD_CDict_s, CDictDeleter> cdict_;
+    std::unique_ptr<ZSTD_DDict_s, DDictDeleter> ddict_;
+
+public:
+    static constexpr std::size_t DICTIONARY_SIZE = 64 * 1024;
+    static constexpr int COMPRESSION_LEVEL = 3;
+
+    /**
+     * @brief Create a codec using the given dictionary.
+     *
+     * @param dictionary The zstd dictionary
+     */
+    explicit BlobCodec(std::span<unsigned char const> dictionary);
+
+    /**
+     * @brief Train a dictionary on the given samples and create a codec using it.
+     *
+     * @param samples All samples, concatenated
+     * @param sampleSizes The size of each sample
+     * @return The codec; nullptr if no dictionary could be trained, e.g. because there are not enough samples
+     */
+    [[nodiscard]] static std::shared_ptr<BlobCodec const>
+    train(std::span<unsigned char const> samples, std::span<std::size_t const> sampleSizes);
+
+    /**
+     * @brief Compress a blob.
+     *
+     * @param bytes The blob to compress
+     * @return The compressed blob; nullopt if it would not be smaller than the original
+     */
+    [[nodiscard]] std::optional<Blob>
+    compress(std::span<unsigned char const> bytes) const;
+
+    /**
+     * @brief Decompress a blob that was compressed by this codec.
+     *
+     * @param bytes The compressed blob
+     * @return The original blob
+     */
+    [[nodiscard]] Blob
+    decompress(std::span<unsigned char const> bytes) const;
+};
+
+}  // namespace data::impl
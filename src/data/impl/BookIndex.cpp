@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BookIndex.hpp"
+
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+void
+BookIndex::update(std::vector<std::reference_wrapper<LedgerObject const>> const& objs, std::uint32_t seq)
+{
+    // parse the directories before taking the lock so that readers are only blocked while the pages are swapped in
+    std::vector<std::pair<ripple::uint256, std::optional<Page>>> changes;
+    changes.reserve(objs.size());
+
+    for (LedgerObject const& obj : objs) {
+        if (obj.blob.empty()) {
+            changes.emplace_back(obj.key, std::nullopt);
+            continue;
+        }
+
+        // the type of an object is in its first bytes
+        if (obj.blob.size() < 3u or not isDirNode(obj.blob))
+            continue;
+
+        ripple::STLedgerEntry const sle{ripple::SerialIter{obj.blob.data(), obj.blob.size()}, obj.key};
+        // owner and NFT offer directories have no exchange rate or currencies
+        if (not sle.isFieldPresent(ripple::sfExchangeRate) or not sle.isFieldPresent(ripple::sfTakerPaysCurrency))
+            continue;
+
+        auto const& offers = sle.getFieldV256(ripple::sfIndexes);
+        changes.emplace_back(
+            obj.key,
+            Page{
+                .root = sle.getFieldH256(ripple::sfRootIndex),
+                .offers = std::vector<ripple::uint256>(offers.begin(), offers.end()),
+                .next = sle.getFieldU64(ripple::sfIndexNext)
+            }
+        );
+    }
+
+    auto state = state_.lock();
+    state->seq = seq;
+
+    for (auto& [key, newPage] : changes) {
+        if (not newPage.has_value()) {
+            auto const page = state->pages.find(key);
+            if (page == state->pages.end())
+                continue;
+
+            if (auto const book = state->books.find(getBookBase(key));
+                page->second.root == key and book != state->books.end()) {
+                book->second.erase(key);
+                if (book->second.empty())
+                    state->books.erase(book);
+            }
+            state->pages.erase(page);
+            continue;
+        }
+
+        if (newPage->root == key)
+            state->books[getBookBase(key)].insert(key);
+
+        state->pages[key] = std::move(*newPage);
+    }
+}
+
+std::optional<std::vector<ripple::uint256>>
+BookIndex::getOffers(ripple::uint256 const& book, std::uint32_t seq, std::size_t limit) const
+{
+    auto const state = state_.lock<std::shared_lock>();
+    if (seq != state->seq)
+        return std::nullopt;
+
+    std::vector<ripple::uint256> offers;
+    auto const directories = state->books.find(book);
+    if (directories == state->books.end())
+        return offers;
+
+    for (auto const& root : directories->second) {
+        auto key = root;
+        while (offers.size() < limit) {
+            auto const page = state->pages.find(key);
+            // a missing page means the index is incomplete; let the caller fall back to the database
+            if (page == state->pages.end())
+                return std::nullopt;
+
+            offers.insert(offers.end(), page->second.offers.begin(), page->second.offers.end());
+            if (page->second.next == 0u)
+                break;
+
+            key = ripple::keylet::page(root, page->second.next).key;
+        }
+
+        if (offers.size() >= limit)
+            break;
+    }
+
+    return offers;
+}
+
+std::size_t
+BookIndex::numBooks() const
+{
+    return state_.lock<std::shared_lock>()->books.size();
+}
+
+}  // namespace data::impl
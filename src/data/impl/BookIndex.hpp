@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "util/Mutex.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Index of the order books of the latest ledger.
+ *
+ * Holds the pages of every book directory along with the quality directories of each book, so the best offers of a
+ * book are listed without walking the successor table. It is kept in step with the objects applied to the cache.
+ *
+ * @note This class is thread-safe.
+ */
+class BookIndex {
+    struct Page {
+        ripple::uint256 root;
+        std::vector<ripple::uint256> offers;
+        std::uint64_t next = 0;
+    };
+
+    struct State {
+        std::uint32_t seq = 0;
+        std::unordered_map<ripple::uint256, Page, ripple::hardened_hash<>> pages;
+
+        // the quality directories of each book by book base; ordered by key, which is the order of quality
+        std::unordered_map<ripple::uint256, std::set<ripple::uint256>, ripple::hardened_hash<>> books;
+    };
+
+    util::Mutex<State, std::shared_mutex> state_;
+
+public:
+    /**
+     * @brief Apply the objects changed by a ledger.
+     *
+     * Objects that are not book directories, including owner and NFT offer directories, are ignored. An object with
+     * an empty blob was deleted.
+     *
+     * @param objs The changed objects
+     * @param seq The sequence of the latest ledger after the change
+     */
+    void
+    update(std::vector<std::reference_wrapper<LedgerObject const>> const& objs, std::uint32_t seq);
+
+    /**
+     * @brief Get the keys of the best offers of a book.
+     *
+     * Whole directory pages are returned, stopping at the end of the page that reaches the limit, the same way the
+     * directories are walked in the database.
+     *
+     * @param book The book base of the book
+     * @param seq The sequence of the ledger to get the offers for
+     * @param limit The number of offers after which no further page is read
+     * @return The offer keys, best quality first; std::nullopt if the ledger is not the indexed one
+     */
+    [[nodiscard]] std::optional<std::vector<ripple::uint256>>
+    getOffers(ripple::uint256 const& book, std::uint32_t seq, std::size_t limit) const;
+
+    /** @return The number of books with at least one offer */
+    [[nodiscard]] std::size_t
+    numBooks() const;
+};
+
+}  // namespace data::impl
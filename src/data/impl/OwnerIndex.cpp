@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/OwnerIndex.hpp"
+
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+void
+OwnerIndex::update(std::vector<std::reference_wrapper<LedgerObject const>> const& objs, std::uint32_t seq)
+{
+    // parse the directories before taking the lock so that readers are only blocked while the pages are swapped in
+    std::vector<std::pair<ripple::uint256, std::optional<Entry>>> changes;
+    changes.reserve(objs.size());
+
+    for (LedgerObject const& obj : objs) {
+        if (obj.blob.empty()) {
+            changes.emplace_back(obj.key, std::nullopt);
+            continue;
+        }
+
+        // the type of an object is in its first bytes
+        if (obj.blob.size() < 3u or not isDirNode(obj.blob))
+            continue;
+
+        ripple::STLedgerEntry const sle{ripple::SerialIter{obj.blob.data(), obj.blob.size()}, obj.key};
+        if (not sle[~ripple::sfOwner].has_value())
+            continue;
+
+        auto const& entries = sle.getFieldV256(ripple::sfIndexes);
+        changes.emplace_back(
+            obj.key,
+            Entry{
+                .entries = std::vector<ripple::uint256>(entries.begin(), entries.end()),
+                .next = sle.getFieldU64(ripple::sfIndexNext)
+            }
+        );
+    }
+
+    auto state = state_.lock();
+    state->seq = seq;
+
+    for (auto& [key, entry] : changes) {
+        if (entry.has_value()) {
+            state->pages[key] = std::move(*entry);
+        } else {
+            state->pages.erase(key);
+        }
+    }
+}
+
+std::optional<std::vector<OwnerIndex::Page>>
+OwnerIndex::getPages(
+    ripple::uint256 const& root,
+    std::uint64_t startPage,
+    std::uint32_t seq,
+    std::size_t minEntries
+) const
+{
+    auto const state = state_.lock<std::shared_lock>();
+    if (seq != state->seq)
+        return std::nullopt;
+
+    std::vector<Page> pages;
+    std::size_t numEntries = 0;
+    for (auto number = startPage;;) {
+        auto const page = state->pages.find(ripple::keylet::page(root, number).key);
+        if (page == state->pages.end()) {
+            // a missing page other than the first means the index is incomplete; let the caller use the database
+            if (pages.empty())
+                break;
+            return std::nullopt;
+        }
+
+        pages.push_back({.number = number, .entries = page->second.entries});
+        numEntries += page->second.entries.size();
+        if (page->second.next == 0u or numEntries >= minEntries)
+            break;
+
+        number = page->second.next;
+    }
+
+    return pages;
+}
+
+std::size_t
+OwnerIndex::numPages() const
+{
+    return state_.lock<std::shared_lock>()->pages.size();
+}
+
+}  // namespace data::impl
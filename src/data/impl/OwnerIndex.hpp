@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "util/Mutex.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Index of the owner directories of the latest ledger.
+ *
+ * Holds the entries of every owner directory page, so the objects owned by an account are listed without reading and
+ * parsing the directory pages one by one. It is kept in step with the objects applied to the cache.
+ *
+ * @note This class is thread-safe.
+ */
+class OwnerIndex {
+public:
+    /** @brief A page of an owner directory */
+    struct Page {
+        std::uint64_t number = 0;
+        std::vector<ripple::uint256> entries;
+
+        bool
+        operator==(Page const&) const = default;
+    };
+
+private:
+    struct Entry {
+        std::vector<ripple::uint256> entries;
+        std::uint64_t next = 0;
+    };
+
+    struct State {
+        std::uint32_t seq = 0;
+        std::unordered_map<ripple::uint256, Entry, ripple::hardened_hash<>> pages;
+    };
+
+    util::Mutex<State, std::shared_mutex> state_;
+
+public:
+    /**
+     * @brief Apply the objects changed by a ledger.
+     *
+     * Objects that are not owner directories are ignored. An object with an empty blob was deleted.
+     *
+     * @param objs The changed objects
+     * @param seq The sequence of the latest ledger after the change
+     */
+    void
+    update(std::vector<std::reference_wrapper<LedgerObject const>> const& objs, std::uint32_t seq);
+
+    /**
+     * @brief Get the pages of an owner directory.
+     *
+     * Pages are returned in the order they are linked, starting at the given one, until they hold at least the given
+     * number of entries.
+     *
+     * @param root The key of the owner directory
+     * @param startPage The number of the first page to return
+     * @param seq The sequence of the ledger to get the pages for
+     * @param minEntries The number of entries after which no more pages are returned
+     * @return The pages, empty if the first page does not exist; std::nullopt if the ledger is not the indexed one
+     */
+    [[nodiscard]] std::optional<std::vector<Page>>
+    getPages(ripple::uint256 const& root, std::uint64_t startPage, std::uint32_t seq, std::size_t minEntries) const;
+
+    /** @return The number of indexed directory pages */
+    [[nodiscard]] std::size_t
+    numPages() const;
+};
+
+}  // namespace data::impl
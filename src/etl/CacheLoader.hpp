@@ -20,6 +20,7 @@
 #pragma once
 
 #include "data/BackendInterface.hpp"
+#include "data/LedgerCacheFile.hpp"
 #include "etl/CacheLoaderSettings.hpp"
 #include "etl/impl/CacheLoader.hpp"
 #include "etl/impl/CursorFromAccountProvider.hpp"
@@ -32,6 +33,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace etl {
 
@@ -74,6 +76,8 @@ public:
      *
      * This function is blocking if the cache load style is set to sync and
      * disables the cache entirely if the load style is set to none/no.
+     * With the snapshot load style the cache is read from the snapshot file synchronously; if that is not possible the
+     * cache is loaded asynchronously instead.
      *
      * @param seq The sequence number to load cache for
      */
@@ -88,6 +92,19 @@ public:
             return;
         }
 
+        cache_.get().setNumLedgers(settings_.numCachedLedgers);
+        if (settings_.isCompressed())
+            cache_.get().enableCompression();
+        if (settings_.ownerIndex)
+            cache_.get().enableOwnerIndex();
+
+        if (settings_.isSnapshot()) {
+            if (loadFromSnapshot(seq))
+                return;
+
+            LOG(log_.warn()) << "Falling back to loading cache from database";
+        }
+
         std::shared_ptr<impl::BaseCursorProvider> provider;
         if (settings_.numCacheCursorsFromDiff != 0) {
             LOG(log_.info()) << "Loading cache with cursor from num_cursors_from_diff="
@@ -126,7 +143,8 @@ public:
     void
     stop() noexcept
     {
-        loader_->stop();
+        if (loader_)
+            loader_->stop();
     }
 
     /**
@@ -135,7 +153,76 @@ public:
     void
     wait() noexcept
     {
-        loader_->wait();
+        if (loader_)
+            loader_->wait();
+    }
+
+    /**
+     * @brief Write the cache to the snapshot file if the snapshot load style is used
+     *
+     * Does nothing unless the cache is full.
+     */
+    void
+    saveSnapshot() const
+    {
+        if (not settings_.isSnapshot() or settings_.snapshotFile.empty() or not cache_.get().isFull())
+            return;
+
+        LOG(log_.info()) << "Writing cache snapshot to " << settings_.snapshotFile;
+        auto const written = data::LedgerCacheFile{settings_.snapshotFile}.write(cache_.get());
+        if (written.has_value()) {
+            LOG(log_.info()) << "Wrote cache snapshot of ledger " << *written;
+        } else {
+            LOG(log_.error()) << "Could not write cache snapshot: " << written.error();
+        }
+    }
+
+private:
+    bool
+    loadFromSnapshot(uint32_t const seq)
+    {
+        if (settings_.snapshotFile.empty()) {
+            LOG(log_.error()) << "Cache load style is snapshot but no snapshot_file is configured";
+            return false;
+        }
+
+        data::LedgerCacheFile const file{settings_.snapshotFile};
+        auto const snapshotSeq = file.readSequence();
+        if (not snapshotSeq.has_value()) {
+            LOG(log_.warn()) << "Can't use cache snapshot " << settings_.snapshotFile << ": " << snapshotSeq.error();
+            return false;
+        }
+
+        // ledger diffs are only available for ledgers in the database
+        auto const range = backend_->hardFetchLedgerRangeNoThrow();
+        if (*snapshotSeq > seq or seq - *snapshotSeq > settings_.snapshotMaxLag or not range.has_value() or
+            *snapshotSeq < range->minSequence) {
+            LOG(log_.warn()) << "Cache snapshot of ledger " << *snapshotSeq << " can't be used to load ledger " << seq;
+            return false;
+        }
+
+        auto const loaded = file.read(
+            [this](std::vector<data::LedgerObject> const& objects, uint32_t ledgerSeq) {
+                cache_.get().update(objects, ledgerSeq);
+            },
+            settings_.cachePageFetchSize
+        );
+        if (not loaded.has_value()) {
+            LOG(log_.warn()) << "Can't use cache snapshot " << settings_.snapshotFile << ": " << loaded.error();
+            return false;
+        }
+
+        for (auto replaySeq = *snapshotSeq + 1; replaySeq <= seq; ++replaySeq) {
+            auto const diff = data::synchronousAndRetryOnTimeout([this, replaySeq](auto yield) {
+                return backend_->fetchLedgerDiff(replaySeq, yield);
+            });
+            cache_.get().update(diff, replaySeq);
+        }
+
+        cache_.get().setFull();
+        LOG(log_.info()) << "Loaded cache from snapshot of ledger " << *snapshotSeq << " and replayed "
+                         << seq - *snapshotSeq << " ledgers. Cache size = " << cache_.get().size();
+        return true;
     }
 };
 
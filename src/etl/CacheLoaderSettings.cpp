@@ -24,6 +24,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <cstddef>
+#include <stdexcept>
 #include <string>
 
 namespace etl {
@@ -40,12 +41,24 @@ CacheLoaderSettings::isAsync() const
     return loadStyle == LoadStyle::ASYNC;
 }
 
+[[nodiscard]] bool
+CacheLoaderSettings::isSnapshot() const
+{
+    return loadStyle == LoadStyle::SNAPSHOT;
+}
+
 [[nodiscard]] bool
 CacheLoaderSettings::isDisabled() const
 {
     return loadStyle == LoadStyle::NONE;
 }
 
+[[nodiscard]] bool
+CacheLoaderSettings::isCompressed() const
+{
+    return compression != Compression::NONE;
+}
+
 [[nodiscard]] CacheLoaderSettings
 make_CacheLoaderSettings(util::Config const& config)
 {
@@ -62,6 +75,13 @@ make_CacheLoaderSettings(util::Config const& config)
 
         settings.numCacheMarkers = cache.valueOr<size_t>("num_markers", settings.numCacheMarkers);
         settings.cachePageFetchSize = cache.valueOr<size_t>("page_fetch_size", settings.cachePageFetchSize);
+        settings.numCachedLedgers = cache.valueOr<size_t>("num_ledgers", settings.numCachedLedgers);
+        if (settings.numCachedLedgers == 0)
+            throw std::runtime_error("`cache.num_ledgers` must be at least 1");
+
+        settings.snapshotFile = cache.valueOr<std::string>("snapshot_file", settings.snapshotFile);
+        settings.snapshotMaxLag = cache.valueOr<size_t>("snapshot_max_lag", settings.snapshotMaxLag);
+        settings.ownerIndex = cache.valueOr<bool>("owner_index", settings.ownerIndex);
 
         if (auto entry = cache.maybeValue<std::string>("load"); entry) {
             if (boost::iequals(*entry, "sync"))
@@ -70,6 +90,15 @@ make_CacheLoaderSettings(util::Config const& config)
                 settings.loadStyle = CacheLoaderSettings::LoadStyle::ASYNC;
             if (boost::iequals(*entry, "none") or boost::iequals(*entry, "no"))
                 settings.loadStyle = CacheLoaderSettings::LoadStyle::NONE;
+            if (boost::iequals(*entry, "snapshot"))
+                settings.loadStyle = CacheLoaderSettings::LoadStyle::SNAPSHOT;
+        }
+
+        if (auto entry = cache.maybeValue<std::string>("compression"); entry) {
+            if (boost::iequals(*entry, "zstd"))
+                settings.compression = CacheLoaderSettings::Compression::ZSTD;
+            if (boost::iequals(*entry, "none"))
+                settings.compression = CacheLoaderSettings::Compression::NONE;
         }
     }
     return settings;
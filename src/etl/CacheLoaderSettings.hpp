@@ -22,6 +22,7 @@
 #include "util/config/Config.hpp"
 
 #include <cstddef>
+#include <string>
 
 namespace etl {
 
@@ -30,7 +31,10 @@ namespace etl {
  */
 struct CacheLoaderSettings {
     /** @brief Ways to load the cache */
-    enum class LoadStyle { ASYNC, SYNC, NONE };
+    enum class LoadStyle { ASYNC, SYNC, NONE, SNAPSHOT };
+
+    /** @brief Ways to store the cached objects */
+    enum class Compression { NONE, ZSTD };
 
     size_t numCacheDiffs = 32;             /**< number of diffs to use to generate cursors */
     size_t numCacheMarkers = 48;           /**< number of markers to use at one time to traverse the ledger */
@@ -38,8 +42,13 @@ struct CacheLoaderSettings {
     size_t numThreads = 2;                 /**< number of threads to use for loading cache */
     size_t numCacheCursorsFromDiff = 0;    /**< number of cursors to fetch from diff */
     size_t numCacheCursorsFromAccount = 0; /**< number of cursors to fetch from account_tx */
+    size_t numCachedLedgers = 4;           /**< number of most recent ledgers served from the cache */
+    size_t snapshotMaxLag = 1000;          /**< max number of ledgers to replay on top of the snapshot file */
+    std::string snapshotFile;              /**< path of the snapshot file; used by the SNAPSHOT load style */
 
-    LoadStyle loadStyle = LoadStyle::ASYNC; /**< how to load the cache */
+    LoadStyle loadStyle = LoadStyle::ASYNC;       /**< how to load the cache */
+    Compression compression = Compression::NONE; /**< how to store the cached objects */
+    bool ownerIndex = false;                      /**< whether to index the owner directories of accounts */
 
     auto
     operator<=>(CacheLoaderSettings const&) const = default;
@@ -52,9 +61,17 @@ struct CacheLoaderSettings {
     [[nodiscard]] bool
     isAsync() const;
 
+    /** @returns True if the load style is SNAPSHOT; false otherwise */
+    [[nodiscard]] bool
+    isSnapshot() const;
+
     /** @returns True if the cache is disabled; false otherwise */
     [[nodiscard]] bool
     isDisabled() const;
+
+    /** @returns True if the cached objects are compressed; false otherwise */
+    [[nodiscard]] bool
+    isCompressed() const;
 };
 
 /**
@@ -23,6 +23,7 @@
 #include "data/LedgerCache.hpp"
 #include "etl/CorruptionDetector.hpp"
 #include "etl/NetworkValidatedLedgersInterface.hpp"
+#include "etl/impl/LedgerDiffSource.hpp"
 #include "feed/SubscriptionManagerInterface.hpp"
 #include "util/Assert.hpp"
 #include "util/Constants.hpp"
@@ -39,6 +40,7 @@
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -244,6 +246,9 @@ ETLService::run()
     LOG(log_.info()) << "Starting reporting etl";
     state_.isStopping = false;
 
+    if (ledgerDiffSource_)
+        ledgerDiffSource_->run();
+
     doWork();
 }
 
@@ -275,7 +280,8 @@ ETLService::ETLService(
     , cacheLoader_(config, backend, backend->cache())
     , ledgerFetcher_(backend, balancer)
     , ledgerLoader_(backend, balancer, ledgerFetcher_, state_)
-    , ledgerPublisher_(ioc, backend, backend->cache(), subscriptions, state_)
+    , ledgerDiffSource_(makeLedgerDiffSource(config, ioc))
+    , ledgerPublisher_(ioc, backend, backend->cache(), subscriptions, state_, ledgerDiffSource_)
     , amendmentBlockHandler_(ioc, state_)
 {
     startSequence_ = config.maybeValue<uint32_t>("start_sequence");
@@ -287,4 +293,21 @@ ETLService::ETLService(
     // This should probably be done in the backend factory but we don't have state available until here
     backend_->setCorruptionDetector(CorruptionDetector<data::LedgerCache>{state_, backend->cache()});
 }
+
+std::shared_ptr<etl::impl::LedgerDiffSource>
+ETLService::makeLedgerDiffSource(util::Config const& config, boost::asio::io_context& ioc)
+{
+    auto const ip = config.maybeValue<std::string>("ledger_diff_source.ip");
+    auto const wsPort = config.maybeValue<std::string>("ledger_diff_source.ws_port");
+    if (not ip.has_value() or not wsPort.has_value())
+        return nullptr;
+
+    util::Logger const log{"ETL"};
+    LOG(log.info()) << "Receiving ledger diffs from " << *ip << ":" << *wsPort;
+
+    return std::make_shared<etl::impl::LedgerDiffSource>(
+        ioc, *ip, *wsPort, config.maybeValue<std::string>("ledger_diff_source.admin_password")
+    );
+}
+
 }  // namespace etl
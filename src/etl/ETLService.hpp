@@ -29,6 +29,7 @@
 #include "etl/impl/AmendmentBlockHandler.hpp"
 #include "etl/impl/ExtractionDataPipe.hpp"
 #include "etl/impl/Extractor.hpp"
+#include "etl/impl/LedgerDiffSource.hpp"
 #include "etl/impl/LedgerFetcher.hpp"
 #include "etl/impl/LedgerLoader.hpp"
 #include "etl/impl/LedgerPublisher.hpp"
@@ -97,6 +98,7 @@ class ETLService {
     CacheLoaderType cacheLoader_;
     LedgerFetcherType ledgerFetcher_;
     LedgerLoaderType ledgerLoader_;
+    std::shared_ptr<etl::impl::LedgerDiffSource> ledgerDiffSource_;  // only set if configured
     LedgerPublisherType ledgerPublisher_;
     AmendmentBlockHandlerType amendmentBlockHandler_;
 
@@ -167,10 +169,14 @@ public:
         state_.isStopping = true;
         cacheLoader_.stop();
 
+        if (ledgerDiffSource_)
+            ledgerDiffSource_->stop();
+
         if (worker_.joinable())
             worker_.join();
 
         LOG(log_.debug()) << "Joined ETLService worker thread";
+        cacheLoader_.saveSnapshot();
     }
 
     /**
@@ -279,6 +285,16 @@ private:
     void
     monitorReadOnly();
 
+    /**
+     * @brief Create the source of ledger diffs pushed by the writing Clio node, if one is configured.
+     *
+     * @param config The configuration to use
+     * @param ioc io context to run on
+     * @return The source or nullptr if none is configured
+     */
+    static std::shared_ptr<etl::impl::LedgerDiffSource>
+    makeLedgerDiffSource(util::Config const& config, boost::asio::io_context& ioc);
+
     /**
      * @return true if stopping; false otherwise
      */
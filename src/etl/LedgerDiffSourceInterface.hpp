@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/** @file */
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace etl {
+
+/**
+ * @brief Everything needed to apply a ledger without reading it from the database.
+ */
+struct LedgerDiff {
+    ripple::LedgerHeader header;
+    std::vector<data::LedgerObject> objects;                 // deleted objects have an empty blob
+    std::vector<data::TransactionAndMetadata> transactions;  // ordered by transaction index
+};
+
+/**
+ * @brief An interface for a source of ledger diffs pushed by the Clio node that writes to the database.
+ */
+class LedgerDiffSourceInterface {
+public:
+    virtual ~LedgerDiffSourceInterface() = default;
+
+    /**
+     * @brief Check whether the diff of the given ledger was not received yet but is still expected to arrive shortly.
+     *
+     * The writer publishes a diff right after it commits the ledger, so a reader that learns about the ledger from the
+     * database may be a little ahead of it. A diff stops being expected once a newer one arrives, the source
+     * disconnects or the source-specific wait time since the first check of this ledger has passed.
+     *
+     * @param sequence The sequence of the ledger
+     * @return true if the caller should check again shortly before taking the diff; false otherwise
+     */
+    virtual bool
+    isExpected(std::uint32_t sequence) = 0;
+
+    /**
+     * @brief Take the diff of the given ledger out of the source without waiting for it.
+     *
+     * Diffs of older ledgers are dropped as well.
+     *
+     * @param sequence The sequence of the ledger
+     * @return The diff of the ledger; std::nullopt if it was not received, in which case the caller should read the
+     * ledger from the database
+     */
+    virtual std::optional<LedgerDiff>
+    take(std::uint32_t sequence) = 0;
+};
+
+}  // namespace etl
@@ -29,6 +29,8 @@
 #include "util/Random.hpp"
 #include "util/ResponseExpirationCache.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/spawn.hpp>
@@ -37,13 +39,18 @@
 #include <boost/json/value.hpp>
 #include <boost/json/value_to.hpp>
 #include <fmt/core.h>
+#include <grpcpp/support/status.h>
 
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <future>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -78,6 +85,11 @@ LoadBalancer::LoadBalancer(
     std::shared_ptr<NetworkValidatedLedgersInterface> validatedLedgers,
     SourceFactory sourceFactory
 )
+    : hedgedFetches_{PrometheusService::counterInt(
+          "etl_hedged_fetches_total_number",
+          util::prometheus::Labels{},
+          "Total number of ledger fetches raced against a second source because the first one was slow"
+      )}
 {
     auto const forwardingCacheTimeout = config.valueOr<float>("forwarding.cache_timeout", 0.f);
     if (forwardingCacheTimeout > 0.f) {
@@ -95,6 +107,9 @@ LoadBalancer::LoadBalancer(
         downloadRanges_ = 4;
     }
 
+    if (auto const hedgeDelay = config.valueOr<float>("fetch_hedge_delay", 0.f); hedgeDelay > 0.f)
+        hedgeDelay_ = Config::toMilliseconds(hedgeDelay);
+
     auto const allowNoEtl = config.valueOr("allow_no_etl", false);
 
     auto const checkOnETLFailure = [this, allowNoEtl](std::string const& log) {
@@ -146,6 +161,22 @@ LoadBalancer::LoadBalancer(
             etlState_ = stateOpt;
         }
 
+        static std::vector<std::int64_t> const buckets{10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000};
+        fetchDurations_.emplace(
+            source.get(),
+            PrometheusService::histogramInt(
+                "etl_fetch_ledger_duration_milliseconds_histogram",
+                util::prometheus::Labels({util::prometheus::Label{
+                    "source",
+                    fmt::format(
+                        "{}:{}", entry.valueOr<std::string>("ip", {}), entry.valueOr<std::string>("grpc_port", {})
+                    )
+                }}),
+                buckets,
+                "The duration of fetching a ledger from an ETL source"
+            )
+        );
+
         sources_.push_back(std::move(source));
         LOG(log_.info()) << "Added etl source - " << sources_.back()->toString();
     }
@@ -156,6 +187,8 @@ LoadBalancer::LoadBalancer(
     if (sources_.empty())
         checkOnETLFailure("No ETL sources configured. Please check the configuration");
 
+    forwardsInFlight_ = std::vector<std::atomic_uint32_t>(sources_.size());
+
     // This is made separate from source creation to prevent UB in case one of the sources will call
     // chooseForwardingSource while we are still filling the sources_ vector
     for (auto const& source : sources_) {
@@ -165,6 +198,7 @@ LoadBalancer::LoadBalancer(
 
 LoadBalancer::~LoadBalancer()
 {
+    losingFetches_.lock()->clear();  // waits for the fetches still using the sources
     sources_.clear();
 }
 
@@ -201,8 +235,8 @@ LoadBalancer::fetchLedger(
 {
     GetLedgerResponseType response;
     execute(
-        [&response, ledgerSequence, getObjects, getObjectNeighbors, log = log_](auto& source) {
-            auto [status, data] = source->fetchLedger(ledgerSequence, getObjects, getObjectNeighbors);
+        [this, &response, ledgerSequence, getObjects, getObjectNeighbors, log = log_](auto& source) {
+            auto [status, data] = fetchLedgerHedged(*source, ledgerSequence, getObjects, getObjectNeighbors);
             response = std::move(data);
             if (status.ok() && response.validated()) {
                 LOG(log.info()) << "Successfully fetched ledger = " << ledgerSequence
@@ -221,6 +255,81 @@ LoadBalancer::fetchLedger(
     return response;
 }
 
+std::pair<grpc::Status, LoadBalancer::GetLedgerResponseType>
+LoadBalancer::fetchLedgerHedged(SourceBase& source, uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors)
+{
+    if (not hedgeDelay_.has_value() or sources_.size() < 2)
+        return timedFetchLedger(source, ledgerSequence, getObjects, getObjectNeighbors);
+
+    struct Race {
+        std::mutex mutex;
+        std::condition_variable done;
+        std::size_t running = 0;
+        std::optional<std::pair<grpc::Status, GetLedgerResponseType>> result;
+    };
+    auto race = std::make_shared<Race>();
+
+    // the first successful response wins; a failure is only reported when no other fetch is still running
+    auto const start = [&](SourceBase& src) {
+        ++race->running;
+        return std::async(std::launch::async, [this, race, &src, ledgerSequence, getObjects, getObjectNeighbors]() {
+            auto result = timedFetchLedger(src, ledgerSequence, getObjects, getObjectNeighbors);
+            auto const succeeded = result.first.ok() and result.second.validated();
+
+            std::scoped_lock const lock{race->mutex};
+            --race->running;
+            if (not race->result.has_value() and (succeeded or race->running == 0))
+                race->result = std::move(result);
+
+            race->done.notify_all();
+        });
+    };
+
+    std::vector<std::future<void>> fetches;
+    std::unique_lock lock{race->mutex};
+    fetches.push_back(start(source));
+
+    if (not race->done.wait_for(lock, *hedgeDelay_, [&race]() { return race->result.has_value(); })) {
+        auto const it = std::ranges::find_if(sources_, [&source](auto const& src) { return src.get() == &source; });
+        auto const index = static_cast<std::size_t>(std::distance(sources_.begin(), it));
+        for (std::size_t i = 1; i < sources_.size(); ++i) {
+            auto& other = *sources_[(index + i) % sources_.size()];
+            if (other.hasLedger(ledgerSequence)) {
+                LOG(log_.info()) << "Fetching ledger " << ledgerSequence << " takes longer than "
+                                 << hedgeDelay_->count() << "ms. Also fetching from source = " << other.toString();
+                ++hedgedFetches_.get();
+                fetches.push_back(start(other));
+                break;
+            }
+        }
+
+        race->done.wait(lock, [&race]() { return race->result.has_value(); });
+    }
+
+    auto result = std::move(race->result).value();
+    lock.unlock();
+
+    auto losing = losingFetches_.lock();
+    std::erase_if(*losing, [](auto const& fetch) {
+        return fetch.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    });
+    std::ranges::move(fetches, std::back_inserter(*losing));
+
+    return result;
+}
+
+std::pair<grpc::Status, LoadBalancer::GetLedgerResponseType>
+LoadBalancer::timedFetchLedger(SourceBase& source, uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors)
+{
+    auto const start = std::chrono::steady_clock::now();
+    auto result = source.fetchLedger(ledgerSequence, getObjects, getObjectNeighbors);
+
+    fetchDurations_.at(&source).get().observe(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+    );
+    return result;
+}
+
 std::expected<boost::json::object, rpc::ClioError>
 LoadBalancer::forwardToRippled(
     boost::json::object const& request,
@@ -240,7 +349,15 @@ LoadBalancer::forwardToRippled(
     }
 
     ASSERT(not sources_.empty(), "ETL sources must be configured to forward requests.");
-    std::size_t sourceIdx = util::Random::uniform(0ul, sources_.size() - 1);
+
+    // start with the least loaded source; ties are broken randomly
+    auto const firstIdx = util::Random::uniform(0ul, sources_.size() - 1);
+    std::size_t sourceIdx = firstIdx;
+    for (std::size_t i = 1; i < sources_.size(); ++i) {
+        auto const idx = (firstIdx + i) % sources_.size();
+        if (forwardsInFlight_[idx] < forwardsInFlight_[sourceIdx])
+            sourceIdx = idx;
+    }
 
     auto numAttempts = 0u;
 
@@ -249,7 +366,9 @@ LoadBalancer::forwardToRippled(
     std::optional<boost::json::object> response;
     rpc::ClioError error = rpc::ClioError::etlCONNECTION_ERROR;
     while (numAttempts < sources_.size()) {
+        ++forwardsInFlight_[sourceIdx];
         auto res = sources_[sourceIdx]->forwardToRippled(request, clientIp, xUserValue, yield);
+        --forwardsInFlight_[sourceIdx];
         if (res) {
             response = std::move(res).value();
             break;
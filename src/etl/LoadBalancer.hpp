@@ -28,6 +28,8 @@
 #include "util/ResponseExpirationCache.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/asio/io_context.hpp>
@@ -39,13 +41,18 @@
 #include <org/xrpl/rpc/v1/ledger.pb.h>
 #include <xrpl/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <expected>
+#include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace etl {
@@ -80,6 +87,17 @@ private:
     // forward messages should be done with a mutual exclusion otherwise there will be a race condition
     util::Mutex<bool> hasForwardingSource_{false};
 
+    // A fetch taking longer than this is raced against the same fetch from another source; no hedging if not set
+    std::optional<std::chrono::milliseconds> hedgeDelay_;
+    std::unordered_map<SourceBase const*, std::reference_wrapper<util::prometheus::HistogramInt>> fetchDurations_;
+    std::reference_wrapper<util::prometheus::CounterInt> hedgedFetches_;
+
+    // Number of requests each source is forwarding right now, indexed like sources_
+    std::vector<std::atomic_uint32_t> forwardsInFlight_;
+
+    // Fetches that lost a hedged race; they keep running in the background and are joined before sources are destroyed
+    util::Mutex<std::vector<std::future<void>>> losingFetches_;
+
 public:
     /**
      * @brief Value for the X-User header when forwarding admin requests
@@ -179,7 +197,7 @@ public:
     toJson() const;
 
     /**
-     * @brief Forward a JSON RPC request to a randomly selected rippled node.
+     * @brief Forward a JSON RPC request to the rippled node forwarding the fewest requests at the moment.
      *
      * @param request JSON-RPC request to forward
      * @param clientIp The IP address of the peer, if known
@@ -219,6 +237,33 @@ private:
     void
     execute(Func f, uint32_t ledgerSequence, std::chrono::steady_clock::duration retryAfter = std::chrono::seconds{2});
 
+    /**
+     * @brief Fetch a ledger from the given source, hedging the fetch to another source if it is slow.
+     *
+     * If the fetch is not done after the configured hedge delay, the same fetch is started on the next source that has
+     * the ledger. The first successful response wins; the other fetch is left to finish in the background.
+     *
+     * @param source The source to fetch from
+     * @param ledgerSequence Sequence of the ledger to fetch
+     * @param getObjects Whether to get the account state diff between this ledger and the prior one
+     * @param getObjectNeighbors Whether to request object neighbors
+     * @return The status and the response of the winning fetch
+     */
+    std::pair<grpc::Status, GetLedgerResponseType>
+    fetchLedgerHedged(SourceBase& source, uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors);
+
+    /**
+     * @brief Fetch a ledger from the given source and record how long it took.
+     *
+     * @param source The source to fetch from
+     * @param ledgerSequence Sequence of the ledger to fetch
+     * @param getObjects Whether to get the account state diff between this ledger and the prior one
+     * @param getObjectNeighbors Whether to request object neighbors
+     * @return The status and the response of the fetch
+     */
+    std::pair<grpc::Status, GetLedgerResponseType>
+    timedFetchLedger(SourceBase& source, uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors);
+
     /**
      * @brief Choose a new source to forward requests
      */
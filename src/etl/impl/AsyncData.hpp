@@ -34,6 +34,7 @@
 #include <xrpl/basics/strHex.h>
 #include <xrpl/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -58,6 +59,10 @@ class AsyncCallData {
 
     std::string lastKey_;
 
+    std::string markerPrefix_;
+    std::size_t numObjects_ = 0;
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
 public:
     AsyncCallData(uint32_t seq, ripple::uint256 const& marker, std::optional<ripple::uint256> const& nextMarker)
     {
@@ -71,9 +76,10 @@ public:
             nextPrefix_ = nextMarker->data()[0];
 
         unsigned char const prefix = marker.data()[0];
+        markerPrefix_ = ripple::strHex(std::string(1, prefix));
 
         LOG(log_.debug()) << "Setting up AsyncCallData. marker = " << ripple::strHex(marker)
-                          << " . prefix = " << ripple::strHex(std::string(1, prefix))
+                          << " . prefix = " << markerPrefix_
                           << " . nextPrefix_ = " << ripple::strHex(std::string(1, nextPrefix_));
 
         ASSERT(
@@ -160,8 +166,16 @@ public:
             }
         }
         backend.cache().update(cacheUpdates, request_.ledger().sequence(), cacheOnly);
+        numObjects_ += cacheUpdates.size();
         LOG(log_.debug()) << "Wrote " << numObjects << " objects. Got more: " << (more ? "YES" : "NO");
 
+        if (!more) {
+            auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+            auto const rate = seconds > 0 ? static_cast<double>(numObjects_) / seconds : 0.0;
+            LOG(log_.info()) << "Finished marker prefix " << markerPrefix_ << ": " << numObjects_ << " objects in "
+                             << seconds << " seconds (" << rate << " objects/sec)";
+        }
+
         return more ? CallStatus::MORE : CallStatus::DONE;
     }
 
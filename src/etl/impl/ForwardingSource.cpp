@@ -21,6 +21,9 @@
 
 #include "rpc/Errors.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+#include "util/requests/WsConnection.hpp"
 
 #include <boost/asio/spawn.hpp>
 #include <boost/beast/http/field.hpp>
@@ -30,13 +33,18 @@
 #include <boost/json/serialize.hpp>
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <iterator>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 namespace etl::impl {
 
@@ -47,8 +55,29 @@ ForwardingSource::ForwardingSource(
     std::chrono::steady_clock::duration connectionTimeout
 )
     : log_(fmt::format("ForwardingSource[{}:{}]", ip, wsPort))
-    , connectionBuilder_(std::move(ip), std::move(wsPort))
+    , connectionBuilder_(ip, wsPort)
     , forwardingTimeout_{forwardingTimeout}
+    , idleConnectionsGauge_{PrometheusService::gaugeInt(
+          "forwarding_idle_connections",
+          util::prometheus::Labels({util::prometheus::Label{"source", fmt::format("{}:{}", ip, wsPort)}}),
+          "The number of open connections to rippled waiting for a request to forward"
+      )}
+    , newConnections_{PrometheusService::counterInt(
+          "forwarding_connections_total_number",
+          util::prometheus::Labels(
+              {util::prometheus::Label{"source", fmt::format("{}:{}", ip, wsPort)},
+               util::prometheus::Label{"status", "new"}}
+          ),
+          "The number of connections to rippled opened or reused to forward a request"
+      )}
+    , reusedConnections_{PrometheusService::counterInt(
+          "forwarding_connections_total_number",
+          util::prometheus::Labels(
+              {util::prometheus::Label{"source", fmt::format("{}:{}", ip, wsPort)},
+               util::prometheus::Label{"status", "reused"}}
+          ),
+          "The number of connections to rippled opened or reused to forward a request"
+      )}
 {
     connectionBuilder_.setConnectionTimeout(connectionTimeout)
         .addHeader(
@@ -64,6 +93,22 @@ ForwardingSource::forwardToRippled(
     boost::asio::yield_context yield
 ) const
 {
+    auto const key = fmt::format("{}|{}", forwardToRippledClientIp.value_or(""), xUserValue);
+    auto const message = boost::json::serialize(request);
+
+    if (auto connection = takeIdleConnection(key); connection) {
+        ++reusedConnections_.get();
+        auto response = this->request(*connection, message, yield);
+        if (response.has_value()) {
+            releaseConnection(key, std::move(connection));
+            return parseResponse(*response);
+        }
+
+        // rippled may have closed the idle connection in the meantime, in which case the request is sent on a new one
+        if (response.error() != rpc::ClioError::etlREQUEST_ERROR)
+            return std::unexpected{response.error()};
+    }
+
     auto connectionBuilder = connectionBuilder_;
     if (forwardToRippledClientIp) {
         connectionBuilder.addHeader(
@@ -78,15 +123,50 @@ ForwardingSource::forwardToRippled(
         LOG(log_.debug()) << "Couldn't connect to rippled to forward request.";
         return std::unexpected{rpc::ClioError::etlCONNECTION_ERROR};
     }
+    ++newConnections_.get();
+
     auto& connection = expectedConnection.value();
+    auto response = this->request(*connection, message, yield);
+    if (not response)
+        return std::unexpected{response.error()};
+
+    releaseConnection(key, std::move(connection));
+    return parseResponse(*response);
+}
+
+std::expected<boost::json::object, rpc::ClioError>
+ForwardingSource::parseResponse(std::string const& response) const
+{
+    boost::json::value parsedResponse;
+    try {
+        parsedResponse = boost::json::parse(response);
+        if (not parsedResponse.is_object())
+            throw std::runtime_error("response is not an object");
+    } catch (std::exception const& e) {
+        LOG(log_.debug()) << "Error parsing response from rippled: " << e.what() << ". Response: " << response;
+        return std::unexpected{rpc::ClioError::etlINVALID_RESPONSE};
+    }
+
+    auto responseObject = parsedResponse.as_object();
+    responseObject["forwarded"] = true;
 
-    auto writeError = connection->write(boost::json::serialize(request), yield, forwardingTimeout_);
+    return responseObject;
+}
+
+std::expected<std::string, rpc::ClioError>
+ForwardingSource::request(
+    util::requests::WsConnection& connection,
+    std::string const& message,
+    boost::asio::yield_context yield
+) const
+{
+    auto writeError = connection.write(message, yield, forwardingTimeout_);
     if (writeError) {
         LOG(log_.debug()) << "Error sending request to rippled to forward request.";
         return std::unexpected{rpc::ClioError::etlREQUEST_ERROR};
     }
 
-    auto response = connection->read(yield, forwardingTimeout_);
+    auto response = connection.read(yield, forwardingTimeout_);
     if (not response) {
         if (auto errorCode = response.error().errorCode();
             errorCode.has_value() and errorCode->value() == boost::system::errc::timed_out) {
@@ -97,20 +177,93 @@ ForwardingSource::forwardToRippled(
         return std::unexpected{rpc::ClioError::etlREQUEST_ERROR};
     }
 
-    boost::json::value parsedResponse;
-    try {
-        parsedResponse = boost::json::parse(*response);
-        if (not parsedResponse.is_object())
-            throw std::runtime_error("response is not an object");
-    } catch (std::exception const& e) {
-        LOG(log_.debug()) << "Error parsing response from rippled: " << e.what() << ". Response: " << *response;
-        return std::unexpected{rpc::ClioError::etlINVALID_RESPONSE};
+    return std::move(response).value();
+}
+
+util::requests::WsConnectionPtr
+ForwardingSource::takeIdleConnection(std::string const& key) const
+{
+    auto idleConnections = idleConnections_->lock();
+    auto const it = idleConnections->byKey.find(key);
+    if (it == idleConnections->byKey.end())
+        return nullptr;
+
+    auto& connections = it->second;
+    auto const now = std::chrono::steady_clock::now();
+
+    // the most recently used connection is the least likely to be closed by rippled
+    util::requests::WsConnectionPtr result;
+    while (not connections.empty() and not result) {
+        auto idle = std::move(connections.back());
+        connections.pop_back();
+        --idleConnections->size;
+
+        if (now - idle.since < IDLE_TIMEOUT)
+            result = std::move(idle.connection);
     }
 
-    auto responseObject = parsedResponse.as_object();
-    responseObject["forwarded"] = true;
+    if (connections.empty())
+        idleConnections->byKey.erase(it);
 
-    return responseObject;
+    idleConnectionsGauge_.get().set(static_cast<std::int64_t>(idleConnections->size));
+    return result;
+}
+
+void
+ForwardingSource::releaseConnection(std::string const& key, util::requests::WsConnectionPtr connection) const
+{
+    // declared before the lock so that evicted connections are closed after it is released
+    std::vector<IdleConnection> evicted;
+
+    auto idleConnections = idleConnections_->lock();
+    auto const now = std::chrono::steady_clock::now();
+    if (idleConnections->size >= MAX_IDLE_CONNECTIONS)
+        evictIdleConnections(*idleConnections, now, evicted);
+
+    idleConnections->byKey[key].push_back(IdleConnection{.connection = std::move(connection), .since = now});
+    ++idleConnections->size;
+    idleConnectionsGauge_.get().set(static_cast<std::int64_t>(idleConnections->size));
+}
+
+void
+ForwardingSource::evictIdleConnections(
+    IdleConnections& idleConnections,
+    std::chrono::steady_clock::time_point now,
+    std::vector<IdleConnection>& evicted
+)
+{
+    // connections of a client are ordered by the time they were released, so the expired ones come first
+    for (auto it = idleConnections.byKey.begin(); it != idleConnections.byKey.end();) {
+        auto& connections = it->second;
+        auto const firstActive = std::ranges::find_if(connections, [now](auto const& idle) {
+            return now - idle.since < IDLE_TIMEOUT;
+        });
+
+        std::move(connections.begin(), firstActive, std::back_inserter(evicted));
+        idleConnections.size -= static_cast<std::size_t>(std::distance(connections.begin(), firstActive));
+        connections.erase(connections.begin(), firstActive);
+
+        if (connections.empty()) {
+            it = idleConnections.byKey.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (idleConnections.size < MAX_IDLE_CONNECTIONS)
+        return;
+
+    auto const leastRecentlyUsed = std::ranges::min_element(idleConnections.byKey, {}, [](auto const& entry) {
+        return entry.second.front().since;
+    });
+
+    auto& connections = leastRecentlyUsed->second;
+    evicted.push_back(std::move(connections.front()));
+    connections.erase(connections.begin());
+    --idleConnections.size;
+
+    if (connections.empty())
+        idleConnections.byKey.erase(leastRecentlyUsed);
 }
 
 }  // namespace etl::impl
@@ -20,28 +20,61 @@
 #pragma once
 
 #include "rpc/Errors.hpp"
+#include "util/Mutex.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
 #include "util/requests/WsConnection.hpp"
 
 #include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <expected>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace etl::impl {
 
+/**
+ * @brief Forwards requests to rippled over websocket connections which are kept open and reused.
+ *
+ * rippled applies the `Forwarded` and `X-User` headers of the handshake to the whole connection, so idle connections
+ * are pooled per client IP and X-User value. A connection serves one request at a time; a reused connection that
+ * turns out to be closed by rippled is replaced by a new one. When the pool is full, expired connections of any client
+ * are closed first, then the least recently used one.
+ */
 class ForwardingSource {
+    struct IdleConnection {
+        util::requests::WsConnectionPtr connection;
+        std::chrono::steady_clock::time_point since;
+    };
+    struct IdleConnections {
+        std::unordered_map<std::string, std::vector<IdleConnection>> byKey;
+        std::size_t size = 0;
+    };
+
     util::Logger log_;
     util::requests::WsConnectionBuilder connectionBuilder_;
     std::chrono::steady_clock::duration forwardingTimeout_;
 
+    std::unique_ptr<util::Mutex<IdleConnections>> idleConnections_ = std::make_unique<util::Mutex<IdleConnections>>();
+    std::reference_wrapper<util::prometheus::GaugeInt> idleConnectionsGauge_;
+    std::reference_wrapper<util::prometheus::CounterInt> newConnections_;
+    std::reference_wrapper<util::prometheus::CounterInt> reusedConnections_;
+
     static constexpr std::chrono::seconds CONNECTION_TIMEOUT{3};
+    static constexpr std::chrono::seconds IDLE_TIMEOUT{30};
 
 public:
+    static constexpr std::size_t MAX_IDLE_CONNECTIONS = 64; /**< The maximum number of idle connections kept open */
+
     ForwardingSource(
         std::string ip,
         std::string wsPort,
@@ -65,6 +98,27 @@ public:
         std::string_view xUserValue,
         boost::asio::yield_context yield
     ) const;
+
+private:
+    std::expected<boost::json::object, rpc::ClioError>
+    parseResponse(std::string const& response) const;
+
+    std::expected<std::string, rpc::ClioError>
+    request(util::requests::WsConnection& connection, std::string const& message, boost::asio::yield_context yield)
+        const;
+
+    util::requests::WsConnectionPtr
+    takeIdleConnection(std::string const& key) const;
+
+    void
+    releaseConnection(std::string const& key, util::requests::WsConnectionPtr connection) const;
+
+    static void
+    evictIdleConnections(
+        IdleConnections& idleConnections,
+        std::chrono::steady_clock::time_point now,
+        std::vector<IdleConnection>& evicted
+    );
 };
 
 }  // namespace etl::impl
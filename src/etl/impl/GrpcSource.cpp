@@ -22,25 +22,31 @@
 #include "data/BackendInterface.hpp"
 #include "etl/impl/AsyncData.hpp"
 #include "util/Assert.hpp"
+#include "util/Mutex.hpp"
 #include "util/log/Logger.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <fmt/core.h>
 #include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
 #include <grpcpp/security/credentials.h>
 #include <grpcpp/support/channel_arguments.h>
 #include <grpcpp/support/status.h>
 #include <org/xrpl/rpc/v1/get_ledger.pb.h>
 #include <org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <functional>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -107,50 +113,69 @@ GrpcSource::loadInitialLedger(uint32_t const sequence, uint32_t const numMarkers
 
     LOG(log_.debug()) << "Starting data download for ledger " << sequence << ".";
 
-    grpc::CompletionQueue cq;
-    for (auto& c : calls)
-        c.call(stub_, cq);
+    // every thread drives its share of the markers through a completion queue of its own so that parsing the
+    // responses and handing the objects to the backend and the cache is spread across cores
+    auto const numThreads =
+        std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, std::max<std::size_t>(calls.size(), 1));
+    std::vector<grpc::CompletionQueue> queues(numThreads);
+    for (std::size_t i = 0; i < calls.size(); ++i)
+        calls[i].call(stub_, queues[i % numThreads]);
 
-    void* tag = nullptr;
-    bool ok = false;
-    size_t numFinished = 0;
-    bool abort = false;
+    std::atomic_bool abort = false;
     size_t const incr = 500000;
-    size_t progress = incr;
-    std::vector<std::string> edgeKeys;
-
-    while (numFinished < calls.size() && cq.Next(&tag, &ok)) {
-        ASSERT(tag != nullptr, "Tag can't be null.");
-        auto ptr = static_cast<etl::impl::AsyncCallData*>(tag);
-
-        if (!ok) {
-            LOG(log_.error()) << "loadInitialLedger - ok is false";
-            return {{}, false};  // handle cancelled
+    std::atomic_size_t progress = incr;
+    util::Mutex<std::vector<std::string>> edgeKeys;
+
+    auto const drain = [&](grpc::CompletionQueue& cq, std::size_t numCalls) {
+        void* tag = nullptr;
+        bool ok = false;
+        size_t numFinished = 0;
+
+        while (numFinished < numCalls && cq.Next(&tag, &ok)) {
+            ASSERT(tag != nullptr, "Tag can't be null.");
+            auto ptr = static_cast<etl::impl::AsyncCallData*>(tag);
+
+            if (!ok) {
+                LOG(log_.error()) << "loadInitialLedger - ok is false";
+                abort = true;  // handle cancelled
+                ++numFinished;
+                continue;
+            }
+
+            LOG(log_.trace()) << "Marker prefix = " << ptr->getMarkerPrefix();
+
+            auto result = ptr->process(stub_, cq, *backend_, abort, cacheOnly);
+            if (result != etl::impl::AsyncCallData::CallStatus::MORE) {
+                ++numFinished;
+                LOG(log_.debug()) << "Finished a marker. Current number of finished on this queue = " << numFinished;
+
+                if (auto lastKey = ptr->getLastKey(); !lastKey.empty())
+                    edgeKeys.lock()->push_back(std::move(lastKey));
+            }
+
+            if (result == etl::impl::AsyncCallData::CallStatus::ERRORED)
+                abort = true;
+
+            auto const cacheSize = backend_->cache().size();
+            auto current = progress.load();
+            if (cacheSize > current && progress.compare_exchange_strong(current, current + incr))
+                LOG(log_.info()) << "Downloaded " << cacheSize << " records from rippled";
         }
+    };
 
-        LOG(log_.trace()) << "Marker prefix = " << ptr->getMarkerPrefix();
-
-        auto result = ptr->process(stub_, cq, *backend_, abort, cacheOnly);
-        if (result != etl::impl::AsyncCallData::CallStatus::MORE) {
-            ++numFinished;
-            LOG(log_.debug()) << "Finished a marker. Current number of finished = " << numFinished;
-
-            if (auto lastKey = ptr->getLastKey(); !lastKey.empty())
-                edgeKeys.push_back(std::move(lastKey));
-        }
-
-        if (result == etl::impl::AsyncCallData::CallStatus::ERRORED)
-            abort = true;
-
-        if (backend_->cache().size() > progress) {
-            LOG(log_.info()) << "Downloaded " << backend_->cache().size() << " records from rippled";
-            progress += incr;
-        }
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i) {
+        auto const numCalls = (calls.size() / numThreads) + (i < calls.size() % numThreads ? 1 : 0);
+        threads.emplace_back(drain, std::ref(queues[i]), numCalls);
     }
 
+    for (auto& thread : threads)
+        thread.join();
+
     LOG(log_.info()) << "Finished loadInitialLedger. cache size = " << backend_->cache().size() << ", abort = " << abort
                      << ".";
-    return {std::move(edgeKeys), !abort};
+    return {std::move(*edgeKeys.lock()), !abort};
 }
 
 }  // namespace etl::impl
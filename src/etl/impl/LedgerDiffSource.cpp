@@ -0,0 +1,324 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/LedgerDiffSource.hpp"
+
+#include "data/Types.hpp"
+#include "etl/LedgerDiffSourceInterface.hpp"
+#include "rpc/JS.hpp"
+#include "util/LedgerUtils.hpp"
+#include "util/Retry.hpp"
+#include "util/log/Logger.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+#include "util/requests/Types.hpp"
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_future.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <fmt/core.h>
+#include <xrpl/basics/Slice.h>
+#include <xrpl/basics/StringUtilities.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/digest.h>
+#include <xrpl/protocol/jss.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace etl::impl {
+
+namespace {
+
+data::Blob
+unhex(boost::json::value const& value)
+{
+    auto const& str = value.as_string();
+    auto blob = ripple::strUnHex(str.size(), str.begin(), str.end());
+    if (not blob.has_value())
+        throw std::runtime_error("Invalid hex string in ledger diff");
+
+    return std::move(blob).value();
+}
+
+std::string
+passwordSha256(std::string const& password)
+{
+    ripple::sha256_hasher hasher;
+    hasher(password.data(), password.size());
+    auto const digest = static_cast<ripple::sha256_hasher::result_type>(hasher);
+
+    ripple::uint256 sha256;
+    std::memcpy(sha256.data(), digest.data(), digest.size());
+    return ripple::to_string(sha256);
+}
+
+}  // namespace
+
+LedgerDiffSource::LedgerDiffSource(
+    boost::asio::io_context& ioContext,
+    std::string const& ip,
+    std::string const& wsPort,
+    std::optional<std::string> const& adminPassword,
+    std::chrono::steady_clock::duration const wsTimeout,
+    std::chrono::steady_clock::duration const retryDelay,
+    std::chrono::steady_clock::duration const waitForDiff
+)
+    : log_(fmt::format("LedgerDiffSource[{}:{}]", ip, wsPort))
+    , wsConnectionBuilder_(ip, wsPort)
+    , strand_(boost::asio::make_strand(ioContext))
+    , wsTimeout_(wsTimeout)
+    , waitForDiff_(waitForDiff)
+    , retry_(util::makeRetryExponentialBackoff(retryDelay, RETRY_MAX_DELAY, strand_))
+    , receivedCounter_(PrometheusService::counterInt(
+          "etl_ledger_diff_total_number",
+          util::prometheus::Labels({{"result", "received"}}),
+          "Total number of ledger diffs received from the writing Clio node"
+      ))
+    , usedCounter_(PrometheusService::counterInt(
+          "etl_ledger_diff_total_number",
+          util::prometheus::Labels({{"result", "used"}}),
+          "Total number of ledgers applied from a received diff"
+      ))
+    , missedCounter_(PrometheusService::counterInt(
+          "etl_ledger_diff_total_number",
+          util::prometheus::Labels({{"result", "missed"}}),
+          "Total number of ledgers read from the database because their diff was not received"
+      ))
+{
+    wsConnectionBuilder_.addHeader({boost::beast::http::field::user_agent, "clio-client"})
+        .addHeader({"X-User", "clio-client"})
+        .setConnectionTimeout(wsTimeout_);
+
+    if (adminPassword.has_value()) {
+        wsConnectionBuilder_.addHeader(
+            {boost::beast::http::field::authorization, fmt::format("Password {}", passwordSha256(*adminPassword))}
+        );
+    }
+}
+
+LedgerDiffSource::~LedgerDiffSource()
+{
+    stop();
+    retry_.cancel();
+
+    if (runFuture_.valid())
+        runFuture_.wait();
+}
+
+void
+LedgerDiffSource::run()
+{
+    subscribe();
+}
+
+void
+LedgerDiffSource::stop()
+{
+    stop_ = true;
+}
+
+bool
+LedgerDiffSource::isConnected() const
+{
+    return isConnected_;
+}
+
+bool
+LedgerDiffSource::isExpected(std::uint32_t sequence)
+{
+    std::scoped_lock const lock{mtx_};
+    if (not isConnected_ or (not diffs_.empty() and diffs_.rbegin()->first >= sequence))
+        return false;
+
+    auto const now = std::chrono::steady_clock::now();
+    if (not awaited_.has_value() or awaited_->first != sequence)
+        awaited_.emplace(sequence, now + waitForDiff_);
+
+    return now < awaited_->second;
+}
+
+std::optional<LedgerDiff>
+LedgerDiffSource::take(std::uint32_t sequence)
+{
+    std::scoped_lock const lock{mtx_};
+
+    std::optional<LedgerDiff> diff;
+    if (auto it = diffs_.find(sequence); it != diffs_.end()) {
+        diff = std::move(it->second);
+        ++usedCounter_.get();
+    } else {
+        ++missedCounter_.get();
+    }
+
+    diffs_.erase(diffs_.begin(), diffs_.upper_bound(sequence));
+    return diff;
+}
+
+std::optional<LedgerDiff>
+LedgerDiffSource::parse(std::string const& message)
+{
+    static constexpr char const* const JS_LedgerDiff = "ledgerDiff";
+
+    auto const raw = boost::json::parse(message);
+    auto const& object = raw.as_object();
+    if (not object.contains(JS(type)) or object.at(JS(type)) != JS_LedgerDiff)
+        return std::nullopt;
+
+    auto const header = unhex(object.at(JS(ledger_data)));
+    LedgerDiff diff{.header = ::util::deserializeHeader(ripple::makeSlice(header))};
+
+    auto const& objects = object.at("objects").as_array();
+    diff.objects.reserve(objects.size());
+    for (auto const& item : objects) {
+        auto const& jsonObject = item.as_object();
+        auto const& key = jsonObject.at(JS(index)).as_string();
+
+        data::LedgerObject ledgerObject;
+        if (not ledgerObject.key.parseHex(std::string_view{key.data(), key.size()}))
+            throw std::runtime_error("Invalid object key in ledger diff");
+
+        ledgerObject.blob = unhex(jsonObject.at(JS(data)));
+        diff.objects.push_back(std::move(ledgerObject));
+    }
+
+    auto const& transactions = object.at(JS(transactions)).as_array();
+    diff.transactions.reserve(transactions.size());
+    for (auto const& item : transactions) {
+        auto const& jsonTransaction = item.as_object();
+        diff.transactions.emplace_back(
+            unhex(jsonTransaction.at(JS(tx_blob))),
+            unhex(jsonTransaction.at(JS(meta))),
+            diff.header.seq,
+            diff.header.closeTime.time_since_epoch().count()
+        );
+    }
+
+    return diff;
+}
+
+void
+LedgerDiffSource::subscribe()
+{
+    runFuture_ = boost::asio::spawn(
+        strand_,
+        [this, _ = boost::asio::make_work_guard(strand_)](boost::asio::yield_context yield) {
+            auto connection = wsConnectionBuilder_.connect(yield);
+            if (not connection) {
+                handleError(connection.error(), yield);
+                return;
+            }
+
+            wsConnection_ = std::move(connection).value();
+
+            static std::string const subscribeCommand = boost::json::serialize(boost::json::object{
+                {"command", "subscribe"},
+                {"streams", boost::json::array{"ledger_diff"}},
+            });
+            auto const writeErrorOpt = wsConnection_->write(subscribeCommand, yield, wsTimeout_);
+            if (writeErrorOpt) {
+                handleError(writeErrorOpt.value(), yield);
+                return;
+            }
+
+            isConnected_ = true;
+            LOG(log_.info()) << "Connected";
+
+            retry_.reset();
+
+            while (!stop_) {
+                auto const message = wsConnection_->read(yield, wsTimeout_);
+                if (not message) {
+                    handleError(message.error(), yield);
+                    return;
+                }
+
+                try {
+                    if (auto diff = parse(message.value()); diff.has_value()) {
+                        LOG(log_.trace()) << "Received diff of ledger " << diff->header.seq;
+                        store(std::move(diff).value());
+                    } else {
+                        LOG(log_.debug()) << "Ignoring message: " << message.value();
+                    }
+                } catch (std::exception const& e) {
+                    handleError(
+                        util::requests::RequestError{fmt::format("Error handling message: {}", e.what())}, yield
+                    );
+                    return;
+                }
+            }
+
+            handleError(
+                util::requests::RequestError{"Ledger diff source stopped", boost::asio::error::operation_aborted},
+                yield
+            );
+        },
+        boost::asio::use_future
+    );
+}
+
+void
+LedgerDiffSource::store(LedgerDiff diff)
+{
+    {
+        std::scoped_lock const lock{mtx_};
+        diffs_.insert_or_assign(diff.header.seq, std::move(diff));
+        while (diffs_.size() > MAX_DIFFS)
+            diffs_.erase(diffs_.begin());
+    }
+
+    ++receivedCounter_.get();
+}
+
+void
+LedgerDiffSource::handleError(util::requests::RequestError const& error, boost::asio::yield_context yield)
+{
+    isConnected_ = false;
+
+    if (wsConnection_ != nullptr) {
+        wsConnection_->close(yield);
+        wsConnection_.reset();
+    }
+
+    if (stop_) {
+        LOG(log_.info()) << error.message();
+        return;
+    }
+
+    LOG(log_.warn()) << "Disconnected: " << error.message();
+    retry_.retry([this] { subscribe(); });
+}
+
+}  // namespace etl::impl
@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "etl/LedgerDiffSourceInterface.hpp"
+#include "util/Retry.hpp"
+#include "util/log/Logger.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/requests/Types.hpp"
+#include "util/requests/WsConnection.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace etl::impl {
+
+/**
+ * @brief Receives the ledger diffs the writing Clio node publishes on its `ledger_diff` stream.
+ *
+ * Read-only nodes use the diffs to update their cache and publish ledgers without reading them from the database.
+ * Only the most recent diffs are kept; a ledger whose diff was lost (e.g. while reconnecting) is simply read from the
+ * database by the caller.
+ */
+class LedgerDiffSource : public LedgerDiffSourceInterface {
+    util::Logger log_;
+    util::requests::WsConnectionBuilder wsConnectionBuilder_;
+    util::requests::WsConnectionPtr wsConnection_;
+
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+
+    std::chrono::steady_clock::duration wsTimeout_;
+    std::chrono::steady_clock::duration waitForDiff_;
+
+    util::Retry retry_;
+
+    std::mutex mtx_;
+    std::map<std::uint32_t, LedgerDiff> diffs_;
+    std::optional<std::pair<std::uint32_t, std::chrono::steady_clock::time_point>> awaited_;  // ledger and deadline
+
+    std::atomic_bool isConnected_{false};
+    std::atomic_bool stop_{false};
+
+    std::reference_wrapper<util::prometheus::CounterInt> receivedCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> usedCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> missedCounter_;
+
+    std::future<void> runFuture_;
+
+    static constexpr std::size_t MAX_DIFFS = 16;
+    static constexpr std::chrono::seconds WS_TIMEOUT{30};
+    static constexpr std::chrono::milliseconds WAIT_FOR_DIFF{500};
+    static constexpr std::chrono::seconds RETRY_MAX_DELAY{30};
+    static constexpr std::chrono::seconds RETRY_DELAY{1};
+
+public:
+    /**
+     * @brief Construct a new Ledger Diff Source object
+     *
+     * @param ioContext The io_context to use
+     * @param ip The ip address of the writing Clio node
+     * @param wsPort The websocket port of the writing Clio node
+     * @param adminPassword The admin password of the writing Clio node, if it has one
+     * @param wsTimeout A timeout for websocket operations. Defaults to 30 seconds
+     * @param retryDelay The retry delay. Defaults to 1 second
+     * @param waitForDiff How long a diff that was not received yet is expected to arrive. Defaults to 500 milliseconds
+     */
+    LedgerDiffSource(
+        boost::asio::io_context& ioContext,
+        std::string const& ip,
+        std::string const& wsPort,
+        std::optional<std::string> const& adminPassword,
+        std::chrono::steady_clock::duration wsTimeout = WS_TIMEOUT,
+        std::chrono::steady_clock::duration retryDelay = RETRY_DELAY,
+        std::chrono::steady_clock::duration waitForDiff = WAIT_FOR_DIFF
+    );
+
+    /**
+     * @brief Destroy the Ledger Diff Source object
+     *
+     * @note This will block to wait for all the async operations to complete. io_context must be still running
+     */
+    ~LedgerDiffSource() override;
+
+    /**
+     * @brief Connect to the writing Clio node and subscribe to its ledger diff stream
+     */
+    void
+    run();
+
+    /**
+     * @brief Stop the source. The source will complete already scheduled operations but will not schedule new ones
+     */
+    void
+    stop();
+
+    /**
+     * @brief Check if the source is connected
+     *
+     * @return true if the source is connected, false otherwise
+     */
+    bool
+    isConnected() const;
+
+    bool
+    isExpected(std::uint32_t sequence) override;
+
+    std::optional<LedgerDiff>
+    take(std::uint32_t sequence) override;
+
+    /**
+     * @brief Parse a message of the ledger diff stream
+     *
+     * @param message The message
+     * @return The diff; std::nullopt if the message is not a ledger diff
+     */
+    static std::optional<LedgerDiff>
+    parse(std::string const& message);
+
+private:
+    void
+    subscribe();
+
+    void
+    store(LedgerDiff diff);
+
+    void
+    handleError(util::requests::RequestError const& error, boost::asio::yield_context yield);
+};
+
+}  // namespace etl::impl
@@ -38,6 +38,7 @@
 #include <xrpl/protocol/Serializer.h>
 #include <xrpl/protocol/TxMeta.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -55,6 +56,7 @@ struct FormattedTransactionsData {
     std::vector<AccountTransactionsData> accountTxData;
     std::vector<NFTTransactionsData> nfTokenTxData;
     std::vector<NFTsData> nfTokensData;
+    std::vector<data::TransactionAndMetadata> transactions;  // ordered by transaction index, ready to be published
 };
 
 namespace etl::impl {
@@ -102,12 +104,15 @@ public:
      *
      * @param ledger ledger to insert transactions into
      * @param data data extracted from an ETL source
-     * @return The neccessary info to write the account_transactions/account_tx and nft_token_transactions tables
+     * @return The neccessary info to write the account_transactions/account_tx and nft_token_transactions tables and
+     * to publish the transactions
      */
     FormattedTransactionsData
     insertTransactions(ripple::LedgerHeader const& ledger, GetLedgerResponseType& data)
     {
         FormattedTransactionsData result;
+        std::vector<std::pair<std::uint32_t, data::TransactionAndMetadata>> indexedTransactions;
+        indexedTransactions.reserve(data.transactions_list().transactions_size());
 
         for (auto& txn : *(data.mutable_transactions_list()->mutable_transactions())) {
             std::string* raw = txn.mutable_transaction_blob();
@@ -125,6 +130,16 @@ public:
                 result.nfTokensData.push_back(*maybeNFT);
 
             result.accountTxData.emplace_back(txMeta, sttx.getTransactionID());
+            indexedTransactions.emplace_back(
+                txMeta.getIndex(),
+                data::TransactionAndMetadata{
+                    {raw->begin(), raw->end()},
+                    {txn.metadata_blob().begin(), txn.metadata_blob().end()},
+                    ledger.seq,
+                    ledger.closeTime.time_since_epoch().count()
+                }
+            );
+
             static constexpr std::size_t KEY_SIZE = 32;
             std::string keyStr{reinterpret_cast<char const*>(sttx.getTransactionID().data()), KEY_SIZE};
             backend_->writeTransaction(
@@ -137,6 +152,12 @@ public:
         }
 
         result.nfTokensData = getUniqueNFTsDatas(result.nfTokensData);
+
+        std::ranges::sort(indexedTransactions, {}, [](auto const& item) { return item.first; });
+        result.transactions.reserve(indexedTransactions.size());
+        for (auto& [_, txAndMeta] : indexedTransactions)
+            result.transactions.push_back(std::move(txAndMeta));
+
         return result;
     }
 
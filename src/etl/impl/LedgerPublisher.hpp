@@ -22,6 +22,7 @@
 #include "data/BackendInterface.hpp"
 #include "data/DBHelpers.hpp"
 #include "data/Types.hpp"
+#include "etl/LedgerDiffSourceInterface.hpp"
 #include "etl/SystemState.hpp"
 #include "feed/SubscriptionManagerInterface.hpp"
 #include "util/Assert.hpp"
@@ -30,7 +31,10 @@
 #include "util/prometheus/Prometheus.hpp"
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/system/error_code.hpp>
 #include <xrpl/basics/chrono.h>
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/LedgerHeader.h>
@@ -38,9 +42,11 @@
 #include <xrpl/protocol/STObject.h>
 #include <xrpl/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -63,17 +69,25 @@ namespace etl::impl {
  * monitoring processes will not be able to detect if the writer failed. Therefore, publishing each ledger (which
  * includes reading all of the transactions from the database) is done from the application wide asio io_service, and a
  * strand is used to ensure ledgers are published in order.
+ *
+ * The writer already holds the transactions of the ledgers it writes and hands them over directly, so only monitoring
+ * processes read them back from the database. The writer also publishes the whole diff of each ledger on the
+ * `ledger_diff` stream; monitoring processes given a diff source apply the diffs they receive from it and read from the
+ * database only the ledgers whose diff they missed.
  */
 template <typename CacheType>
 class LedgerPublisher {
     util::Logger log_{"ETL"};
 
     boost::asio::strand<boost::asio::io_context::executor_type> publishStrand_;
+    boost::asio::steady_timer diffTimer_;
+    std::deque<std::pair<ripple::LedgerHeader, std::optional<LedgerDiff>>> pending_;  // only accessed on the strand
 
     std::shared_ptr<BackendInterface> backend_;
     std::reference_wrapper<CacheType> cache_;
     std::shared_ptr<feed::SubscriptionManagerInterface> subscriptions_;
     std::reference_wrapper<SystemState const> state_;  // shared state for ETL
+    std::shared_ptr<LedgerDiffSourceInterface> diffSource_;
 
     std::chrono::time_point<ripple::NetClock> lastCloseTime_;
     mutable std::shared_mutex closeTimeMtx_;
@@ -87,6 +101,8 @@ class LedgerPublisher {
     std::optional<uint32_t> lastPublishedSequence_;
     mutable std::shared_mutex lastPublishedSeqMtx_;
 
+    static constexpr std::chrono::milliseconds DIFF_CHECK_INTERVAL{10};
+
 public:
     /**
      * @brief Create an instance of the publisher
@@ -96,13 +112,16 @@ public:
         std::shared_ptr<BackendInterface> backend,
         CacheType& cache,
         std::shared_ptr<feed::SubscriptionManagerInterface> subscriptions,
-        SystemState const& state
+        SystemState const& state,
+        std::shared_ptr<LedgerDiffSourceInterface> diffSource = nullptr
     )
         : publishStrand_{boost::asio::make_strand(ioc)}
+        , diffTimer_{publishStrand_}
         , backend_{std::move(backend)}
         , cache_{cache}
         , subscriptions_{std::move(subscriptions)}
         , state_{std::cref(state)}
+        , diffSource_{std::move(diffSource)}
     {
     }
 
@@ -156,78 +175,37 @@ public:
      * @brief Publish the passed ledger asynchronously.
      *
      * All ledgers are published thru publishStrand_ which ensures that all publishes are performed in a serial fashion.
+     * The transactions of the ledger are read from the database.
      *
      * @param lgrInfo the ledger to publish
      */
     void
     publish(ripple::LedgerHeader const& lgrInfo)
     {
-        boost::asio::post(publishStrand_, [this, lgrInfo = lgrInfo]() {
-            LOG(log_.info()) << "Publishing ledger " << std::to_string(lgrInfo.seq);
-
-            if (!state_.get().isWriting) {
-                LOG(log_.info()) << "Updating ledger range for read node.";
-
-                if (!cache_.get().isDisabled()) {
-                    std::vector<data::LedgerObject> const diff = data::synchronousAndRetryOnTimeout([&](auto yield) {
-                        return backend_->fetchLedgerDiff(lgrInfo.seq, yield);
-                    });
-
-                    cache_.get().update(diff, lgrInfo.seq);
-                }
-
-                backend_->updateRange(lgrInfo.seq);
-            }
-
-            setLastClose(lgrInfo.closeTime);
-            auto age = lastCloseAgeSeconds();
-
-            // if the ledger closed over MAX_LEDGER_AGE_SECONDS ago, assume we are still catching up and don't publish
-            // TODO: this probably should be a strategy
-            static constexpr std::uint32_t MAX_LEDGER_AGE_SECONDS = 600;
-            if (age < MAX_LEDGER_AGE_SECONDS) {
-                std::optional<ripple::Fees> fees = data::synchronousAndRetryOnTimeout([&](auto yield) {
-                    return backend_->fetchFees(lgrInfo.seq, yield);
-                });
-                ASSERT(fees.has_value(), "Fees must exist for ledger {}", lgrInfo.seq);
-
-                std::vector<data::TransactionAndMetadata> transactions =
-                    data::synchronousAndRetryOnTimeout([&](auto yield) {
-                        return backend_->fetchAllTransactionsInLedger(lgrInfo.seq, yield);
-                    });
-
-                auto const ledgerRange = backend_->fetchLedgerRange();
-                ASSERT(ledgerRange.has_value(), "Ledger range must exist");
-
-                std::string const range =
-                    std::to_string(ledgerRange->minSequence) + "-" + std::to_string(ledgerRange->maxSequence);
-
-                subscriptions_->pubLedger(lgrInfo, *fees, range, transactions.size());
-
-                // order with transaction index
-                std::sort(transactions.begin(), transactions.end(), [](auto const& t1, auto const& t2) {
-                    ripple::SerialIter iter1{t1.metadata.data(), t1.metadata.size()};
-                    ripple::STObject const object1(iter1, ripple::sfMetadata);
-                    ripple::SerialIter iter2{t2.metadata.data(), t2.metadata.size()};
-                    ripple::STObject const object2(iter2, ripple::sfMetadata);
-                    return object1.getFieldU32(ripple::sfTransactionIndex) <
-                        object2.getFieldU32(ripple::sfTransactionIndex);
-                });
-
-                for (auto& txAndMeta : transactions)
-                    subscriptions_->pubTransaction(txAndMeta, lgrInfo);
-
-                subscriptions_->pubBookChanges(lgrInfo, transactions);
-
-                setLastPublishTime();
-                LOG(log_.info()) << "Published ledger " << std::to_string(lgrInfo.seq);
-            } else {
-                LOG(log_.info()) << "Skipping publishing ledger " << std::to_string(lgrInfo.seq);
-            }
-        });
+        publishAsync(lgrInfo, std::nullopt);
+    }
 
-        // we track latest publish-requested seq, not necessarily already published
-        setLastPublishedSequence(lgrInfo.seq);
+    /**
+     * @brief Publish the passed ledger asynchronously using its diff that is already known to the caller.
+     *
+     * Used by the writer to publish a ledger it just wrote without reading its transactions back from the database.
+     * The diff is also published on the ledger diff stream.
+     *
+     * @param lgrInfo the ledger to publish
+     * @param objects all objects created, modified or deleted by the ledger
+     * @param transactions all transactions of the ledger, ordered by transaction index
+     */
+    void
+    publish(
+        ripple::LedgerHeader const& lgrInfo,
+        std::vector<data::LedgerObject> objects,
+        std::vector<data::TransactionAndMetadata> transactions
+    )
+    {
+        publishAsync(
+            lgrInfo,
+            LedgerDiff{.header = lgrInfo, .objects = std::move(objects), .transactions = std::move(transactions)}
+        );
     }
 
     /**
@@ -277,6 +255,154 @@ public:
     }
 
 private:
+    void
+    publishAsync(ripple::LedgerHeader const& lgrInfo, std::optional<LedgerDiff> writtenDiff)
+    {
+        boost::asio::post(
+            publishStrand_,
+            [this, lgrInfo = lgrInfo, writtenDiff = std::move(writtenDiff)]() mutable {
+                pending_.emplace_back(lgrInfo, std::move(writtenDiff));
+                if (pending_.size() == 1)
+                    publishPending();
+            }
+        );
+
+        // we track latest publish-requested seq, not necessarily already published
+        setLastPublishedSequence(lgrInfo.seq);
+    }
+
+    // runs on publishStrand_
+    void
+    publishPending()
+    {
+        while (not pending_.empty()) {
+            auto const sequence = pending_.front().first.seq;
+
+            // the writer publishes a diff right after it commits the ledger, so a read node that found the ledger in
+            // the database is often just ahead of it; check again shortly rather than blocking the strand
+            if (not state_.get().isWriting and diffSource_ != nullptr and diffSource_->isExpected(sequence)) {
+                diffTimer_.expires_after(DIFF_CHECK_INTERVAL);
+                diffTimer_.async_wait([this](boost::system::error_code const& ec) {
+                    if (not ec)
+                        publishPending();
+                });
+                return;
+            }
+
+            auto [lgrInfo, writtenDiff] = std::move(pending_.front());
+            pending_.pop_front();
+            doPublish(lgrInfo, std::move(writtenDiff));
+        }
+    }
+
+    void
+    doPublish(ripple::LedgerHeader const& lgrInfo, std::optional<LedgerDiff> writtenDiff)
+    {
+        LOG(log_.info()) << "Publishing ledger " << std::to_string(lgrInfo.seq);
+
+        std::optional<std::vector<data::TransactionAndMetadata>> knownTransactions;
+        if (writtenDiff.has_value()) {
+            subscriptions_->pubLedgerDiff(lgrInfo, writtenDiff->objects, writtenDiff->transactions);
+            knownTransactions = std::move(writtenDiff->transactions);
+        }
+
+        if (!state_.get().isWriting) {
+            LOG(log_.info()) << "Updating ledger range for read node.";
+
+            auto pushedDiff = takePushedDiff(lgrInfo);
+            if (!cache_.get().isDisabled()) {
+                std::vector<data::LedgerObject> const diff = pushedDiff.has_value()
+                    ? std::move(pushedDiff->objects)
+                    : data::synchronousAndRetryOnTimeout([&](auto yield) {
+                          return backend_->fetchLedgerDiff(lgrInfo.seq, yield);
+                      });
+
+                cache_.get().update(diff, lgrInfo.seq);
+            }
+
+            if (pushedDiff.has_value())
+                knownTransactions = std::move(pushedDiff->transactions);
+
+            backend_->updateRange(lgrInfo.seq);
+        }
+
+        setLastClose(lgrInfo.closeTime);
+        auto age = lastCloseAgeSeconds();
+
+        // if the ledger closed over MAX_LEDGER_AGE_SECONDS ago, assume we are still catching up and don't
+        // publish
+        // TODO: this probably should be a strategy
+        static constexpr std::uint32_t MAX_LEDGER_AGE_SECONDS = 600;
+        if (age < MAX_LEDGER_AGE_SECONDS) {
+            std::optional<ripple::Fees> fees = data::synchronousAndRetryOnTimeout([&](auto yield) {
+                return backend_->fetchFees(lgrInfo.seq, yield);
+            });
+            ASSERT(fees.has_value(), "Fees must exist for ledger {}", lgrInfo.seq);
+
+            auto const transactions = knownTransactions.has_value()
+                ? std::move(knownTransactions).value()
+                : fetchTransactionsInOrder(lgrInfo.seq);
+
+            auto const ledgerRange = backend_->fetchLedgerRange();
+            ASSERT(ledgerRange.has_value(), "Ledger range must exist");
+
+            std::string const range =
+                std::to_string(ledgerRange->minSequence) + "-" + std::to_string(ledgerRange->maxSequence);
+
+            subscriptions_->pubLedger(lgrInfo, *fees, range, transactions.size());
+
+            for (auto const& txAndMeta : transactions)
+                subscriptions_->pubTransaction(txAndMeta, lgrInfo);
+
+            subscriptions_->pubBookChanges(lgrInfo, transactions);
+
+            setLastPublishTime();
+            LOG(log_.info()) << "Published ledger " << std::to_string(lgrInfo.seq);
+        } else {
+            LOG(log_.info()) << "Skipping publishing ledger " << std::to_string(lgrInfo.seq);
+        }
+    }
+
+    std::optional<LedgerDiff>
+    takePushedDiff(ripple::LedgerHeader const& lgrInfo)
+    {
+        if (diffSource_ == nullptr)
+            return std::nullopt;
+
+        auto diff = diffSource_->take(lgrInfo.seq);
+        if (diff.has_value() and diff->header.hash != lgrInfo.hash) {
+            LOG(log_.warn()) << "Received diff of ledger " << lgrInfo.seq << " does not match the database";
+            return std::nullopt;
+        }
+
+        return diff;
+    }
+
+    std::vector<data::TransactionAndMetadata>
+    fetchTransactionsInOrder(std::uint32_t ledgerSequence) const
+    {
+        auto transactions = data::synchronousAndRetryOnTimeout([&](auto yield) {
+            return backend_->fetchAllTransactionsInLedger(ledgerSequence, yield);
+        });
+
+        // parse every metadata once rather than on every comparison
+        std::vector<std::pair<std::uint32_t, data::TransactionAndMetadata>> indexed;
+        indexed.reserve(transactions.size());
+        for (auto& txAndMeta : transactions) {
+            ripple::SerialIter iter{txAndMeta.metadata.data(), txAndMeta.metadata.size()};
+            ripple::STObject const meta(iter, ripple::sfMetadata);
+            indexed.emplace_back(meta.getFieldU32(ripple::sfTransactionIndex), std::move(txAndMeta));
+        }
+
+        std::ranges::sort(indexed, {}, [](auto const& item) { return item.first; });
+
+        transactions.clear();
+        for (auto& [_, txAndMeta] : indexed)
+            transactions.push_back(std::move(txAndMeta));
+
+        return transactions;
+    }
+
     void
     setLastClose(std::chrono::time_point<ripple::NetClock> lastCloseTime)
     {
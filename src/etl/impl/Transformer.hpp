@@ -22,13 +22,16 @@
 #include "data/BackendInterface.hpp"
 #include "data/DBHelpers.hpp"
 #include "data/Types.hpp"
+#include "etl/ETLHelpers.hpp"
 #include "etl/SystemState.hpp"
 #include "etl/impl/AmendmentBlockHandler.hpp"
 #include "etl/impl/LedgerLoader.hpp"
 #include "util/Assert.hpp"
 #include "util/LedgerUtils.hpp"
-#include "util/Profiler.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Histogram.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 
 #include <grpcpp/grpcpp.h>
 #include <xrpl/basics/base_uint.h>
@@ -38,11 +41,11 @@
 #include <xrpl/protocol/LedgerHeader.h>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
-#include <set>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -60,7 +63,17 @@ namespace etl::impl {
  */
 
 /**
- * @brief Transformer thread that prepares new ledger out of raw data from GRPC.
+ * @brief Transformer that prepares new ledgers out of raw data from GRPC and writes them to the DB.
+ *
+ * The work is split into two pipelined stages that run on their own threads:
+ * - prepare: parses the ledger, updates the cache, derives the successors, account_tx and NFT data and issues the
+ *   corresponding writes;
+ * - commit: writes the ledger header, waits for all writes of the ledger to finish and publishes the ledger along with
+ *   its already parsed objects and transactions, so neither this publisher nor the ones of read-only nodes have to read
+ *   them back from the DB.
+ *
+ * This way ledger N+1 is prepared while the writes of ledger N are being committed. Both stages handle ledgers strictly
+ * in order, so the cache is updated and ledgers are published in ledger order just like before.
  */
 template <
     typename DataPipeType,
@@ -71,6 +84,22 @@ class Transformer {
     using GetLedgerResponseType = typename LedgerLoaderType::GetLedgerResponseType;
     using RawLedgerObjectType = typename LedgerLoaderType::RawLedgerObjectType;
 
+    /** @brief A ledger whose data is written, waiting to be committed */
+    struct PreparedLedger {
+        ripple::LedgerHeader lgrInfo;
+        std::string rawHeader;
+        std::size_t numTxns = 0;
+        std::size_t numObjects = 0;
+        std::vector<data::LedgerObject> objects;
+        std::vector<data::TransactionAndMetadata> transactions;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point ready;
+    };
+
+    // the number of prepared ledgers that may wait for the commit stage; keeps the prepare stage at most a couple of
+    // ledgers ahead of the database
+    static constexpr std::uint32_t MAX_PREPARED_LEDGERS = 1;
+
     util::Logger log_{"ETL"};
 
     std::reference_wrapper<DataPipeType> pipe_;
@@ -82,13 +111,22 @@ class Transformer {
     uint32_t startSequence_;
     std::reference_wrapper<SystemState> state_;  // shared state for ETL
 
+    // empty optional tells the commit stage that no more ledgers will be prepared
+    ThreadSafeQueue<std::optional<PreparedLedger>> preparedLedgers_{MAX_PREPARED_LEDGERS};
+
+    std::reference_wrapper<util::prometheus::HistogramInt> objectsStageDuration_;
+    std::reference_wrapper<util::prometheus::HistogramInt> transactionsStageDuration_;
+    std::reference_wrapper<util::prometheus::HistogramInt> commitStageDuration_;
+    std::reference_wrapper<util::prometheus::HistogramInt> commitWaitDuration_;
+
     std::thread thread_;
+    std::thread commitThread_;
 
 public:
     /**
      * @brief Create an instance of the transformer.
      *
-     * This spawns a new thread that reads from the data pipe and writes ledgers to the DB using LedgerLoader and
+     * This spawns the threads that read from the data pipe and write ledgers to the DB using LedgerLoader and
      * LedgerPublisher.
      */
     Transformer(
@@ -107,30 +145,61 @@ public:
         , amendmentBlockHandler_{std::ref(amendmentBlockHandler)}
         , startSequence_{startSequence}
         , state_{std::ref(state)}
+        , objectsStageDuration_{makeStageHistogram("objects", "Time spent writing objects and successors of a ledger")}
+        , transactionsStageDuration_{makeStageHistogram("transactions", "Time spent writing transactions of a ledger")}
+        , commitStageDuration_{makeStageHistogram("commit", "Time spent waiting for all writes of a ledger to finish")}
+        , commitWaitDuration_{
+              makeStageHistogram("commit_wait", "Time a prepared ledger spent waiting for the commit stage")
+          }
     {
         thread_ = std::thread([this]() { process(); });
+        commitThread_ = std::thread([this]() { commit(); });
     }
 
     /**
-     * @brief Joins the transformer thread.
+     * @brief Joins the transformer threads.
      */
     ~Transformer()
     {
         if (thread_.joinable())
             thread_.join();
+        if (commitThread_.joinable())
+            commitThread_.join();
     }
 
     /**
-     * @brief Block calling thread until transformer thread exits.
+     * @brief Block calling thread until transformer threads exit.
      */
     void
     waitTillFinished()
     {
         ASSERT(thread_.joinable(), "Transformer thread must be joinable");
         thread_.join();
+        commitThread_.join();
     }
 
 private:
+    static util::prometheus::HistogramInt&
+    makeStageHistogram(std::string stage, std::string description)
+    {
+        static std::vector<std::int64_t> const buckets{1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+        return PrometheusService::histogramInt(
+            "etl_transformer_stage_duration_milliseconds_histogram",
+            util::prometheus::Labels({util::prometheus::Label{"stage", std::move(stage)}}),
+            buckets,
+            std::move(description)
+        );
+    }
+
+    static std::int64_t
+    millisecondsSince(std::chrono::steady_clock::time_point const start)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * @brief The prepare stage.
+     */
     void
     process()
     {
@@ -149,23 +218,57 @@ private:
             if (isStopping())
                 continue;
 
-            auto const start = std::chrono::system_clock::now();
-            auto [lgrInfo, success] = buildNextLedger(*fetchResponse);
+            auto prepared = prepareNextLedger(*fetchResponse);
+            if (not prepared) {
+                LOG(log_.error()) << "Error preparing ledger " << currentSequence - 1;
+                setWriteConflict(true);
+                break;
+            }
+
+            prepared->ready = std::chrono::steady_clock::now();
+            preparedLedgers_.push(std::move(prepared));
+        }
+
+        preparedLedgers_.push(std::nullopt);
+    }
+
+    /**
+     * @brief The commit stage.
+     */
+    void
+    commit()
+    {
+        beast::setCurrentThreadName("ETLService commit");
+
+        while (auto prepared = preparedLedgers_.pop()) {
+            // drain ledgers that were prepared before the conflict was noticed
+            if (hasWriteConflict())
+                continue;
+
+            commitWaitDuration_.get().observe(millisecondsSince(prepared->ready));
+
+            auto const& lgrInfo = prepared->lgrInfo;
+            auto const commitStart = std::chrono::steady_clock::now();
+
+            // the backend commits the ledger that was written last so this must not interleave with other ledgers
+            backend_->startWrites();
+            backend_->writeLedger(lgrInfo, std::move(prepared->rawHeader));
+            auto const success = backend_->finishWrites(lgrInfo.seq);
+
+            commitStageDuration_.get().observe(millisecondsSince(commitStart));
 
             if (success) {
-                auto const numTxns = fetchResponse->transactions_list().transactions_size();
-                auto const numObjects = fetchResponse->ledger_objects().objects_size();
-                auto const end = std::chrono::system_clock::now();
-                auto const duration = ((end - start).count()) / 1000000000.0;
+                auto const duration =
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - prepared->start).count();
 
                 LOG(log_.info()) << "Load phase of ETL. Successfully wrote ledger! Ledger info: "
-                                 << util::toString(lgrInfo) << ". txn count = " << numTxns
-                                 << ". object count = " << numObjects << ". load time = " << duration
-                                 << ". load txns per second = " << numTxns / duration
-                                 << ". load objs per second = " << numObjects / duration;
+                                 << util::toString(lgrInfo) << ". txn count = " << prepared->numTxns
+                                 << ". object count = " << prepared->numObjects << ". load time = " << duration
+                                 << ". load txns per second = " << prepared->numTxns / duration
+                                 << ". load objs per second = " << prepared->numObjects / duration;
 
                 // success is false if the ledger was already written
-                publisher_.get().publish(lgrInfo);
+                publisher_.get().publish(lgrInfo, std::move(prepared->objects), std::move(prepared->transactions));
             } else {
                 LOG(log_.error()) << "Error writing ledger. " << util::toString(lgrInfo);
             }
@@ -175,52 +278,57 @@ private:
     }
 
     /**
-     * @brief Build the next ledger using the previous ledger and the extracted data.
+     * @brief Prepare the next ledger using the previous ledger and the extracted data.
      * @note rawData should be data that corresponds to the ledger immediately following the previous seq.
      *
+     * Writes everything except for the ledger header; the ledger is committed later by the commit stage.
+     *
      * @param rawData Data extracted from an ETL source
-     * @return The newly built ledger and data to write to the database
+     * @return The ledger to commit or an empty optional if the ledger could not be built
      */
-    std::pair<ripple::LedgerHeader, bool>
-    buildNextLedger(GetLedgerResponseType& rawData)
+    std::optional<PreparedLedger>
+    prepareNextLedger(GetLedgerResponseType& rawData)
     {
         LOG(log_.debug()) << "Beginning ledger update";
-        ripple::LedgerHeader lgrInfo = ::util::deserializeHeader(ripple::makeSlice(rawData.ledger_header()));
+        PreparedLedger prepared{
+            .lgrInfo = ::util::deserializeHeader(ripple::makeSlice(rawData.ledger_header())),
+            .rawHeader = std::move(*rawData.mutable_ledger_header()),
+            .numTxns = static_cast<std::size_t>(rawData.transactions_list().transactions_size()),
+            .numObjects = static_cast<std::size_t>(rawData.ledger_objects().objects_size()),
+            .start = std::chrono::steady_clock::now()
+        };
+        auto const& lgrInfo = prepared.lgrInfo;
 
         LOG(log_.debug()) << "Deserialized ledger header. " << ::util::toString(lgrInfo);
-        backend_->startWrites();
-        backend_->writeLedger(lgrInfo, std::move(*rawData.mutable_ledger_header()));
 
         writeSuccessors(lgrInfo, rawData);
         std::optional<FormattedTransactionsData> insertTxResultOp;
+        auto transactionsStart = prepared.start;
         try {
-            updateCache(lgrInfo, rawData);
+            prepared.objects = updateCache(lgrInfo, rawData);
+            objectsStageDuration_.get().observe(millisecondsSince(prepared.start));
 
-            LOG(log_.debug()) << "Inserted/modified/deleted all objects. Number of objects = "
-                              << rawData.ledger_objects().objects_size();
+            LOG(log_.debug()) << "Inserted/modified/deleted all objects. Number of objects = " << prepared.numObjects;
 
+            transactionsStart = std::chrono::steady_clock::now();
             insertTxResultOp.emplace(loader_.get().insertTransactions(lgrInfo, rawData));
         } catch (std::runtime_error const& e) {
             LOG(log_.fatal()) << "Failed to build next ledger: " << e.what();
 
             amendmentBlockHandler_.get().onAmendmentBlock();
-            return {ripple::LedgerHeader{}, false};
+            return std::nullopt;
         }
 
-        LOG(log_.debug()) << "Inserted all transactions. Number of transactions  = "
-                          << rawData.transactions_list().transactions_size();
+        LOG(log_.debug()) << "Inserted all transactions. Number of transactions  = " << prepared.numTxns;
 
         backend_->writeAccountTransactions(std::move(insertTxResultOp->accountTxData));
         backend_->writeNFTs(insertTxResultOp->nfTokensData);
         backend_->writeNFTTransactions(insertTxResultOp->nfTokenTxData);
+        prepared.transactions = std::move(insertTxResultOp->transactions);
+        transactionsStageDuration_.get().observe(millisecondsSince(transactionsStart));
 
-        auto [success, duration] =
-            ::util::timed<std::chrono::duration<double>>([&]() { return backend_->finishWrites(lgrInfo.seq); });
-
-        LOG(log_.debug()) << "Finished writes. Total time: " << std::to_string(duration);
-        LOG(log_.debug()) << "Finished ledger update: " << ::util::toString(lgrInfo);
-
-        return {lgrInfo, success};
+        LOG(log_.debug()) << "Prepared ledger update: " << ::util::toString(lgrInfo);
+        return prepared;
     }
 
     /**
@@ -228,17 +336,14 @@ private:
      *
      * @param lgrInfo Ledger info
      * @param rawData Ledger data from GRPC
+     * @return The objects created, modified or deleted by the ledger
      */
-    void
+    std::vector<data::LedgerObject>
     updateCache(ripple::LedgerHeader const& lgrInfo, GetLedgerResponseType& rawData)
     {
         std::vector<data::LedgerObject> cacheUpdates;
         cacheUpdates.reserve(rawData.ledger_objects().objects_size());
 
-        // TODO change these to unordered_set
-        std::set<ripple::uint256> bookSuccessorsToCalculate;
-        std::set<ripple::uint256> modified;
-
         for (auto& obj : *(rawData.mutable_ledger_objects()->mutable_objects())) {
             auto key = ripple::uint256::fromVoidChecked(obj.key());
             ASSERT(key.has_value(), "Failed to deserialize key from void");
@@ -246,102 +351,26 @@ private:
             cacheUpdates.push_back({*key, {obj.mutable_data()->begin(), obj.mutable_data()->end()}});
             LOG(log_.debug()) << "key = " << ripple::strHex(*key) << " - mod type = " << obj.mod_type();
 
-            if (obj.mod_type() != RawLedgerObjectType::MODIFIED && !rawData.object_neighbors_included()) {
-                LOG(log_.debug()) << "object neighbors not included. using cache";
-
-                if (!backend_->cache().isFull() || backend_->cache().latestLedgerSequence() != lgrInfo.seq - 1)
-                    throw std::logic_error("Cache is not full, but object neighbors were not included");
-
-                auto const blob = obj.mutable_data();
-                auto checkBookBase = false;
-                auto const isDeleted = (blob->size() == 0);
-
-                if (isDeleted) {
-                    auto const old = backend_->cache().get(*key, lgrInfo.seq - 1);
-                    ASSERT(old.has_value(), "Deleted object {} must be in cache", ripple::strHex(*key));
-                    checkBookBase = isBookDir(*key, *old);
-                } else {
-                    checkBookBase = isBookDir(*key, *blob);
-                }
-
-                if (checkBookBase) {
-                    LOG(log_.debug()) << "Is book dir. Key = " << ripple::strHex(*key);
-
-                    auto const bookBase = getBookBase(*key);
-                    auto const oldFirstDir = backend_->cache().getSuccessor(bookBase, lgrInfo.seq - 1);
-                    ASSERT(
-                        oldFirstDir.has_value(),
-                        "Book base must have a successor for lgrInfo.seq - 1 = {}",
-                        lgrInfo.seq - 1
-                    );
-
-                    // We deleted the first directory, or we added a directory prior to the old first
-                    // directory
-                    if ((isDeleted && key == oldFirstDir->key) || (!isDeleted && key < oldFirstDir->key)) {
-                        LOG(log_.debug())
-                            << "Need to recalculate book base successor. base = " << ripple::strHex(bookBase)
-                            << " - key = " << ripple::strHex(*key) << " - isDeleted = " << isDeleted
-                            << " - seq = " << lgrInfo.seq;
-                        bookSuccessorsToCalculate.insert(bookBase);
-                    }
-                }
-            }
-
-            if (obj.mod_type() == RawLedgerObjectType::MODIFIED)
-                modified.insert(*key);
-
             backend_->writeLedgerObject(std::move(*obj.mutable_key()), lgrInfo.seq, std::move(*obj.mutable_data()));
         }
 
-        backend_->cache().update(cacheUpdates, lgrInfo.seq);
+        if (rawData.object_neighbors_included()) {
+            backend_->cache().update(cacheUpdates, lgrInfo.seq);
+            return cacheUpdates;
+        }
 
         // rippled didn't send successor information, so use our cache
-        if (!rawData.object_neighbors_included()) {
-            LOG(log_.debug()) << "object neighbors not included. using cache";
-            if (!backend_->cache().isFull() || backend_->cache().latestLedgerSequence() != lgrInfo.seq)
-                throw std::logic_error("Cache is not full, but object neighbors were not included");
-
-            for (auto const& obj : cacheUpdates) {
-                if (modified.contains(obj.key))
-                    continue;
-
-                auto lb = backend_->cache().getPredecessor(obj.key, lgrInfo.seq);
-                if (!lb)
-                    lb = {data::firstKey, {}};
-
-                auto ub = backend_->cache().getSuccessor(obj.key, lgrInfo.seq);
-                if (!ub)
-                    ub = {data::lastKey, {}};
-
-                if (obj.blob.empty()) {
-                    LOG(log_.debug()) << "writing successor for deleted object " << ripple::strHex(obj.key) << " - "
-                                      << ripple::strHex(lb->key) << " - " << ripple::strHex(ub->key);
-
-                    backend_->writeSuccessor(uint256ToString(lb->key), lgrInfo.seq, uint256ToString(ub->key));
-                } else {
-                    backend_->writeSuccessor(uint256ToString(lb->key), lgrInfo.seq, uint256ToString(obj.key));
-                    backend_->writeSuccessor(uint256ToString(obj.key), lgrInfo.seq, uint256ToString(ub->key));
-
-                    LOG(log_.debug()) << "writing successor for new object " << ripple::strHex(lb->key) << " - "
-                                      << ripple::strHex(obj.key) << " - " << ripple::strHex(ub->key);
-                }
-            }
-
-            for (auto const& base : bookSuccessorsToCalculate) {
-                auto succ = backend_->cache().getSuccessor(base, lgrInfo.seq);
-                if (succ) {
-                    backend_->writeSuccessor(uint256ToString(base), lgrInfo.seq, uint256ToString(succ->key));
+        LOG(log_.debug()) << "object neighbors not included. using cache";
+        if (!backend_->cache().isFull())
+            throw std::logic_error("Cache is not full, but object neighbors were not included");
 
-                    LOG(log_.debug()) << "Updating book successor " << ripple::strHex(base) << " - "
-                                      << ripple::strHex(succ->key);
-                } else {
-                    backend_->writeSuccessor(uint256ToString(base), lgrInfo.seq, uint256ToString(data::lastKey));
+        for (auto const& [key, successor] : backend_->cache().updateAndGetSuccessors(cacheUpdates, lgrInfo.seq)) {
+            LOG(log_.debug()) << "writing successor " << ripple::strHex(key) << " - " << ripple::strHex(successor);
 
-                    LOG(log_.debug()) << "Updating book successor " << ripple::strHex(base) << " - "
-                                      << ripple::strHex(data::lastKey);
-                }
-            }
+            backend_->writeSuccessor(uint256ToString(key), lgrInfo.seq, uint256ToString(successor));
         }
+
+        return cacheUpdates;
     }
 
     /**
@@ -55,6 +55,28 @@ SubscriptionManager::pubBookChanges(
     bookChangesFeed_.pub(lgrInfo, transactions);
 }
 
+void
+SubscriptionManager::subLedgerDiff(SubscriberSharedPtr const& subscriber)
+{
+    ledgerDiffFeed_.sub(subscriber);
+}
+
+void
+SubscriptionManager::unsubLedgerDiff(SubscriberSharedPtr const& subscriber)
+{
+    ledgerDiffFeed_.unsub(subscriber);
+}
+
+void
+SubscriptionManager::pubLedgerDiff(
+    ripple::LedgerHeader const& lgrInfo,
+    std::vector<data::LedgerObject> const& objects,
+    std::vector<data::TransactionAndMetadata> const& transactions
+) const
+{
+    ledgerDiffFeed_.pub(lgrInfo, objects, transactions);
+}
+
 void
 SubscriptionManager::subProposedTransactions(SubscriberSharedPtr const& subscriber)
 {
@@ -207,6 +229,7 @@ SubscriptionManager::report() const
         {"accounts_proposed", proposedTransactionFeed_.accountSubCount()},
         {"books", transactionFeed_.bookSubCount()},
         {"book_changes", bookChangesFeed_.count()},
+        {"ledger_diff", ledgerDiffFeed_.count()},
     };
 }
 
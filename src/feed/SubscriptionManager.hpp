@@ -25,6 +25,7 @@
 #include "feed/Types.hpp"
 #include "feed/impl/BookChangesFeed.hpp"
 #include "feed/impl/ForwardFeed.hpp"
+#include "feed/impl/LedgerDiffFeed.hpp"
 #include "feed/impl/LedgerFeed.hpp"
 #include "feed/impl/ProposedTransactionFeed.hpp"
 #include "feed/impl/TransactionFeed.hpp"
@@ -65,6 +66,7 @@ class SubscriptionManager : public SubscriptionManagerInterface {
     impl::ForwardFeed validationsFeed_;
     impl::LedgerFeed ledgerFeed_;
     impl::BookChangesFeed bookChangesFeed_;
+    impl::LedgerDiffFeed ledgerDiffFeed_;
     impl::TransactionFeed transactionFeed_;
     impl::ProposedTransactionFeed proposedTransactionFeed_;
 
@@ -103,6 +105,7 @@ public:
         , validationsFeed_(ctx_, "validations")
         , ledgerFeed_(ctx_)
         , bookChangesFeed_(ctx_)
+        , ledgerDiffFeed_(ctx_)
         , transactionFeed_(ctx_)
         , proposedTransactionFeed_(ctx_)
     {
@@ -140,6 +143,33 @@ public:
     pubBookChanges(ripple::LedgerHeader const& lgrInfo, std::vector<data::TransactionAndMetadata> const& transactions)
         const final;
 
+    /**
+     * @brief Subscribe to the ledger diff feed.
+     * @param subscriber
+     */
+    void
+    subLedgerDiff(SubscriberSharedPtr const& subscriber) final;
+
+    /**
+     * @brief Unsubscribe to the ledger diff feed.
+     * @param subscriber
+     */
+    void
+    unsubLedgerDiff(SubscriberSharedPtr const& subscriber) final;
+
+    /**
+     * @brief Publish the ledger diff feed.
+     * @param lgrInfo The current ledger header.
+     * @param objects The objects created, modified or deleted by the current ledger.
+     * @param transactions The transactions in the current ledger, ordered by transaction index.
+     */
+    void
+    pubLedgerDiff(
+        ripple::LedgerHeader const& lgrInfo,
+        std::vector<data::LedgerObject> const& objects,
+        std::vector<data::TransactionAndMetadata> const& transactions
+    ) const final;
+
     /**
      * @brief Subscribe to the proposed transactions feed.
      * @param subscriber
@@ -68,6 +68,33 @@ public:
     pubBookChanges(ripple::LedgerHeader const& lgrInfo, std::vector<data::TransactionAndMetadata> const& transactions)
         const = 0;
 
+    /**
+     * @brief Subscribe to the ledger diff feed.
+     * @param subscriber
+     */
+    virtual void
+    subLedgerDiff(SubscriberSharedPtr const& subscriber) = 0;
+
+    /**
+     * @brief Unsubscribe to the ledger diff feed.
+     * @param subscriber
+     */
+    virtual void
+    unsubLedgerDiff(SubscriberSharedPtr const& subscriber) = 0;
+
+    /**
+     * @brief Publish the ledger diff feed.
+     * @param lgrInfo The current ledger header.
+     * @param objects The objects created, modified or deleted by the current ledger.
+     * @param transactions The transactions in the current ledger, ordered by transaction index.
+     */
+    virtual void
+    pubLedgerDiff(
+        ripple::LedgerHeader const& lgrInfo,
+        std::vector<data::LedgerObject> const& objects,
+        std::vector<data::TransactionAndMetadata> const& transactions
+    ) const = 0;
+
     /**
      * @brief Subscribe to the proposed transactions feed.
      * @param subscriber
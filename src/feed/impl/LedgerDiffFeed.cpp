@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "feed/impl/LedgerDiffFeed.hpp"
+
+#include "data/Types.hpp"
+#include "feed/impl/SingleFeedBase.hpp"
+#include "rpc/JS.hpp"
+#include "rpc/RPCHelpers.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <xrpl/basics/strHex.h>
+#include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/jss.h>
+
+#include <utility>
+#include <vector>
+
+namespace feed::impl {
+
+void
+LedgerDiffFeed::pub(
+    ripple::LedgerHeader const& lgrInfo,
+    std::vector<data::LedgerObject> const& objects,
+    std::vector<data::TransactionAndMetadata> const& transactions
+) const
+{
+    // the message carries a whole ledger; don't build it for nobody
+    if (count() == 0)
+        return;
+
+    SingleFeedBase::pub(boost::json::serialize(makeLedgerDiffPubMessage(lgrInfo, objects, transactions)));
+}
+
+boost::json::object
+LedgerDiffFeed::makeLedgerDiffPubMessage(
+    ripple::LedgerHeader const& lgrInfo,
+    std::vector<data::LedgerObject> const& objects,
+    std::vector<data::TransactionAndMetadata> const& transactions
+)
+{
+    boost::json::array jsonObjects;
+    jsonObjects.reserve(objects.size());
+    for (auto const& object : objects) {
+        jsonObjects.push_back(boost::json::object{
+            {JS(index), ripple::strHex(object.key)},
+            {JS(data), ripple::strHex(object.blob)},
+        });
+    }
+
+    boost::json::array jsonTransactions;
+    jsonTransactions.reserve(transactions.size());
+    for (auto const& txAndMeta : transactions) {
+        jsonTransactions.push_back(boost::json::object{
+            {JS(tx_blob), ripple::strHex(txAndMeta.transaction)},
+            {JS(meta), ripple::strHex(txAndMeta.metadata)},
+        });
+    }
+
+    boost::json::object pubMsg;
+    pubMsg[JS(type)] = "ledgerDiff";
+    pubMsg[JS(ledger_index)] = lgrInfo.seq;
+    pubMsg[JS(ledger_hash)] = ripple::strHex(lgrInfo.hash);
+    pubMsg[JS(ledger_data)] = ripple::strHex(rpc::ledgerHeaderToBlob(lgrInfo, true));
+    pubMsg["objects"] = std::move(jsonObjects);
+    pubMsg[JS(transactions)] = std::move(jsonTransactions);
+    return pubMsg;
+}
+
+}  // namespace feed::impl
@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "feed/impl/SingleFeedBase.hpp"
+#include "util/async/AnyExecutionContext.hpp"
+
+#include <boost/json/object.hpp>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <vector>
+
+namespace feed::impl {
+
+/**
+ * @brief Feed that publishes everything a read-only Clio needs to apply a ledger without reading it from the database.
+ *
+ * It is meant for Clio nodes that do not write: the ledger header, the objects created, modified or deleted by the
+ * ledger (deleted objects have empty data) and the transactions of the ledger, ordered by transaction index. All blobs
+ * are hex encoded. Nothing is serialized while there are no subscribers.
+ *  Example : {'type': 'ledgerDiff', 'ledger_index': 2647936, 'ledger_hash':
+ * '0A5010342D8AAFABDCA58A68F6F588E1C6E58C21B63ED6CA8DB2478F58F3ECD5', 'ledger_data': '...', 'objects': [{'index':
+ * '...', 'data': '...'}], 'transactions': [{'tx_blob': '...', 'meta': '...'}]}
+ */
+class LedgerDiffFeed : public SingleFeedBase {
+public:
+    /**
+     * @brief Construct a new Ledger Diff Feed object
+     * @param executionCtx The actual publish will be called in the strand of this.
+     */
+    LedgerDiffFeed(util::async::AnyExecutionContext& executionCtx) : SingleFeedBase(executionCtx, "ledger_diff")
+    {
+    }
+
+    /**
+     * @brief Publishes the ledger diff feed.
+     * @param lgrInfo The ledger header.
+     * @param objects The objects created, modified or deleted by the ledger.
+     * @param transactions The transactions of the ledger, ordered by transaction index.
+     */
+    void
+    pub(ripple::LedgerHeader const& lgrInfo,
+        std::vector<data::LedgerObject> const& objects,
+        std::vector<data::TransactionAndMetadata> const& transactions) const;
+
+    /**
+     * @brief Build the message published on the ledger diff feed.
+     * @param lgrInfo The ledger header.
+     * @param objects The objects created, modified or deleted by the ledger.
+     * @param transactions The transactions of the ledger, ordered by transaction index.
+     * @return The message.
+     */
+    static boost::json::object
+    makeLedgerDiffPubMessage(
+        ripple::LedgerHeader const& lgrInfo,
+        std::vector<data::LedgerObject> const& objects,
+        std::vector<data::TransactionAndMetadata> const& transactions
+    );
+};
+}  // namespace feed::impl
@@ -21,6 +21,7 @@
 
 #include "rpc/JS.hpp"
 #include "rpc/WorkQueue.hpp"
+#include "util/Assert.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
@@ -28,9 +29,11 @@
 #include <fmt/core.h>
 #include <xrpl/protocol/jss.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <functional>
-#include <mutex>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -40,7 +43,8 @@ using util::prometheus::Label;
 using util::prometheus::Labels;
 
 Counters::MethodInfo::MethodInfo(std::string const& method)
-    : started(PrometheusService::counterInt(
+    : method(method)
+    , started(PrometheusService::counterInt(
           "rpc_method_total_number",
           Labels{{{"status", "started"}, {"method", method}}},
           fmt::format("Total number of started calls to the method {}", method)
@@ -81,11 +85,34 @@ Counters::MethodInfo::MethodInfo(std::string const& method)
 Counters::MethodInfo&
 Counters::getMethodInfo(std::string const& method)
 {
-    auto it = methodInfo_.find(method);
-    if (it == methodInfo_.end()) {
-        it = methodInfo_.emplace(method, MethodInfo(method)).first;
+    if (auto const [_, info] = findMethod(method); info != nullptr)
+        return *info;
+
+    auto methods = methods_.lock();
+
+    // another thread may have added the method since the lookup above; slots are only filled under this lock
+    auto const [slot, info] = findMethod(method);
+    if (info != nullptr)
+        return *info;
+
+    auto& newInfo = *methods->emplace_back(std::make_unique<MethodInfo>(method));
+    slot->store(&newInfo, std::memory_order_release);
+    return newInfo;
+}
+
+std::pair<Counters::MethodSlot*, Counters::MethodInfo*>
+Counters::findMethod(std::string const& method)
+{
+    auto const start = std::hash<std::string>{}(method);
+    for (std::size_t i = 0; i < METHOD_TABLE_SIZE; ++i) {
+        auto& slot = methodTable_[(start + i) % METHOD_TABLE_SIZE];
+        auto* info = slot.load(std::memory_order_acquire);
+        if (info == nullptr || info->method == method)
+            return {&slot, info};
     }
-    return it->second;
+
+    ASSERT(false, "Too many RPC methods to keep counters for: {}", method);
+    std::unreachable();
 }
 
 Counters::Counters(WorkQueue const& wq)
@@ -122,7 +149,6 @@ Counters::Counters(WorkQueue const& wq)
 void
 Counters::rpcFailed(std::string const& method)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.started.get();
     ++counters.failed.get();
@@ -131,7 +157,6 @@ Counters::rpcFailed(std::string const& method)
 void
 Counters::rpcErrored(std::string const& method)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.started.get();
     ++counters.errored.get();
@@ -140,7 +165,6 @@ Counters::rpcErrored(std::string const& method)
 void
 Counters::rpcComplete(std::string const& method, std::chrono::microseconds const& rpcDuration)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.started.get();
     ++counters.finished.get();
@@ -150,7 +174,6 @@ Counters::rpcComplete(std::string const& method, std::chrono::microseconds const
 void
 Counters::rpcForwarded(std::string const& method)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.forwarded.get();
 }
@@ -158,7 +181,6 @@ Counters::rpcForwarded(std::string const& method)
 void
 Counters::rpcFailedToForward(std::string const& method)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.failedForward.get();
 }
@@ -202,23 +224,23 @@ Counters::uptime() const
 boost::json::object
 Counters::report() const
 {
-    std::scoped_lock const lk(mutex_);
     auto obj = boost::json::object{};
 
     obj[JS(rpc)] = boost::json::object{};
     auto& rpc = obj[JS(rpc)].as_object();
 
-    for (auto const& [method, info] : methodInfo_) {
+    auto const methods = methods_.lock();
+    for (auto const& info : *methods) {
         auto counters = boost::json::object{};
-        counters[JS(started)] = std::to_string(info.started.get().value());
-        counters[JS(finished)] = std::to_string(info.finished.get().value());
-        counters[JS(errored)] = std::to_string(info.errored.get().value());
-        counters[JS(failed)] = std::to_string(info.failed.get().value());
-        counters["forwarded"] = std::to_string(info.forwarded.get().value());
-        counters["failed_forward"] = std::to_string(info.failedForward.get().value());
-        counters[JS(duration_us)] = std::to_string(info.duration.get().value());
-
-        rpc[method] = std::move(counters);
+        counters[JS(started)] = std::to_string(info->started.get().value());
+        counters[JS(finished)] = std::to_string(info->finished.get().value());
+        counters[JS(errored)] = std::to_string(info->errored.get().value());
+        counters[JS(failed)] = std::to_string(info->failed.get().value());
+        counters["forwarded"] = std::to_string(info->forwarded.get().value());
+        counters["failed_forward"] = std::to_string(info->failedForward.get().value());
+        counters[JS(duration_us)] = std::to_string(info->duration.get().value());
+
+        rpc[info->method] = std::move(counters);
     }
 
     obj["too_busy_errors"] = std::to_string(tooBusyCounter_.get().value());
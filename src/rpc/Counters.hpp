@@ -20,16 +20,21 @@
 #pragma once
 
 #include "rpc/WorkQueue.hpp"
+#include "util/Mutex.hpp"
 #include "util/prometheus/Counter.hpp"
 
 #include <boost/json.hpp>
 #include <boost/json/object.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <functional>
-#include <mutex>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace rpc {
 
@@ -44,6 +49,7 @@ class Counters {
     struct MethodInfo {
         MethodInfo(std::string const& method);
 
+        std::string method;
         CounterType started;
         CounterType finished;
         CounterType failed;
@@ -53,11 +59,20 @@ class Counters {
         CounterType duration;
     };
 
+    using MethodSlot = std::atomic<MethodInfo*>;
+
+    // RPC methods are looked up on every call. The table is open-addressed and only ever grows, so looking up a
+    // method seen before takes no lock; adding a new method is serialized by the mutex that owns the entries.
+    static constexpr std::size_t METHOD_TABLE_SIZE = 256;
+
+    std::array<MethodSlot, METHOD_TABLE_SIZE> methodTable_{};
+    util::Mutex<std::vector<std::unique_ptr<MethodInfo>>> methods_;
+
     MethodInfo&
     getMethodInfo(std::string const& method);
 
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, MethodInfo> methodInfo_;
+    std::pair<MethodSlot*, MethodInfo*>
+    findMethod(std::string const& method);
 
     // counters that don't carry RPC method information
     CounterType tooBusyCounter_;
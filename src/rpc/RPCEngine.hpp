@@ -22,11 +22,13 @@
 #include "data/BackendInterface.hpp"
 #include "rpc/Errors.hpp"
 #include "rpc/RPCHelpers.hpp"
+#include "rpc/ResponseCache.hpp"
 #include "rpc/WorkQueue.hpp"
 #include "rpc/common/HandlerProvider.hpp"
 #include "rpc/common/Types.hpp"
 #include "rpc/common/impl/ForwardingProxy.hpp"
 #include "util/ResponseExpirationCache.hpp"
+#include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
 #include "web/Context.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
@@ -39,6 +41,7 @@
 #include <xrpl/protocol/ErrorCodes.h>
 
 #include <chrono>
+#include <cstddef>
 #include <exception>
 #include <functional>
 #include <memory>
@@ -69,7 +72,10 @@ class RPCEngine {
 
     impl::ForwardingProxy<LoadBalancerType, CountersType, HandlerProvider> forwardingProxy_;
 
-    std::optional<util::ResponseExpirationCache> responseCache_;
+    std::optional<ResponseCache> responseCache_;
+
+    // `server_info` changes within a ledger, so it is cached for `rpc.cache_timeout` instead of until the next ledger
+    std::optional<util::ResponseExpirationCache> serverInfoCache_;
 
 public:
     /**
@@ -103,12 +109,32 @@ public:
         auto const cacheTimeout = config.valueOr<float>("rpc.cache_timeout", 0.f);
 
         if (cacheTimeout > 0.f) {
-            LOG(log_.info()) << fmt::format("Init RPC Cache, timeout: {} seconds", cacheTimeout);
+            LOG(log_.info()) << fmt::format("Init server_info cache, timeout: {} seconds", cacheTimeout);
 
-            responseCache_.emplace(
+            serverInfoCache_.emplace(
                 util::Config::toMilliseconds(cacheTimeout), std::unordered_set<std::string>{"server_info"}
             );
         }
+
+        auto const cacheSize = config.valueOr<std::size_t>("rpc.cache_size", 0);
+
+        if (cacheSize > 0) {
+            auto const commands = config.arrayOr("rpc.cache_commands", {});
+            auto const transform = [](auto const& elem) { return elem.template value<std::string>(); };
+
+            auto const& defaults = ResponseCache::DEFAULT_COMMANDS;
+            auto const cachedCommands = commands.empty()
+                ? std::unordered_set<std::string>{defaults.begin(), defaults.end()}
+                : std::unordered_set<std::string>{
+                      boost::transform_iterator(std::begin(commands), transform),
+                      boost::transform_iterator(std::end(commands), transform)
+                  };
+
+            LOG(log_.info()) << fmt::format(
+                "Init RPC Cache, size: {} entries, {} cached commands", cacheSize, cachedCommands.size()
+            );
+            responseCache_.emplace(cacheSize, cachedCommands);
+        }
     }
 
     /**
@@ -154,8 +180,19 @@ public:
             return forwardingProxy_.forward(ctx);
         }
 
-        if (not ctx.isAdmin and responseCache_) {
-            if (auto res = responseCache_->get(ctx.method); res.has_value())
+        if (not ctx.isAdmin and serverInfoCache_) {
+            if (auto res = serverInfoCache_->get(ctx.method); res.has_value())
+                return Result{std::move(res).value()};
+        }
+
+        auto const cacheKey = [&]() -> std::optional<ResponseCache::Key> {
+            if (ctx.isAdmin or not responseCache_)
+                return std::nullopt;
+            return responseCache_->makeKey(ctx.method, ctx.params, ctx.apiVersion, ctx.range.maxSequence);
+        }();
+
+        if (cacheKey) {
+            if (auto res = responseCache_->get(*cacheKey, ctx.range.maxSequence); res.has_value())
                 return Result{std::move(res).value()};
         }
 
@@ -181,8 +218,11 @@ public:
 
             if (not v) {
                 notifyErrored(ctx.method);
-            } else if (not ctx.isAdmin and responseCache_) {
-                responseCache_->put(ctx.method, v.result->as_object());
+            } else {
+                if (cacheKey)
+                    responseCache_->put(*cacheKey, ctx.range.maxSequence, v.result->as_object());
+                if (not ctx.isAdmin and serverInfoCache_)
+                    serverInfoCache_->put(ctx.method, v.result->as_object());
             }
 
             return Result{std::move(v)};
@@ -205,13 +245,23 @@ public:
      * @tparam FnType The type of function
      * @param func The lambda to execute when this request is handled
      * @param ip The ip address for which this request is being executed
+     * @param method The method of the request; used to pick the work queue lane
+     * @param isAdmin Whether the request was made by an admin
      * @return true if the request was successfully scheduled; false otherwise
      */
     template <typename FnType>
     bool
-    post(FnType&& func, std::string const& ip)
+    post(FnType&& func, std::string const& ip, std::string const& method, bool isAdmin)
     {
-        return workQueue_.get().postCoro(std::forward<FnType>(func), dosGuard_.get().isWhiteListed(ip));
+        auto const lane = [&] {
+            if (isAdmin)
+                return WorkQueue::Lane::Admin;
+            if (handlerProvider_->isExpensive(method))
+                return WorkQueue::Lane::Expensive;
+            return WorkQueue::Lane::Cheap;
+        }();
+
+        return workQueue_.get().postCoro(std::forward<FnType>(func), dosGuard_.get().isWhiteListed(ip), lane);
     }
 
     /**
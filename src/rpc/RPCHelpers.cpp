@@ -61,6 +61,7 @@
 #include <xrpl/protocol/LedgerFormats.h>
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/NFTSyntheticSerializer.h>
+#include <xrpl/protocol/Protocol.h>
 #include <xrpl/protocol/PublicKey.h>
 #include <xrpl/protocol/Rate.h>
 #include <xrpl/protocol/SField.h>
@@ -653,8 +654,42 @@ traverseOwnedNodes(
 
     auto start = std::chrono::system_clock::now();
 
-    // If startAfter is not zero try jumping to that page using the hint
-    if (hexMarker.isNonZero()) {
+    // The pages come from the owner index of the cache if it has them. The marker is in the first page, so the entries
+    // before it are asked for on top of the limit
+    auto const indexedPages = backend.cache().getOwnerDirPages(
+        rootIndex.key,
+        hexMarker.isNonZero() ? startHint : 0u,
+        sequence,
+        std::size_t{limit} + (hexMarker.isNonZero() ? ripple::dirNodeMaxEntries : 0u)
+    );
+
+    if (indexedPages.has_value()) {
+        // the index specified by marker must be in the page specified by marker
+        if (hexMarker.isNonZero() and
+            (indexedPages->empty() or std::ranges::count(indexedPages->front().entries, hexMarker) == 0))
+            return Status(ripple::rpcINVALID_PARAMS, "Invalid marker.");
+
+        bool found = hexMarker.isZero();
+        for (auto const& page : *indexedPages) {
+            for (auto const& key : page.entries) {
+                if (!found) {
+                    if (key == hexMarker)
+                        found = true;
+                } else {
+                    keys.push_back(key);
+
+                    if (--limit == 0)
+                        break;
+                }
+            }
+
+            if (limit == 0) {
+                cursor = AccountCursor({keys.back(), static_cast<std::uint32_t>(page.number)});
+                break;
+            }
+        }
+    } else if (hexMarker.isNonZero()) {
+        // If startAfter is not zero try jumping to that page using the hint
         auto const hintIndex = ripple::keylet::page(rootIndex, startHint);
         auto hintDir = backend.fetchLedgerObject(hintIndex.key, sequence, yield);
 
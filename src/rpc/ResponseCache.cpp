@@ -0,0 +1,254 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/ResponseCache.hpp"
+
+#include "rpc/JS.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/value.hpp>
+#include <fmt/core.h>
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_set>
+#include <vector>
+
+namespace rpc {
+
+namespace {
+
+// fields that do not change the response; the ledger index is part of the key on its own
+std::unordered_set<std::string_view> const IGNORED_FIELDS = {
+    JS(id),
+    JS(command),
+    JS(method),
+    JS(jsonrpc),
+    JS(ripplerpc),
+    JS(api_version),
+    JS(ledger_index),
+};
+
+boost::json::value
+normalized(boost::json::value const& value);
+
+boost::json::object
+normalized(boost::json::object const& object, bool isTopLevel)
+{
+    std::vector<std::string_view> keys;
+    keys.reserve(object.size());
+    for (auto const& [key, _] : object) {
+        if (not isTopLevel or not IGNORED_FIELDS.contains(std::string_view{key.data(), key.size()}))
+            keys.emplace_back(key.data(), key.size());
+    }
+    std::ranges::sort(keys);
+
+    boost::json::object result;
+    result.reserve(keys.size());
+    for (auto const key : keys)
+        result.emplace(key, normalized(object.at(key)));
+
+    return result;
+}
+
+boost::json::value
+normalized(boost::json::value const& value)
+{
+    if (value.is_object())
+        return normalized(value.as_object(), false);
+
+    if (value.is_array()) {
+        boost::json::array result;
+        result.reserve(value.as_array().size());
+        for (auto const& item : value.as_array())
+            result.push_back(normalized(item));
+
+        return result;
+    }
+
+    return value;
+}
+
+std::optional<std::uint32_t>
+resolveLedgerIndex(boost::json::object const& params, std::uint32_t latestSequence)
+{
+    auto const* index = params.if_contains(JS(ledger_index));
+    if (index == nullptr)
+        return latestSequence;
+
+    if (index->is_string()) {
+        auto const& str = index->as_string();
+        if (str == "validated" or str == "current" or str == "closed")
+            return latestSequence;
+
+        std::uint32_t sequence = 0;
+        auto const [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), sequence);
+        if (ec != std::errc{} or ptr != str.data() + str.size())
+            return std::nullopt;
+
+        return sequence;
+    }
+
+    if (index->is_uint64() and index->as_uint64() <= std::numeric_limits<std::uint32_t>::max())
+        return static_cast<std::uint32_t>(index->as_uint64());
+
+    if (index->is_int64() and index->as_int64() >= 0 and
+        index->as_int64() <= std::numeric_limits<std::uint32_t>::max())
+        return static_cast<std::uint32_t>(index->as_int64());
+
+    return std::nullopt;
+}
+
+}  // namespace
+
+ResponseCache::ResponseCache(std::size_t maxEntries, std::unordered_set<std::string> const& commands)
+    : shardCapacity_{std::max<std::size_t>(maxEntries / NUM_SHARDS, 1)}
+{
+    using util::prometheus::Label;
+    using util::prometheus::Labels;
+
+    for (auto const& command : commands) {
+        counters_.emplace(
+            command,
+            MethodCounters{
+                .hits = PrometheusService::counterInt(
+                    "rpc_response_cache_total_number",
+                    Labels{{Label{"result", "hit"}, Label{"method", command}}},
+                    fmt::format("Total number of calls to the method {} served from the response cache", command)
+                ),
+                .misses = PrometheusService::counterInt(
+                    "rpc_response_cache_total_number",
+                    Labels{{Label{"result", "miss"}, Label{"method", command}}},
+                    fmt::format("Total number of calls to the method {} missing the response cache", command)
+                ),
+            }
+        );
+    }
+}
+
+std::optional<ResponseCache::Key>
+ResponseCache::makeKey(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    std::uint32_t latestSequence
+) const
+{
+    if (not counters_.contains(method))
+        return std::nullopt;
+
+    auto const sequence = resolveLedgerIndex(params, latestSequence);
+    if (not sequence.has_value())
+        return std::nullopt;
+
+    return Key{
+        .method = method,
+        .value = fmt::format(
+            "{}:{}:{}:{}", method, apiVersion, *sequence, boost::json::serialize(normalized(params, true))
+        ),
+    };
+}
+
+std::optional<boost::json::object>
+ResponseCache::get(Key const& key, std::uint32_t latestSequence)
+{
+    advanceTo(latestSequence);
+
+    auto const& counters = counters_.at(key.method);
+    auto const response = [&]() -> std::optional<boost::json::object> {
+        auto const shard = shardFor(key.value).lock<std::shared_lock>();
+        if (auto const it = shard->responses.find(key.value); it != shard->responses.end())
+            return it->second;
+
+        return std::nullopt;
+    }();
+
+    if (response.has_value()) {
+        ++counters.hits.get();
+    } else {
+        ++counters.misses.get();
+    }
+
+    return response;
+}
+
+void
+ResponseCache::put(Key const& key, std::uint32_t latestSequence, boost::json::object const& response)
+{
+    advanceTo(latestSequence);
+    if (latestSequence < latestSequence_)
+        return;
+
+    auto shard = shardFor(key.value).lock<std::unique_lock>();
+    if (auto const [it, inserted] = shard->responses.try_emplace(key.value, response); not inserted) {
+        it->second = response;
+        return;
+    }
+
+    shard->insertionOrder.push_back(key.value);
+    if (shard->insertionOrder.size() > shardCapacity_) {
+        shard->responses.erase(shard->insertionOrder.front());
+        shard->insertionOrder.pop_front();
+    }
+}
+
+void
+ResponseCache::invalidate()
+{
+    for (auto& shard : shards_) {
+        auto entries = shard.lock<std::unique_lock>();
+        entries->responses.clear();
+        entries->insertionOrder.clear();
+    }
+}
+
+void
+ResponseCache::advanceTo(std::uint32_t latestSequence)
+{
+    auto current = latestSequence_.load();
+    while (current < latestSequence) {
+        if (latestSequence_.compare_exchange_weak(current, latestSequence)) {
+            invalidate();
+            return;
+        }
+    }
+}
+
+ResponseCache::Shard&
+ResponseCache::shardFor(std::string const& key)
+{
+    return shards_[std::hash<std::string>{}(key) % NUM_SHARDS];
+}
+
+}  // namespace rpc
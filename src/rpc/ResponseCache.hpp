@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Mutex.hpp"
+#include "util/prometheus/Counter.hpp"
+
+#include <boost/json/object.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace rpc {
+
+/**
+ * @brief Cache of RPC responses keyed by the request rather than only by the command.
+ *
+ * A key is made of the method, the normalized params, the API version and the ledger sequence the request resolves to.
+ * All entries are dropped as soon as a request observes a newer validated ledger, so responses never outlive the
+ * ledger they were computed against. The cache is split into shards, each guarded by its own shared mutex, and every
+ * shard holds at most its share of the configured number of entries; once a shard is full, its oldest entry makes
+ * room for the new one.
+ */
+class ResponseCache {
+public:
+    /** @brief The commands cached when none are configured; their responses only depend on the ledger */
+    static constexpr std::array<std::string_view, 3> DEFAULT_COMMANDS = {"ledger", "book_offers", "account_info"};
+
+    /** @brief Key of a cached response */
+    struct Key {
+        std::string method;
+        std::string value;
+    };
+
+private:
+    static constexpr std::size_t NUM_SHARDS = 16;
+
+    struct Entries {
+        std::unordered_map<std::string, boost::json::object> responses;
+        std::deque<std::string> insertionOrder;
+    };
+
+    using Shard = util::Mutex<Entries, std::shared_mutex>;
+
+    struct MethodCounters {
+        std::reference_wrapper<util::prometheus::CounterInt> hits;
+        std::reference_wrapper<util::prometheus::CounterInt> misses;
+    };
+
+    std::size_t shardCapacity_;
+    std::unordered_map<std::string, MethodCounters> counters_;
+    std::array<Shard, NUM_SHARDS> shards_;
+    std::atomic_uint32_t latestSequence_ = 0;
+
+public:
+    /**
+     * @brief Construct a new ResponseCache object
+     *
+     * @param maxEntries The maximum number of responses kept in the cache
+     * @param commands The commands that should be cached
+     */
+    ResponseCache(std::size_t maxEntries, std::unordered_set<std::string> const& commands);
+
+    /**
+     * @brief Build the cache key of a request.
+     *
+     * The `ledger_index` param is resolved to a sequence and fields that do not affect the response (e.g. `id`) are
+     * dropped, so equivalent requests share the same key.
+     *
+     * @param method The method of the request
+     * @param params The params of the request
+     * @param apiVersion The API version of the request
+     * @param latestSequence The latest validated ledger at the time of the request
+     * @return The key; std::nullopt if the request should not be cached
+     */
+    [[nodiscard]] std::optional<Key>
+    makeKey(
+        std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        std::uint32_t latestSequence
+    ) const;
+
+    /**
+     * @brief Get a response from the cache
+     *
+     * @param key The key of the request
+     * @param latestSequence The latest validated ledger at the time of the request
+     * @return The response if it exists or std::nullopt otherwise
+     */
+    [[nodiscard]] std::optional<boost::json::object>
+    get(Key const& key, std::uint32_t latestSequence);
+
+    /**
+     * @brief Put a response into the cache
+     *
+     * The response is dropped if a newer ledger was observed since the request started. If the shard is full, its
+     * oldest entry is evicted.
+     *
+     * @param key The key of the request
+     * @param latestSequence The latest validated ledger at the time of the request
+     * @param response The response to store
+     */
+    void
+    put(Key const& key, std::uint32_t latestSequence, boost::json::object const& response);
+
+    /**
+     * @brief Invalidate all entries in the cache
+     */
+    void
+    invalidate();
+
+private:
+    void
+    advanceTo(std::uint32_t latestSequence);
+
+    Shard&
+    shardFor(std::string const& key);
+};
+
+}  // namespace rpc
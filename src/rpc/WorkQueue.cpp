@@ -24,16 +24,26 @@
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
+#include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace rpc {
 
+namespace {
+
+std::vector<std::int64_t> const WAIT_BUCKETS_US{100, 500, 1'000, 5'000, 10'000, 50'000, 100'000, 500'000, 1'000'000};
+
+}  // namespace
+
 void
 WorkQueue::OneTimeCallable::setCallable(std::function<void()> func)
 {
@@ -69,12 +79,32 @@ WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize)
           util::prometheus::Labels(),
           "The current number of tasks in the queue"
       )}
+    , laneMetrics_{makeLaneMetrics(Lane::Admin), makeLaneMetrics(Lane::Cheap), makeLaneMetrics(Lane::Expensive)}
     , ioc_{numWorkers}
 {
     if (maxSize != 0)
         maxSize_ = maxSize;
 }
 
+WorkQueue::LaneMetrics
+WorkQueue::makeLaneMetrics(Lane lane)
+{
+    auto const* name = LANE_NAMES[static_cast<std::size_t>(lane)];
+    return {
+        .size = PrometheusService::gaugeInt(
+            "work_queue_lane_current_size",
+            util::prometheus::Labels({util::prometheus::Label{"lane", name}}),
+            "The current number of tasks waiting in a lane of the queue"
+        ),
+        .waitUs = PrometheusService::histogramInt(
+            "work_queue_wait_duration_us_histogram",
+            util::prometheus::Labels({util::prometheus::Label{"lane", name}}),
+            WAIT_BUCKETS_US,
+            "The number of microseconds tasks of a lane were waiting to be executed"
+        )
+    };
+}
+
 WorkQueue::~WorkQueue()
 {
     join();
@@ -113,6 +143,15 @@ WorkQueue::report() const
     obj["current_queue_size"] = curSize_.get().value();
     obj["max_queue_size"] = maxSize_;
 
+    auto lanes = boost::json::object{};
+    for (std::size_t i = 0; i < NUM_LANES; ++i) {
+        lanes[LANE_NAMES[i]] = {
+            {"current_queue_size", laneMetrics_[i].size.get().value()},
+            {"weight", LANE_WEIGHTS[i]},
+        };
+    }
+    obj["lanes"] = std::move(lanes);
+
     return obj;
 }
 
@@ -128,4 +167,68 @@ WorkQueue::size() const
     return curSize_.get().value();
 }
 
+void
+WorkQueue::enqueue(Lane lane, Task task)
+{
+    auto const idx = static_cast<std::size_t>(lane);
+    lanes_.lock()->at(idx).tasks.push_back(std::move(task));
+    ++laneMetrics_[idx].size.get();
+}
+
+void
+WorkQueue::executeNext(boost::asio::yield_context yield)
+{
+    // smooth weighted round robin: every waiting lane earns its weight, the richest one pays for being picked with the
+    // sum of the weights of all waiting lanes
+    auto const [idx, task] = [this] {
+        auto lanes = lanes_.lock();
+
+        std::size_t picked = NUM_LANES;
+        std::int64_t totalWeight = 0;
+        for (std::size_t i = 0; i < NUM_LANES; ++i) {
+            auto& lane = lanes->at(i);
+            if (lane.tasks.empty())
+                continue;
+
+            lane.credit += LANE_WEIGHTS[i];
+            totalWeight += LANE_WEIGHTS[i];
+            if (picked == NUM_LANES or lane.credit > lanes->at(picked).credit)
+                picked = i;
+        }
+
+        // every spawned executor has a task queued before it
+        ASSERT(picked != NUM_LANES, "No task to execute");
+
+        auto& lane = lanes->at(picked);
+        lane.credit -= totalWeight;
+        auto task = std::move(lane.tasks.front());
+        lane.tasks.pop_front();
+
+        // an idle lane starts over once new jobs arrive
+        if (lane.tasks.empty())
+            lane.credit = 0;
+
+        return std::make_pair(picked, std::move(task));
+    }();
+
+    --laneMetrics_[idx].size.get();
+
+    auto const wait =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - task.start).count();
+
+    ++queued_.get();
+    durationUs_.get() += wait;
+    laneMetrics_[idx].waitUs.get().observe(wait);
+    LOG(log_.info()) << "WorkQueue wait time = " << wait << " lane = " << LANE_NAMES[idx]
+                     << " queue size = " << curSize_.get().value();
+
+    task.func(yield);
+    --curSize_.get();
+    if (curSize_.get().value() == 0 && stopping_) {
+        auto onTasksComplete = onQueueEmpty_.lock();
+        ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
+        onTasksComplete->operator()();
+    }
+}
+
 }  // namespace rpc
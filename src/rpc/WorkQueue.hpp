@@ -25,6 +25,7 @@
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/asio/spawn.hpp>
@@ -32,19 +33,58 @@
 #include <boost/json.hpp>
 #include <boost/json/object.hpp>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
+#include <string>
 
 namespace rpc {
 
 /**
  * @brief An asynchronous, thread-safe queue for RPC requests.
+ *
+ * Jobs are queued in one of a few lanes. Whenever a worker is free it takes the next job using weighted round robin
+ * over the lanes that have jobs waiting, so a flood of expensive requests can't hold up cheap or admin requests queued
+ * after it while every lane still makes progress.
  */
 class WorkQueue {
+public:
+    /**
+     * @brief The lanes jobs are scheduled on.
+     */
+    enum class Lane : std::uint8_t { Admin, Cheap, Expensive };
+
+    static constexpr std::size_t NUM_LANES = 3;
+
+    /** @brief Share of the workers each lane gets while all lanes have jobs waiting, indexed by lane */
+    static constexpr std::array<std::uint32_t, NUM_LANES> LANE_WEIGHTS{4, 2, 1};
+
+    /** @brief Names of the lanes as used in the report and the metrics, indexed by lane */
+    static constexpr std::array<char const*, NUM_LANES> LANE_NAMES{"admin", "cheap", "expensive"};
+
+private:
+    using TaskType = std::function<void(boost::asio::yield_context)>;
+
+    struct Task {
+        TaskType func;
+        std::chrono::system_clock::time_point start;
+    };
+
+    struct LaneQueue {
+        std::deque<Task> tasks;
+        std::int64_t credit = 0;
+    };
+
+    struct LaneMetrics {
+        std::reference_wrapper<util::prometheus::GaugeInt> size;
+        std::reference_wrapper<util::prometheus::HistogramInt> waitUs;
+    };
+
     // these are cumulative for the lifetime of the process
     std::reference_wrapper<util::prometheus::CounterInt> queued_;
     std::reference_wrapper<util::prometheus::CounterInt> durationUs_;
@@ -52,6 +92,9 @@ class WorkQueue {
     std::reference_wrapper<util::prometheus::GaugeInt> curSize_;
     uint32_t maxSize_ = std::numeric_limits<uint32_t>::max();
 
+    std::array<LaneMetrics, NUM_LANES> laneMetrics_;
+    util::Mutex<std::array<LaneQueue, NUM_LANES>> lanes_;
+
     util::Logger log_{"RPC"};
     boost::asio::thread_pool ioc_;
 
@@ -107,11 +150,12 @@ public:
      * @tparam FnType The function object type
      * @param func The function object to queue as a job
      * @param isWhiteListed Whether the queue capacity applies to this job
+     * @param lane The lane to schedule the job on
      * @return true if the job was successfully queued; false otherwise
      */
     template <typename FnType>
     bool
-    postCoro(FnType&& func, bool isWhiteListed)
+    postCoro(FnType&& func, bool isWhiteListed, Lane lane = Lane::Cheap)
     {
         if (stopping_) {
             LOG(log_.warn()) << "Queue is stopping, rejecting incoming task.";
@@ -125,28 +169,11 @@ public:
         }
 
         ++curSize_.get();
+        enqueue(lane, Task{.func = std::forward<FnType>(func), .start = std::chrono::system_clock::now()});
 
-        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job at the front
-        // of the job queue.
-        boost::asio::spawn(
-            ioc_,
-            [this, func = std::forward<FnType>(func), start = std::chrono::system_clock::now()](auto yield) mutable {
-                auto const run = std::chrono::system_clock::now();
-                auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - start).count();
-
-                ++queued_.get();
-                durationUs_.get() += wait;
-                LOG(log_.info()) << "WorkQueue wait time = " << wait << " queue size = " << curSize_.get().value();
-
-                func(yield);
-                --curSize_.get();
-                if (curSize_.get().value() == 0 && stopping_) {
-                    auto onTasksComplete = onQueueEmpty_.lock();
-                    ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
-                    onTasksComplete->operator()();
-                }
-            }
-        );
+        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job that is next
+        // in line; not necessarily the one that was just queued.
+        boost::asio::spawn(ioc_, [this](auto yield) { executeNext(yield); });
 
         return true;
     }
@@ -172,6 +199,16 @@ public:
      */
     size_t
     size() const;
+
+private:
+    static LaneMetrics
+    makeLaneMetrics(Lane lane);
+
+    void
+    enqueue(Lane lane, Task task);
+
+    void
+    executeNext(boost::asio::yield_context yield);
 };
 
 }  // namespace rpc
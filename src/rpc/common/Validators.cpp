@@ -197,7 +197,7 @@ CustomValidator CustomValidators::SubscribeStreamValidator =
             return Error{Status{RippledError::rpcINVALID_PARAMS, std::string(key) + "NotArray"}};
 
         static std::unordered_set<std::string> const validStreams = {
-            "ledger", "transactions", "transactions_proposed", "book_changes", "manifests", "validations"
+            "ledger", "transactions", "transactions_proposed", "book_changes", "manifests", "validations", "ledger_diff"
         };
 
         static std::unordered_set<std::string> const notSupportStreams = {"peer_status", "consensus", "server"};
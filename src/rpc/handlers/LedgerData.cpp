@@ -19,6 +19,7 @@
 
 #include "rpc/handlers/LedgerData.hpp"
 
+#include "data/BackendInterface.hpp"
 #include "data/Types.hpp"
 #include "rpc/Errors.hpp"
 #include "rpc/JS.hpp"
@@ -27,6 +28,8 @@
 #include "util/LedgerUtils.hpp"
 #include "util/log/Logger.hpp"
 
+#include <boost/asio/spawn.hpp>
+#include <boost/json/array.hpp>
 #include <boost/json/conversion.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/value.hpp>
@@ -43,6 +46,8 @@
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <set>
 #include <string>
 #include <utility>
 #include <variant>
@@ -50,6 +55,50 @@
 
 namespace rpc {
 
+namespace {
+
+/**
+ * @brief Pick the keys splitting the ledger into ranges of roughly the same size.
+ *
+ * Same idea as the cursors used to load the cache: objects changed in the most recent ledgers (and not deleted since)
+ * exist in the ledger and their keys are spread evenly over the key space.
+ */
+std::vector<ripple::uint256>
+fetchRangeBounds(
+    BackendInterface const& backend,
+    std::uint32_t ledgerSequence,
+    std::uint32_t minSequence,
+    std::uint32_t numRanges,
+    boost::asio::yield_context yield
+)
+{
+    std::set<ripple::uint256> liveKeys;
+    std::set<ripple::uint256> deletedKeys;
+
+    auto const numDiffs = std::min(ledgerSequence - minSequence + 1, LedgerDataHandler::MAX_RANGE_DIFFS);
+    for (std::uint32_t offset = 0; offset < numDiffs and liveKeys.size() + 1 < numRanges; ++offset) {
+        for (auto const& [key, blob] : backend.fetchLedgerDiff(ledgerSequence - offset, yield)) {
+            if (blob.empty()) {
+                deletedKeys.insert(key);
+            } else if (not deletedKeys.contains(key)) {
+                liveKeys.insert(key);
+            }
+        }
+    }
+
+    std::vector<ripple::uint256> const keys(liveKeys.begin(), liveKeys.end());
+    auto const numBounds = std::min<std::size_t>(numRanges - 1, keys.size());
+
+    std::vector<ripple::uint256> bounds;
+    bounds.reserve(numBounds);
+    for (std::size_t i = 1; i <= numBounds; ++i)
+        bounds.push_back(keys[i * keys.size() / (numBounds + 1)]);
+
+    return bounds;
+}
+
+}  // namespace
+
 LedgerDataHandler::Result
 LedgerDataHandler::process(Input input, Context const& ctx) const
 {
@@ -60,6 +109,12 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
     if (!input.outOfOrder && input.diffMarker)
         return Error{Status{RippledError::rpcINVALID_PARAMS, "markerNotString"}};
 
+    if (input.outOfOrder && (input.ranges || input.endMarker))
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "outOfOrderRangesNotSupported"}};
+
+    if (input.ranges && (input.marker || input.endMarker))
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "rangesWithMarker"}};
+
     auto const range = sharedPtrBackend_->fetchLedgerRange();
     auto const lgrInfoOrStatus = getLedgerHeaderFromHashOrSeq(
         *sharedPtrBackend_, ctx.yield, input.ledgerHash, input.ledgerIndex, range->maxSequence
@@ -83,6 +138,13 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
     output.ledgerHash = ripple::strHex(lgrInfo.hash);
     output.ledgerIndex = lgrInfo.seq;
 
+    // the ranges are walked by separate requests, this one only returns where they start and end
+    if (input.ranges) {
+        output.rangeBounds =
+            fetchRangeBounds(*sharedPtrBackend_, lgrInfo.seq, range->minSequence, *input.ranges, ctx.yield);
+        return output;
+    }
+
     auto const start = std::chrono::system_clock::now();
     std::vector<data::LedgerObject> results;
 
@@ -111,7 +173,9 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
         // framework can not handler the check right now, adjust the value here
         auto const limit =
             std::min(input.limit, input.binary ? LedgerDataHandler::LIMITBINARY : LedgerDataHandler::LIMITJSON);
-        auto page = sharedPtrBackend_->fetchLedgerPage(input.marker, lgrInfo.seq, limit, input.outOfOrder, ctx.yield);
+        auto page = sharedPtrBackend_->fetchLedgerPage(
+            input.marker, lgrInfo.seq, limit, input.outOfOrder, ctx.yield, input.endMarker
+        );
         results = std::move(page.objects);
 
         if (page.cursor) {
@@ -128,6 +192,15 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
     output.states.reserve(results.size());
 
     for (auto const& [key, object] : results) {
+        // stored objects are already serialized canonically, so they are only parsed when the type or json is needed
+        if (input.binary && input.type == ripple::LedgerEntryType::ltANY) {
+            output.states.push_back(boost::json::object{
+                {JS(data), ripple::strHex(object)},
+                {JS(index), ripple::to_string(key)},
+            });
+            continue;
+        }
+
         ripple::STLedgerEntry const sle{ripple::SerialIter{object.data(), object.size()}, key};
 
         // note the filter is after limit is applied, same as rippled
@@ -169,6 +242,21 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerDataHandle
     if (output.cacheFull)
         obj["cache_full"] = *(output.cacheFull);
 
+    if (output.rangeBounds) {
+        auto const& bounds = *(output.rangeBounds);
+        boost::json::array ranges;
+        for (std::size_t i = 0; i <= bounds.size(); ++i) {
+            boost::json::object range;
+            if (i > 0)
+                range[JS(marker)] = ripple::strHex(bounds[i - 1]);
+            if (i < bounds.size())
+                range["end_marker"] = ripple::strHex(bounds[i]);
+
+            ranges.push_back(std::move(range));
+        }
+        obj["ranges"] = std::move(ranges);
+    }
+
     if (output.diffMarker) {
         obj[JS(marker)] = *(output.diffMarker);
     } else if (output.marker) {
@@ -203,6 +291,12 @@ tag_invoke(boost::json::value_to_tag<LedgerDataHandler::Input>, boost::json::val
         }
     }
 
+    if (jsonObject.contains("ranges"))
+        input.ranges = jsonObject.at("ranges").as_int64();
+
+    if (jsonObject.contains("end_marker"))
+        input.endMarker = ripple::uint256{boost::json::value_to<std::string>(jsonObject.at("end_marker")).data()};
+
     if (jsonObject.contains(JS(ledger_hash)))
         input.ledgerHash = boost::json::value_to<std::string>(jsonObject.at(JS(ledger_hash)));
 
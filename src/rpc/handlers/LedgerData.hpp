@@ -43,6 +43,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace rpc {
 
@@ -50,6 +51,10 @@ namespace rpc {
  * @brief The ledger_data method retrieves contents of the specified ledger. You can iterate through several calls to
  * retrieve the entire contents of a single ledger version.
  *
+ * @note The `state` array of a page is built in full and sent as one message; it is not streamed. A page is bounded by
+ * `limit`, so a full-state export pages through the key ranges returned for `ranges` in parallel instead. Streaming it
+ * needs chunked responses in the web layer, which sends whole messages only, and is left for a follow-up.
+ *
  * For more details see: https://xrpl.org/ledger_data.html
  */
 class LedgerDataHandler {
@@ -61,6 +66,8 @@ public:
     // constants
     static uint32_t constexpr LIMITBINARY = 2048;
     static uint32_t constexpr LIMITJSON = 256;
+    static uint32_t constexpr MAX_RANGES = 256;
+    static uint32_t constexpr MAX_RANGE_DIFFS = 32;
 
     /**
      * @brief A struct to hold the output data of the command
@@ -73,6 +80,7 @@ public:
         std::optional<std::string> marker;
         std::optional<uint32_t> diffMarker;
         std::optional<bool> cacheFull;
+        std::optional<std::vector<ripple::uint256>> rangeBounds;
         bool validated = true;
     };
 
@@ -81,6 +89,9 @@ public:
      *
      * @note `outOfOrder` is only for Clio, there is no document, traverse via seq diff (outOfOrder implementation is
      * copied from old rpc handler)
+     *
+     * @note `ranges` and `endMarker` are only for Clio: `ranges` splits the ledger into up to that many key ranges
+     * which can be exported in parallel by paging each of them with `marker` and `endMarker`
      */
     struct Input {
         std::optional<std::string> ledgerHash;
@@ -90,6 +101,8 @@ public:
         std::optional<ripple::uint256> marker;
         std::optional<uint32_t> diffMarker;
         bool outOfOrder = false;
+        std::optional<uint32_t> ranges;
+        std::optional<ripple::uint256> endMarker;
         ripple::LedgerEntryType type = ripple::LedgerEntryType::ltANY;
     };
 
@@ -123,6 +136,8 @@ public:
             {JS(marker),
              validation::Type<uint32_t, std::string>{},
              meta::IfType<std::string>{validation::CustomValidators::Uint256HexStringValidator}},
+            {"ranges", validation::Type<uint32_t>{}, validation::Between<uint32_t>{1, MAX_RANGES}},
+            {"end_marker", validation::CustomValidators::Uint256HexStringValidator},
             {JS(type),
              meta::WithCustomError{
                  validation::Type<std::string>{}, Status{ripple::rpcINVALID_PARAMS, "Invalid field 'type', not string."}
@@ -41,6 +41,7 @@
 #include <xrpl/protocol/Book.h>
 #include <xrpl/protocol/jss.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -117,6 +118,10 @@ SubscribeHandler::process(Input input, Context const& ctx) const
     ctx.session->apiSubVersion = ctx.apiVersion;
 
     if (input.streams) {
+        // the ledger diff stream carries whole ledgers and is meant for other Clio nodes only
+        if (not ctx.isAdmin and std::ranges::find(*input.streams, "ledger_diff") != input.streams->end())
+            return Error{Status{RippledError::rpcNO_PERMISSION, "The ledger_diff stream requires admin permissions."}};
+
         auto const ledger = subscribeToStreams(ctx.yield, *(input.streams), ctx.session);
         if (!ledger.empty())
             output.ledger = ledger;
@@ -156,6 +161,8 @@ SubscribeHandler::subscribeToStreams(
             subscriptions_->subManifest(session);
         } else if (stream == "book_changes") {
             subscriptions_->subBookChanges(session);
+        } else if (stream == "ledger_diff") {
+            subscriptions_->subLedgerDiff(session);
         }
     }
 
@@ -125,6 +125,8 @@ UnsubscribeHandler::unsubscribeFromStreams(
             subscriptions_->unsubManifest(session);
         } else if (stream == "book_changes") {
             subscriptions_->unsubBookChanges(session);
+        } else if (stream == "ledger_diff") {
+            subscriptions_->unsubLedgerDiff(session);
         } else {
             ASSERT(false, "Unknown stream: {}", stream);
         }
@@ -21,6 +21,9 @@
 
 #include "util/SourceLocation.hpp"
 #include "util/config/Config.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/date_time/posix_time/posix_time_duration.hpp>
@@ -29,6 +32,7 @@
 #include <boost/json/conversion.hpp>
 #include <boost/json/value.hpp>
 #include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/core/record_view.hpp>
 #include <boost/log/core/core.hpp>
 #include <boost/log/expressions/filter.hpp>
 #include <boost/log/keywords/auto_flush.hpp>
@@ -41,14 +45,21 @@
 #include <boost/log/keywords/target.hpp>
 #include <boost/log/keywords/target_file_name.hpp>
 #include <boost/log/keywords/time_based_rotation.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/utility/setup/console.hpp>
-#include <boost/log/utility/setup/file.hpp>
 #include <boost/log/utility/setup/formatter_parser.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <fmt/core.h>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <ios>
@@ -61,6 +72,118 @@
 
 namespace util {
 
+namespace {
+
+namespace sinks = boost::log::sinks;
+
+// log records the asynchronous file sink can hold before its overflow policy applies
+constexpr std::size_t ASYNC_QUEUE_SIZE = 64 * 1024;
+
+std::atomic_bool dropOnOverflow = false;
+std::atomic_uint64_t numDroppedRecords = 0;
+
+// the metric of the dropped records, once the metrics are up; the logger is initialized before them
+std::atomic<util::prometheus::CounterInt*> droppedRecordsCounter = nullptr;
+
+bool
+isFatal(boost::log::record_view const& rec)
+{
+    auto const severity = rec[log_severity];
+    return severity and severity.get() >= Severity::FTL;
+}
+
+/**
+ * @brief Overflow strategy of the asynchronous file sink: blocks the logging thread or drops the record.
+ */
+class OverflowStrategy {
+    sinks::block_on_overflow block_;
+
+public:
+    template <typename LockType>
+    bool
+    on_overflow(boost::log::record_view const& rec, LockType& lock)
+    {
+        // fatal records are never dropped
+        if (dropOnOverflow and not isFatal(rec)) {
+            ++numDroppedRecords;
+            if (auto* counter = droppedRecordsCounter.load(); counter != nullptr)
+                ++(*counter);
+            return false;
+        }
+
+        return block_.on_overflow(rec, lock);
+    }
+
+    void
+    on_queue_space_available()
+    {
+        block_.on_queue_space_available();
+    }
+
+    void
+    interrupt()
+    {
+        block_.interrupt();
+    }
+};
+
+/**
+ * @brief Text file backend that reports records dropped by the asynchronous sink before writing the next one.
+ */
+class FileBackend : public sinks::text_file_backend {
+    std::uint64_t reported_ = 0;
+
+public:
+    using sinks::text_file_backend::text_file_backend;
+
+    void
+    consume(boost::log::record_view const& rec, string_type const& formattedMessage)
+    {
+        if (auto const dropped = numDroppedRecords.load(); dropped > reported_) {
+            sinks::text_file_backend::consume(
+                rec, fmt::format("{} log records were dropped because the log queue was full", dropped - reported_)
+            );
+            reported_ = dropped;
+        }
+
+        sinks::text_file_backend::consume(rec, formattedMessage);
+    }
+};
+
+/**
+ * @brief Asynchronous file sink that writes out everything queued as soon as a fatal record is logged.
+ *
+ * The process usually exits right after a fatal record, so the record and the ones leading to it would otherwise be
+ * lost with the queue.
+ */
+class AsyncFileSink
+    : public sinks::asynchronous_sink<FileBackend, sinks::bounded_fifo_queue<ASYNC_QUEUE_SIZE, OverflowStrategy>> {
+public:
+    using asynchronous_sink::asynchronous_sink;
+
+    void
+    consume(boost::log::record_view const& rec) override
+    {
+        asynchronous_sink::consume(rec);
+        if (isFatal(rec))
+            flush();
+    }
+
+    bool
+    try_consume(boost::log::record_view const& rec) override
+    {
+        if (not isFatal(rec))
+            return asynchronous_sink::try_consume(rec);
+
+        consume(rec);
+        return true;
+    }
+};
+
+boost::shared_ptr<AsyncFileSink> asyncFileSink;
+
+}  // namespace
+
 Logger LogService::general_log_ = Logger{"General"};
 Logger LogService::alert_log_ = Logger{"Alert"};
 boost::log::filter LogService::filter_{};
@@ -109,7 +232,6 @@ void
 LogService::init(util::Config const& config)
 {
     namespace keywords = boost::log::keywords;
-    namespace sinks = boost::log::sinks;
 
     boost::log::add_common_attributes();
     boost::log::register_simple_formatter_factory<Severity, char>("Severity");
@@ -132,20 +254,34 @@ LogService::init(util::Config const& config)
         auto const rotationSize = config.valueOr<uint64_t>("log_rotation_size", 2048u) * 1024u * 1024u;
         auto const rotationPeriod = config.valueOr<uint32_t>("log_rotation_hour_interval", 12u);
         auto const dirSize = config.valueOr<uint64_t>("log_directory_max_size", 50u * 1024u) * 1024u * 1024u;
-        auto fileSink = boost::log::add_file_log(
+        auto backend = boost::make_shared<FileBackend>(
             keywords::file_name = dirPath / "clio.log",
             keywords::target_file_name = dirPath / "clio_%Y-%m-%d_%H-%M-%S.log",
             keywords::auto_flush = true,
-            keywords::format = format,
             keywords::open_mode = std::ios_base::app,
             keywords::rotation_size = rotationSize,
             keywords::time_based_rotation =
                 sinks::file::rotation_at_time_interval(boost::posix_time::hours(rotationPeriod))
         );
-        fileSink->locked_backend()->set_file_collector(
+        backend->set_file_collector(
             sinks::file::make_collector(keywords::target = dirPath, keywords::max_size = dirSize)
         );
-        fileSink->locked_backend()->scan_for_files();
+        backend->scan_for_files();
+
+        if (config.valueOr("log_async.enabled", false)) {
+            auto const overflow = config.valueOr<std::string>("log_async.overflow", "block");
+            if (overflow != "block" && overflow != "drop")
+                throw std::runtime_error("Could not parse `log_async.overflow`: expected `block` or `drop`");
+            dropOnOverflow = overflow == "drop";
+
+            asyncFileSink = boost::make_shared<AsyncFileSink>(backend);
+            asyncFileSink->set_formatter(boost::log::parse_formatter(format));
+            boost::log::core::get()->add_sink(asyncFileSink);
+        } else {
+            auto fileSink = boost::make_shared<sinks::synchronous_sink<FileBackend>>(backend);
+            fileSink->set_formatter(boost::log::parse_formatter(format));
+            boost::log::core::get()->add_sink(fileSink);
+        }
     }
 
     // get default severity, can be overridden per channel using the `log_channels` array
@@ -180,6 +316,38 @@ LogService::init(util::Config const& config)
     LOG(LogService::info()) << "Default log level = " << defaultSeverity;
 }
 
+std::uint64_t
+LogService::droppedRecords()
+{
+    return numDroppedRecords;
+}
+
+void
+LogService::registerMetrics()
+{
+    auto& counter = PrometheusService::counterInt(
+        "log_dropped_records_total_number",
+        util::prometheus::Labels{},
+        "The total number of log records dropped because the queue of the asynchronous file sink was full"
+    );
+    counter += numDroppedRecords.load();
+    droppedRecordsCounter = &counter;
+}
+
+void
+LogService::shutdown()
+{
+    droppedRecordsCounter = nullptr;
+
+    if (!asyncFileSink)
+        return;
+
+    boost::log::core::get()->remove_sink(asyncFileSink);
+    asyncFileSink->stop();
+    asyncFileSink->flush();
+    asyncFileSink.reset();
+}
+
 Logger::Pump
 Logger::trace(SourceLocationType const& loc) const
 {
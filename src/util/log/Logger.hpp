@@ -46,6 +46,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -287,6 +288,28 @@ public:
     static void
     init(Config const& config);
 
+    /**
+     * @brief Stop the asynchronous file sink, if any, once everything it has queued is written
+     */
+    static void
+    shutdown();
+
+    /**
+     * @brief Get the number of log records dropped because the queue of the asynchronous file sink was full
+     *
+     * @return The number of dropped records since start
+     */
+    [[nodiscard]] static std::uint64_t
+    droppedRecords();
+
+    /**
+     * @brief Publish the number of dropped log records as the `log_dropped_records_total_number` metric
+     *
+     * @note Must be called after @ref PrometheusService is initialized; records dropped before are included.
+     */
+    static void
+    registerMetrics();
+
     /**
      * @brief Globally accesible General logger at Severity::TRC severity
      *
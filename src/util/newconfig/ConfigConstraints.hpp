@@ -65,13 +65,30 @@ static constexpr std::array<char const*, 5> LOG_TAGS = {
     "uuid",
 };
 
+/**
+ * @brief specific values that are accepted for the overflow policy of asynchronous logging in config.
+ */
+static constexpr std::array<char const*, 2> LOG_OVERFLOW_POLICIES = {
+    "block",
+    "drop",
+};
+
 /**
  * @brief specific values that are accepted for cache loading in config.
  */
-static constexpr std::array<char const*, 3> LOAD_CACHE_MODE = {
+static constexpr std::array<char const*, 4> LOAD_CACHE_MODE = {
     "sync",
     "async",
     "none",
+    "snapshot",
+};
+
+/**
+ * @brief specific values that are accepted for cache compression in config.
+ */
+static constexpr std::array<char const*, 2> CACHE_COMPRESSION = {
+    "none",
+    "zstd",
 };
 
 /**
@@ -345,7 +362,9 @@ static constinit OneOf validateChannelName{"channel", Logger::CHANNELS};
 static constinit OneOf validateLogLevelName{"log_level", LOG_LEVELS};
 static constinit OneOf validateCassandraName{"database.type", DATABASE_TYPE};
 static constinit OneOf validateLoadMode{"cache.load", LOAD_CACHE_MODE};
+static constinit OneOf validateCacheCompression{"cache.compression", CACHE_COMPRESSION};
 static constinit OneOf validateLogTag{"log_tag_style", LOG_TAGS};
+static constinit OneOf validateLogOverflow{"log_async.overflow", LOG_OVERFLOW_POLICIES};
 
 static constinit PositiveDouble validatePositiveDouble{};
 
@@ -358,5 +377,7 @@ static constinit NumberValueConstraint<uint32_t> validateUint32{
     std::numeric_limits<uint32_t>::max()
 };
 static constinit NumberValueConstraint<uint32_t> validateApiVersion{rpc::API_VERSION_MIN, rpc::API_VERSION_MAX};
+// the cache always keeps at least the latest ledger
+static constinit NumberValueConstraint<uint16_t> validateNumCachedLedgers{1, std::numeric_limits<uint16_t>::max()};
 
 }  // namespace util::config
@@ -72,9 +72,16 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint16)},
      {"database.cassandra.write_batch_size",
       ConfigValue{ConfigType::Integer}.defaultValue(20).withConstraint(validateUint16)},
+     {"database.cassandra.write_coalescing_window",
+      ConfigValue{ConfigType::Integer}.defaultValue(1).withConstraint(validateUint16)},
+     {"database.cassandra.read_batch_size",
+      ConfigValue{ConfigType::Integer}.defaultValue(100).withConstraint(validateUint16)},
      {"etl_source.[].ip", Array{ConfigValue{ConfigType::String}.withConstraint(validateIP)}},
      {"etl_source.[].ws_port", Array{ConfigValue{ConfigType::String}.withConstraint(validatePort)}},
      {"etl_source.[].grpc_port", Array{ConfigValue{ConfigType::String}.withConstraint(validatePort)}},
+     {"ledger_diff_source.ip", ConfigValue{ConfigType::String}.optional().withConstraint(validateIP)},
+     {"ledger_diff_source.ws_port", ConfigValue{ConfigType::String}.optional().withConstraint(validatePort)},
+     {"ledger_diff_source.admin_password", ConfigValue{ConfigType::String}.optional()},
      {"forwarding.cache_timeout",
       ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(validatePositiveDouble)},
      {"forwarding.request_timeout",
@@ -87,6 +94,9 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
       ConfigValue{ConfigType::Double}.defaultValue(1.0).withConstraint(validatePositiveDouble)},
      {"cache.peers.[].ip", Array{ConfigValue{ConfigType::String}.withConstraint(validateIP)}},
      {"cache.peers.[].port", Array{ConfigValue{ConfigType::String}.withConstraint(validatePort)}},
+     {"rpc.cache_size", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
+     {"rpc.cache_commands.[]", Array{ConfigValue{ConfigType::String}}},
+     {"rpc.cache_timeout", ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(validatePositiveDouble)},
      {"server.ip", ConfigValue{ConfigType::String}.withConstraint(validateIP)},
      {"server.port", ConfigValue{ConfigType::Integer}.withConstraint(validatePort)},
      {"server.workers", ConfigValue{ConfigType::Integer}.withConstraint(validateUint32)},
@@ -102,7 +112,14 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      {"cache.num_cursors_from_account", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint16)
      },
      {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512).withConstraint(validateUint16)},
+     {"cache.num_ledgers",
+      ConfigValue{ConfigType::Integer}.defaultValue(4).withConstraint(validateNumCachedLedgers)},
      {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async").withConstraint(validateLoadMode)},
+     {"cache.snapshot_file", ConfigValue{ConfigType::String}.optional()},
+     {"cache.snapshot_max_lag", ConfigValue{ConfigType::Integer}.defaultValue(1000).withConstraint(validateUint32)},
+     {"cache.compression",
+      ConfigValue{ConfigType::String}.defaultValue("none").withConstraint(validateCacheCompression)},
+     {"cache.owner_index", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
      {"log_channels.[].channel", Array{ConfigValue{ConfigType::String}.optional().withConstraint(validateChannelName)}},
      {"log_channels.[].log_level",
       Array{ConfigValue{ConfigType::String}.optional().withConstraint(validateLogLevelName)}},
@@ -118,7 +135,10 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
       ConfigValue{ConfigType::Integer}.defaultValue(50u * 1024u).withConstraint(validateUint32)},
      {"log_rotation_hour_interval", ConfigValue{ConfigType::Integer}.defaultValue(12).withConstraint(validateUint32)},
      {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint").withConstraint(validateLogTag)},
+     {"log_async.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"log_async.overflow", ConfigValue{ConfigType::String}.defaultValue("block").withConstraint(validateLogOverflow)},
      {"extractor_threads", ConfigValue{ConfigType::Integer}.defaultValue(2u).withConstraint(validateUint32)},
+     {"fetch_hedge_delay", ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(validatePositiveDouble)},
      {"read_only", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
      {"txn_threshold", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint16)},
      {"start_sequence", ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint32)},
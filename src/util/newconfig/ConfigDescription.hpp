@@ -70,23 +70,33 @@ private:
         KV{"database.cassandra.replication_factor", "Number of replicated nodes for Scylladb."},
         KV{"database.cassandra.table_prefix", "Prefix for Cassandra table names."},
         KV{"database.cassandra.max_write_requests_outstanding", "Maximum number of outstanding write requests."},
-        KV{"database.cassandra.max_read_requests_outstanding", "Maximum number of outstanding read requests."},
+        KV{"database.cassandra.max_read_requests_outstanding",
+           "Maximum number of outstanding read requests. The actual limit adapts to the read latency below it."},
         KV{"database.cassandra.threads", "Number of threads for Cassandra operations."},
         KV{"database.cassandra.core_connections_per_host", "Number of core connections per host for Cassandra."},
         KV{"database.cassandra.queue_size_io", "Queue size for I/O operations in Cassandra."},
         KV{"database.cassandra.write_batch_size", "Batch size for write operations in Cassandra."},
+        KV{"database.cassandra.write_coalescing_window",
+           "Milliseconds a write may wait to be batched with other writes to the same partition; 0 disables it."},
+        KV{"database.cassandra.read_batch_size", "Maximum number of keys fetched by a single read query."},
         KV{"etl_source.[].ip", "IP address of the ETL source."},
         KV{"etl_source.[].ws_port", "WebSocket port of the ETL source."},
         KV{"etl_source.[].grpc_port", "gRPC port of the ETL source."},
+        KV{"ledger_diff_source.ip", "IP address of the writing Clio node to receive ledger diffs from."},
+        KV{"ledger_diff_source.ws_port", "WebSocket port of the Clio node writing to the database."},
+        KV{"ledger_diff_source.admin_password", "Admin password of the Clio node writing to the database."},
         KV{"forwarding.cache_timeout", "Timeout duration for the forwarding cache used in Rippled communication."},
         KV{"forwarding.request_timeout", "Timeout duration for the forwarding request used in Rippled communication."},
         KV{"dos_guard.[].whitelist", "List of IP addresses to whitelist for DOS protection."},
         KV{"dos_guard.max_fetches", "Maximum number of fetch operations allowed by DOS guard."},
         KV{"dos_guard.max_connections", "Maximum number of concurrent connections allowed by DOS guard."},
         KV{"dos_guard.max_requests", "Maximum number of requests allowed by DOS guard."},
-        KV{"dos_guard.sweep_interval", "Interval in seconds for DOS guard to sweep/clear its state."},
+        KV{"dos_guard.sweep_interval", "Length in seconds of the DOS guard sliding window for fetches and requests."},
         KV{"cache.peers.[].ip", "IP address of peer nodes to cache."},
         KV{"cache.peers.[].port", "Port number of peer nodes to cache."},
+        KV{"rpc.cache_size", "Maximum number of RPC responses kept in the response cache; 0 disables the cache."},
+        KV{"rpc.cache_commands.[]", "Commands whose responses are cached until the next validated ledger."},
+        KV{"rpc.cache_timeout", "Seconds a `server_info` response is cached for; 0 disables the cache."},
         KV{"server.ip", "IP address of the Clio HTTP server."},
         KV{"server.port", "Port number of the Clio HTTP server."},
         KV{"server.max_queue_size", "Maximum size of the server's request queue."},
@@ -101,7 +111,12 @@ private:
         KV{"cache.num_cursors_from_diff", "Num of cursors that are different."},
         KV{"cache.num_cursors_from_account", "Number of cursors from an account."},
         KV{"cache.page_fetch_size", "Page fetch size for cache operations."},
-        KV{"cache.load", "Cache loading strategy ('sync' or 'async')."},
+        KV{"cache.num_ledgers", "Number of most recent ledgers served from the cache; at least 1."},
+        KV{"cache.load", "Cache loading strategy ('sync', 'async', 'snapshot' or 'none')."},
+        KV{"cache.snapshot_file", "Path of the cache snapshot file used by the 'snapshot' loading strategy."},
+        KV{"cache.snapshot_max_lag", "Maximum number of ledgers to replay on top of the cache snapshot file."},
+        KV{"cache.compression", "How cached objects are stored ('none' or 'zstd')."},
+        KV{"cache.owner_index", "Keep an index of the owner directories of all accounts in memory."},
         KV{"log_channels.[].channel", "Name of the log channel."},
         KV{"log_channels.[].log_level", "Log level for the log channel."},
         KV{"log_level", "General logging level of Clio."},
@@ -112,7 +127,12 @@ private:
         KV{"log_directory_max_size", "Maximum size of the log directory in megabytes."},
         KV{"log_rotation_hour_interval", "Interval in hours for log rotation."},
         KV{"log_tag_style", "Style for log tags."},
+        KV{"log_async.enabled", "Write log files from a background thread instead of the thread that logs."},
+        KV{"log_async.overflow",
+           "What to do when the asynchronous log queue is full: `block` the logging thread or `drop` the record."},
         KV{"extractor_threads", "Number of extractor threads."},
+        KV{"fetch_hedge_delay",
+           "Seconds after which a slow ledger fetch is also sent to another ETL source; 0 disables hedging."},
         KV{"read_only", "Indicates if the server should have read-only privileges."},
         KV{"txn_threshold", "Transaction threshold value."},
         KV{"start_sequence", "Starting ledger index."},
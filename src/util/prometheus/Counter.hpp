@@ -48,7 +48,7 @@ struct AnyCounter : MetricBase, impl::AnyCounterBase<NumberType> {
      * @param labelsString The labels of the counter
      * @param impl The implementation of the counter
      */
-    template <impl::SomeCounterImpl ImplType = impl::CounterImpl<ValueType>>
+    template <impl::SomeCounterImpl ImplType = impl::ShardedCounterImpl<ValueType>>
         requires std::same_as<ValueType, typename std::remove_cvref_t<ImplType>::ValueType>
     AnyCounter(std::string name, std::string labelsString, ImplType&& impl = ImplType{})
         : MetricBase(std::move(name), std::move(labelsString))
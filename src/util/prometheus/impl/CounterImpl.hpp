@@ -20,7 +20,11 @@
 #pragma once
 
 #include "util/Atomic.hpp"
+#include "util/prometheus/impl/Sharding.hpp"
 
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <type_traits>
 
 namespace util::prometheus::impl {
@@ -72,4 +76,58 @@ private:
     AtomicPtr<ValueType> value_ = std::make_unique<Atomic<ValueType>>(0);
 };
 
+/**
+ * @brief Counter implementation that spreads additions over per-thread shards summed up when the value is read.
+ *
+ * Threads updating the same counter don't contend on a single cache line. Reading the value and setting it are more
+ * expensive and not atomic with respect to concurrent additions, which is fine for counters that are mostly increased.
+ *
+ * @tparam NumberType The type of the value of the counter
+ */
+template <SomeNumberType NumberType>
+class ShardedCounterImpl {
+public:
+    using ValueType = NumberType;
+
+    ShardedCounterImpl() = default;
+
+    ShardedCounterImpl(ShardedCounterImpl const&) = delete;
+    ShardedCounterImpl(ShardedCounterImpl&&) = default;
+
+    ShardedCounterImpl&
+    operator=(ShardedCounterImpl const&) = delete;
+    ShardedCounterImpl&
+    operator=(ShardedCounterImpl&&) = default;
+
+    void
+    add(ValueType const value)
+    {
+        (*shards_)[currentShard()].value.add(value);
+    }
+
+    void
+    set(ValueType const value)
+    {
+        for (std::size_t i = 1; i < NUM_SHARDS; ++i)
+            (*shards_)[i].value.set(ValueType{0});
+        (*shards_)[0].value.set(value);
+    }
+
+    ValueType
+    value() const
+    {
+        ValueType result{0};
+        for (auto const& shard : *shards_)
+            result += shard.value.value();
+        return result;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        Atomic<ValueType> value{0};
+    };
+
+    std::unique_ptr<std::array<Shard, NUM_SHARDS>> shards_ = std::make_unique<std::array<Shard, NUM_SHARDS>>();
+};
+
 }  // namespace util::prometheus::impl
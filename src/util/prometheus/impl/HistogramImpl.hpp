@@ -20,9 +20,15 @@
 #pragma once
 
 #include "util/Assert.hpp"
+#include "util/Atomic.hpp"
 #include "util/Concepts.hpp"
 #include "util/prometheus/OStream.hpp"
+#include "util/prometheus/impl/Sharding.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -134,4 +140,116 @@ private:
     mutable std::unique_ptr<std::mutex> mutex_ = std::make_unique<std::mutex>();
 };
 
+/**
+ * @brief Histogram implementation that records observations into per-thread shards merged when serialized.
+ *
+ * Observing takes no lock: every shard keeps its own bucket counts and sum on cache lines of its own. A serialized
+ * histogram may miss observations made concurrently, but its buckets are always consistent with its count.
+ *
+ * @tparam NumberType The type of the observed values
+ */
+template <SomeNumberType NumberType>
+class ShardedHistogramImpl {
+public:
+    using ValueType = NumberType;
+
+    ShardedHistogramImpl() = default;
+
+    ShardedHistogramImpl(ShardedHistogramImpl const&) = delete;
+    ShardedHistogramImpl(ShardedHistogramImpl&&) = default;
+
+    ShardedHistogramImpl&
+    operator=(ShardedHistogramImpl const&) = delete;
+    ShardedHistogramImpl&
+    operator=(ShardedHistogramImpl&&) = default;
+
+    void
+    setBuckets(std::vector<ValueType> const& bounds)
+    {
+        ASSERT(bounds_.empty(), "Buckets can be set only once.");
+        bounds_ = bounds;
+        linesPerShard_ = (bounds_.size() + COUNTS_PER_LINE) / COUNTS_PER_LINE;  // one more for +Inf
+        counts_ = std::make_unique<CountsLine[]>(NUM_SHARDS * linesPerShard_);
+    }
+
+    void
+    observe(ValueType const value)
+    {
+        auto const bucket = static_cast<std::size_t>(std::distance(
+            bounds_.begin(), std::lower_bound(bounds_.begin(), bounds_.end(), value)
+        ));
+        auto const shard = currentShard();
+
+        counts(shard, bucket).fetch_add(1, std::memory_order_relaxed);
+        (*sums_)[shard].value.add(value);
+    }
+
+    void
+    serializeValue(std::string const& name, std::string labelsString, OStream& stream) const
+    {
+        if (labelsString.empty()) {
+            labelsString = "{";
+        } else {
+            ASSERT(
+                labelsString.front() == '{' && labelsString.back() == '}',
+                "Labels must be in Prometheus serialized format."
+            );
+            labelsString.back() = ',';
+        }
+
+        std::uint64_t cumulativeCount = 0;
+        for (std::size_t bucket = 0; bucket < bounds_.size(); ++bucket) {
+            cumulativeCount += bucketCount(bucket);
+            stream << name << "_bucket" << labelsString << "le=\"" << bounds_[bucket] << "\"} " << cumulativeCount
+                   << '\n';
+        }
+        cumulativeCount += bucketCount(bounds_.size());
+        stream << name << "_bucket" << labelsString << "le=\"+Inf\"} " << cumulativeCount << '\n';
+
+        if (labelsString.size() == 1) {
+            labelsString = "";
+        } else {
+            labelsString.back() = '}';
+        }
+
+        ValueType sum{0};
+        for (auto const& shard : *sums_)
+            sum += shard.value.value();
+
+        stream << name << "_sum" << labelsString << " " << sum << '\n';
+        stream << name << "_count" << labelsString << " " << cumulativeCount << '\n';
+    }
+
+private:
+    static constexpr std::size_t COUNTS_PER_LINE = CACHE_LINE_SIZE / sizeof(std::atomic_uint64_t);
+
+    struct alignas(CACHE_LINE_SIZE) CountsLine {
+        std::array<std::atomic_uint64_t, COUNTS_PER_LINE> counts{};
+    };
+
+    struct alignas(CACHE_LINE_SIZE) SumShard {
+        Atomic<ValueType> value{0};
+    };
+
+    std::atomic_uint64_t&
+    counts(std::size_t shard, std::size_t bucket) const
+    {
+        return counts_[(shard * linesPerShard_) + (bucket / COUNTS_PER_LINE)].counts[bucket % COUNTS_PER_LINE];
+    }
+
+    std::uint64_t
+    bucketCount(std::size_t bucket) const
+    {
+        std::uint64_t result = 0;
+        for (std::size_t shard = 0; shard < NUM_SHARDS; ++shard)
+            result += counts(shard, bucket).load(std::memory_order_relaxed);
+        return result;
+    }
+
+    std::vector<ValueType> bounds_;
+    std::size_t linesPerShard_ = 1;
+    std::unique_ptr<CountsLine[]> counts_ = std::make_unique<CountsLine[]>(NUM_SHARDS);
+    std::unique_ptr<std::array<SumShard, NUM_SHARDS>> sums_ = std::make_unique<std::array<SumShard, NUM_SHARDS>>();
+};
+
 }  // namespace util::prometheus::impl
@@ -0,0 +1,48 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace util::prometheus::impl {
+
+/** @brief Number of shards used by the sharded metric implementations */
+static constexpr std::size_t NUM_SHARDS = 16;
+
+/** @brief Alignment that keeps every shard on cache lines of its own */
+static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Get the shard the calling thread updates.
+ *
+ * Threads are assigned shards round-robin on their first update so that the threads of a pool spread evenly.
+ *
+ * @return The index of the shard in [0, NUM_SHARDS)
+ */
+inline std::size_t
+currentShard()
+{
+    static std::atomic_size_t nextShard = 0;
+    thread_local std::size_t const shard = nextShard.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+    return shard;
+}
+
+}  // namespace util::prometheus::impl
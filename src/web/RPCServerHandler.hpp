@@ -108,11 +108,14 @@ public:
             if (not connection->upgraded and shouldReplaceParams(req))
                 req[JS(params)] = boost::json::array({boost::json::object{}});
 
+            auto const method = extractMethod(req);
             if (!rpcEngine_->post(
                     [this, request = std::move(req), connection](boost::asio::yield_context yield) mutable {
                         handleRequest(yield, std::move(request), connection);
                     },
-                    connection->clientIp
+                    connection->clientIp,
+                    method,
+                    connection->isAdmin()
                 )) {
                 rpcEngine_->notifyTooBusy();
                 web::impl::ErrorHelper(connection).sendTooBusyError();
@@ -135,6 +138,18 @@ public:
     }
 
 private:
+    static std::string
+    extractMethod(boost::json::object const& request)
+    {
+        // websocket requests carry the method as `command`, http requests as `method`
+        for (auto const* key : {"command", "method"}) {
+            if (auto const* value = request.if_contains(key); value != nullptr and value->is_string())
+                return std::string{value->as_string()};
+        }
+
+        return {};
+    }
+
     void
     handleRequest(
         boost::asio::yield_context yield,
@@ -26,9 +26,10 @@
 
 #include <boost/iterator/transform_iterator.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <functional>
-#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_set>
@@ -40,6 +41,9 @@ DOSGuard::DOSGuard(util::Config const& config, WhitelistHandlerInterface const&
     , maxFetches_{config.valueOr("dos_guard.max_fetches", DEFAULT_MAX_FETCHES)}
     , maxConnCount_{config.valueOr("dos_guard.max_connections", DEFAULT_MAX_CONNECTIONS)}
     , maxRequestCount_{config.valueOr("dos_guard.max_requests", DEFAULT_MAX_REQUESTS)}
+    , window_{std::max(
+          std::chrono::milliseconds{1u}, util::Config::toMilliseconds(config.valueOr("dos_guard.sweep_interval", 1.0))
+      )}
 {
 }
 
@@ -55,25 +59,10 @@ DOSGuard::isOk(std::string const& ip) const noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        if (ipState_.find(ip) != ipState_.end()) {
-            auto [transferedByte, requests] = ipState_.at(ip);
-            if (transferedByte > maxFetches_ || requests > maxRequestCount_) {
-                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                 << " Transfered Byte: " << transferedByte << "; Requests: " << requests;
-                return false;
-            }
-        }
-        auto it = ipConnCount_.find(ip);
-        if (it != ipConnCount_.end()) {
-            if (it->second > maxConnCount_) {
-                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                 << " Concurrent connection: " << it->second;
-                return false;
-            }
-        }
-    }
+    auto const shard = shardFor(ip).lock();
+    if (auto const it = shard->find(ip); it != shard->end())
+        return isOk(ip, it->second, Clock::now());
+
     return true;
 }
 
@@ -82,8 +71,11 @@ DOSGuard::increment(std::string const& ip) noexcept
 {
     if (whitelistHandler_.get().isWhiteListed(ip))
         return;
-    std::scoped_lock const lck{mtx_};
-    ipConnCount_[ip]++;
+
+    auto shard = shardFor(ip).lock();
+    auto& state = (*shard)[ip];
+    roll(state, Clock::now());
+    state.connectionsCount++;
 }
 
 void
@@ -91,11 +83,11 @@ DOSGuard::decrement(std::string const& ip) noexcept
 {
     if (whitelistHandler_.get().isWhiteListed(ip))
         return;
-    std::scoped_lock const lck{mtx_};
-    ASSERT(ipConnCount_[ip] > 0, "Connection count for ip {} can't be 0", ip);
-    ipConnCount_[ip]--;
-    if (ipConnCount_[ip] == 0)
-        ipConnCount_.erase(ip);
+
+    auto shard = shardFor(ip).lock();
+    auto& state = (*shard)[ip];
+    ASSERT(state.connectionsCount > 0, "Connection count for ip {} can't be 0", ip);
+    state.connectionsCount--;
 }
 
 [[maybe_unused]] bool
@@ -104,12 +96,13 @@ DOSGuard::add(std::string const& ip, uint32_t numObjects) noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        ipState_[ip].transferedByte += numObjects;
-    }
+    auto const now = Clock::now();
+    auto shard = shardFor(ip).lock();
+    auto& state = (*shard)[ip];
+    roll(state, now);
+    state.transferedByte += numObjects;
 
-    return isOk(ip);
+    return isOk(ip, state, now);
 }
 
 [[maybe_unused]] bool
@@ -118,19 +111,101 @@ DOSGuard::request(std::string const& ip) noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        ipState_[ip].requestsCount++;
-    }
+    auto const now = Clock::now();
+    auto shard = shardFor(ip).lock();
+    auto& state = (*shard)[ip];
+    roll(state, now);
+    state.requestsCount++;
 
-    return isOk(ip);
+    return isOk(ip, state, now);
 }
 
 void
 DOSGuard::clear() noexcept
 {
-    std::scoped_lock const lck(mtx_);
-    ipState_.clear();
+    for (auto& shard : shards_) {
+        auto lock = shard.lock();
+        std::erase_if(*lock, [](auto const& entry) { return entry.second.connectionsCount == 0; });
+        for (auto& [_, state] : *lock) {
+            auto const connectionsCount = state.connectionsCount;
+            state = ClientState{};
+            state.connectionsCount = connectionsCount;
+        }
+    }
+}
+
+void
+DOSGuard::sweep() noexcept
+{
+    auto const now = Clock::now();
+    for (auto& shard : shards_) {
+        std::erase_if(*shard.lock(), [this, now](auto const& entry) {
+            return entry.second.connectionsCount == 0 and now - entry.second.windowStart >= 2 * window_;
+        });
+    }
+}
+
+DOSGuard::Shard&
+DOSGuard::shardFor(std::string const& ip)
+{
+    return shards_[std::hash<std::string>{}(ip) % NUM_SHARDS];
+}
+
+DOSGuard::Shard const&
+DOSGuard::shardFor(std::string const& ip) const
+{
+    return shards_[std::hash<std::string>{}(ip) % NUM_SHARDS];
+}
+
+void
+DOSGuard::roll(ClientState& state, Clock::time_point now) const
+{
+    auto const elapsed = now - state.windowStart;
+    if (elapsed < window_)
+        return;
+
+    if (elapsed < 2 * window_) {
+        state.previousTransferedByte = state.transferedByte;
+        state.previousRequestsCount = state.requestsCount;
+        state.windowStart += window_;
+    } else {
+        state.previousTransferedByte = 0;
+        state.previousRequestsCount = 0;
+        state.windowStart = now;
+    }
+
+    state.transferedByte = 0;
+    state.requestsCount = 0;
+}
+
+[[nodiscard]] bool
+DOSGuard::isOk(std::string const& ip, ClientState const& state, Clock::time_point now) const
+{
+    auto rolled = state;
+    roll(rolled, now);
+
+    // the part of the previous window still covered by the sliding window ending now
+    auto const overlap =
+        1.0 - std::chrono::duration<double>(now - rolled.windowStart) / std::chrono::duration<double>(window_);
+    auto const usage = [overlap](std::uint32_t previous, std::uint32_t current) {
+        return static_cast<std::uint32_t>(previous * overlap) + current;
+    };
+
+    auto const transferedByte = usage(rolled.previousTransferedByte, rolled.transferedByte);
+    auto const requests = usage(rolled.previousRequestsCount, rolled.requestsCount);
+    if (transferedByte > maxFetches_ || requests > maxRequestCount_) {
+        LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
+                         << " Transfered Byte: " << transferedByte << "; Requests: " << requests;
+        return false;
+    }
+
+    if (state.connectionsCount > maxConnCount_) {
+        LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
+                         << " Concurrent connection: " << state.connectionsCount;
+        return false;
+    }
+
+    return true;
 }
 
 [[nodiscard]] std::unordered_set<std::string>
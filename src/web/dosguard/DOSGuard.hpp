@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "util/Mutex.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
@@ -28,9 +29,11 @@
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -41,31 +44,42 @@ namespace web::dosguard {
 /**
  * @brief A simple denial of service guard used for rate limiting.
  *
- * @tparam WhitelistHandlerType The type of the whitelist handler
+ * Fetches and requests are limited over a sliding window of `dos_guard.sweep_interval` seconds: the usage of the
+ * current window is added to the usage of the previous one, weighted by how much of the previous window still overlaps
+ * the sliding one. Per-IP state is split into shards, each guarded by its own mutex.
  */
 class DOSGuard : public DOSGuardInterface {
+    using Clock = std::chrono::steady_clock;
+
     /**
-     * @brief Accumulated state per IP, state will be reset accordingly
+     * @brief Accumulated state per IP, usage counters roll over every window
      */
     struct ClientState {
-        std::uint32_t transferedByte = 0; /**< Accumulated transferred byte */
-        std::uint32_t requestsCount = 0;  /**< Accumulated served requests count */
+        Clock::time_point windowStart;             /**< Start of the current window */
+        std::uint32_t transferedByte = 0;          /**< Transferred byte in the current window */
+        std::uint32_t requestsCount = 0;           /**< Served requests count in the current window */
+        std::uint32_t previousTransferedByte = 0;  /**< Transferred byte in the previous window */
+        std::uint32_t previousRequestsCount = 0;   /**< Served requests count in the previous window */
+        std::uint32_t connectionsCount = 0;        /**< Number of concurrent connections */
     };
 
-    mutable std::mutex mtx_;
-    std::unordered_map<std::string, ClientState> ipState_;
-    std::unordered_map<std::string, std::uint32_t> ipConnCount_;
+    static constexpr std::size_t NUM_SHARDS = 32;
+
+    using Shard = util::Mutex<std::unordered_map<std::string, ClientState>>;
+
+    std::array<Shard, NUM_SHARDS> shards_;
     std::reference_wrapper<WhitelistHandlerInterface const> whitelistHandler_;
 
     std::uint32_t const maxFetches_;
     std::uint32_t const maxConnCount_;
     std::uint32_t const maxRequestCount_;
+    Clock::duration const window_;
     util::Logger log_{"RPC"};
 
 public:
-    static constexpr std::uint32_t DEFAULT_MAX_FETCHES = 1000'000u; /**< Default maximum fetches per sweep */
+    static constexpr std::uint32_t DEFAULT_MAX_FETCHES = 1000'000u; /**< Default maximum fetches per window */
     static constexpr std::uint32_t DEFAULT_MAX_CONNECTIONS = 20u;   /**< Default maximum concurrent connections */
-    static constexpr std::uint32_t DEFAULT_MAX_REQUESTS = 20u;      /**< Default maximum requests per sweep */
+    static constexpr std::uint32_t DEFAULT_MAX_REQUESTS = 20u;      /**< Default maximum requests per window */
 
     /**
      * @brief Constructs a new DOS guard.
@@ -141,12 +155,30 @@ public:
     request(std::string const& ip) noexcept override;
 
     /**
-     * @brief Instantly clears all fetch counters added by @see add(std::string const&, uint32_t).
+     * @brief Instantly clears all fetch and request counters; connection counts are kept.
      */
     void
     clear() noexcept override;
 
+    /**
+     * @brief Drops the state of clients that have no connections and made no requests for two windows.
+     */
+    void
+    sweep() noexcept override;
+
 private:
+    Shard&
+    shardFor(std::string const& ip);
+
+    Shard const&
+    shardFor(std::string const& ip) const;
+
+    void
+    roll(ClientState& state, Clock::time_point now) const;
+
+    [[nodiscard]] bool
+    isOk(std::string const& ip, ClientState const& state, Clock::time_point now) const;
+
     [[nodiscard]] static std::unordered_set<std::string>
     getWhitelist(util::Config const& config);
 };
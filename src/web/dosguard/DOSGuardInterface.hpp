@@ -36,6 +36,15 @@ public:
      */
     virtual void
     clear() noexcept = 0;
+
+    /**
+     * @brief Periodic maintenance run by the sweep handler; clears the counters unless overridden.
+     */
+    virtual void
+    sweep() noexcept
+    {
+        clear();
+    }
 };
 
 /**
@@ -41,7 +41,7 @@ IntervalSweepHandler::IntervalSweepHandler(
     auto const sweepInterval{std::max(
         std::chrono::milliseconds{1u}, util::Config::toMilliseconds(config.valueOr("dos_guard.sweep_interval", 1.0))
     )};
-    repeat_.start(sweepInterval, [&dosGuard] { dosGuard.clear(); });
+    repeat_.start(sweepInterval, [&dosGuard] { dosGuard.sweep(); });
 }
 
 }  // namespace web::dosguard
@@ -29,7 +29,7 @@ namespace web::dosguard {
 class BaseDOSGuard;
 
 /**
- * @brief Sweep handler clearing context every sweep interval from config.
+ * @brief Sweep handler running the DOS guard's sweep every sweep interval from config.
  */
 class IntervalSweepHandler {
     util::Repeat repeat_;
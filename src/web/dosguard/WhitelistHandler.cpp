@@ -22,11 +22,13 @@
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/network_v4.hpp>
 #include <boost/asio/ip/network_v6.hpp>
+#include <boost/system/error_code.hpp>
 #include <fmt/core.h>
 
-#include <algorithm>
-#include <functional>
+#include <cstddef>
+#include <memory>
 #include <regex>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -36,20 +38,69 @@
 
 namespace web::dosguard {
 
+namespace {
+
+bool
+bitAt(std::span<unsigned char const> address, std::size_t index)
+{
+    return ((address[index / 8] >> (7 - (index % 8))) & 1) != 0;
+}
+
+}  // namespace
+
+void
+Whitelist::PrefixTrie::insert(std::span<unsigned char const> address, std::size_t prefixLength)
+{
+    auto* node = &root_;
+    for (std::size_t i = 0; i < prefixLength && not node->isPrefixEnd; ++i) {
+        auto& child = node->children[bitAt(address, i) ? 1 : 0];
+        if (not child)
+            child = std::make_unique<Node>();
+        node = child.get();
+    }
+
+    node->isPrefixEnd = true;
+}
+
+bool
+Whitelist::PrefixTrie::containsPrefixOf(std::span<unsigned char const> address) const
+{
+    auto const* node = &root_;
+    for (std::size_t i = 0; i < address.size() * 8; ++i) {
+        if (node->isPrefixEnd)
+            return true;
+
+        node = node->children[bitAt(address, i) ? 1 : 0].get();
+        if (node == nullptr)
+            return false;
+    }
+
+    return node->isPrefixEnd;
+}
+
 void
 Whitelist::add(std::string_view net)
 {
     using namespace boost::asio;
 
     if (not isMask(net)) {
-        ips_.push_back(ip::make_address(net));
+        auto const addr = ip::make_address(net);
+        if (addr.is_v4()) {
+            auto const bytes = addr.to_v4().to_bytes();
+            v4_.insert(bytes, bytes.size() * 8);
+        } else {
+            auto const bytes = addr.to_v6().to_bytes();
+            v6_.insert(bytes, bytes.size() * 8);
+        }
         return;
     }
 
     if (isV4(net)) {
-        subnetsV4_.push_back(ip::make_network_v4(net));
+        auto const subnet = ip::make_network_v4(net);
+        v4_.insert(subnet.address().to_bytes(), subnet.prefix_length());
     } else if (isV6(net)) {
-        subnetsV6_.push_back(ip::make_network_v6(net));
+        auto const subnet = ip::make_network_v6(net);
+        v6_.insert(subnet.address().to_bytes(), subnet.prefix_length());
     } else {
         throw std::runtime_error(fmt::format("malformed network: {}", net.data()));
     }
@@ -60,37 +111,15 @@ Whitelist::isWhiteListed(std::string_view ip) const
 {
     using namespace boost::asio;
 
-    auto const addr = ip::make_address(ip);
-    if (std::find(std::begin(ips_), std::end(ips_), addr) != std::end(ips_))
-        return true;
-
-    if (addr.is_v4()) {
-        return std::find_if(
-                   std::begin(subnetsV4_), std::end(subnetsV4_), std::bind_front(&isInV4Subnet, std::cref(addr))
-               ) != std::end(subnetsV4_);
-    }
-
-    if (addr.is_v6()) {
-        return std::find_if(
-                   std::begin(subnetsV6_), std::end(subnetsV6_), std::bind_front(&isInV6Subnet, std::cref(addr))
-               ) != std::end(subnetsV6_);
-    }
-
-    return false;
-}
+    boost::system::error_code ec;
+    auto const addr = ip::make_address(ip, ec);
+    if (ec)
+        return false;
 
-bool
-Whitelist::isInV4Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v4 const& subnet)
-{
-    auto const range = subnet.hosts();
-    return range.find(addr.to_v4()) != range.end();
-}
+    if (addr.is_v4())
+        return v4_.containsPrefixOf(addr.to_v4().to_bytes());
 
-bool
-Whitelist::isInV6Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v6 const& subnet)
-{
-    auto const range = subnet.hosts();
-    return range.find(addr.to_v6()) != range.end();
+    return v6_.containsPrefixOf(addr.to_v6().to_bytes());
 }
 
 bool
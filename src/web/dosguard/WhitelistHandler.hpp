@@ -31,7 +31,11 @@
 #include <fmt/core.h>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <regex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -42,11 +46,32 @@ namespace web::dosguard {
 
 /**
  * @brief A whitelist to remove rate limits of certain IP addresses.
+ *
+ * Addresses and subnets are kept in one binary prefix trie per address family, so a lookup walks at most as many
+ * nodes as the address has bits no matter how many entries the whitelist has.
  */
 class Whitelist {
-    std::vector<boost::asio::ip::network_v4> subnetsV4_;
-    std::vector<boost::asio::ip::network_v6> subnetsV6_;
-    std::vector<boost::asio::ip::address> ips_;
+    /**
+     * @brief Binary trie of address prefixes; a single address is a prefix as long as the address.
+     */
+    class PrefixTrie {
+        struct Node {
+            std::array<std::unique_ptr<Node>, 2> children;
+            bool isPrefixEnd = false;
+        };
+
+        Node root_;
+
+    public:
+        void
+        insert(std::span<unsigned char const> address, std::size_t prefixLength);
+
+        [[nodiscard]] bool
+        containsPrefixOf(std::span<unsigned char const> address) const;
+    };
+
+    PrefixTrie v4_;
+    PrefixTrie v6_;
 
 public:
     /**
@@ -62,19 +87,12 @@ public:
      * @brief Checks to see if ip address is whitelisted.
      *
      * @param ip IP address
-     * @throws std::runtime::error when the network address is not valid
-     * @return true if the given IP is whitelisted; false otherwise
+     * @return true if the given IP is whitelisted; false otherwise, including when the IP is not a valid address
      */
     bool
     isWhiteListed(std::string_view ip) const;
 
 private:
-    static bool
-    isInV4Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v4 const& subnet);
-
-    static bool
-    isInV6Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v6 const& subnet);
-
     static bool
     isV4(std::string_view net);
 
@@ -67,6 +67,10 @@ namespace web::impl {
  * The write operation also supports shared_ptr of string, so the caller can keep the string alive until it is sent.
  * It is useful when we have multiple sessions sending the same content.
  *
+ * Queued messages are written one per `async_write`: the websocket stream sends a buffer sequence as a single message,
+ * so gathering several queued messages into one write would merge them on the client side. Writing pre-framed bytes
+ * to the next layer instead would race with the control frames the stream answers from within the read operation.
+ *
  * @tparam Derived The derived class
  * @tparam HandlerType The handler type, will be called when a request is received.
  */
@@ -224,6 +228,10 @@ public:
 
         derived().ws().set_option(websocket::stream_base::timeout::suggested(role_type::server));
 
+        // Write every message as a single frame straight from the shared payload. With auto fragmentation each message
+        // is copied into the session's write buffer and sent (and encrypted for ssl sessions) in several small writes.
+        derived().ws().auto_fragment(false);
+
         // Set a decorator to change the Server of the handshake
         derived().ws().set_option(websocket::stream_base::decorator([](websocket::response_type& res) {
             res.set(http::field::server, std::string(BOOST_BEAST_VERSION_STRING) + " websocket-server-async");
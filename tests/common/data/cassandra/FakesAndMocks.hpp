@@ -19,6 +19,7 @@
 
 #include "data/cassandra/Error.hpp"
 #include "data/cassandra/impl/AsyncExecutor.hpp"
+#include "data/cassandra/impl/Batch.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <cassandra.h>
@@ -59,7 +60,14 @@ struct FakeMaybeError {};
 
 struct FakeStatement {};
 
-struct FakePreparedStatement {};
+struct FakePreparedStatement {
+    template <typename... Args>
+    static FakeStatement
+    bind(Args&&...)
+    {
+        return {};
+    }
+};
 
 struct FakeFuture {
     FakeResultOrError data;
@@ -102,6 +110,13 @@ struct MockHandle {
         (const)
     );
 
+    MOCK_METHOD(
+        FutureWithCallbackType,
+        asyncExecute,
+        (UnloggedBatch<StatementType> const&, std::function<void(ResultOrErrorType)>&&),
+        (const)
+    );
+
     MOCK_METHOD(ResultOrErrorType, execute, (StatementType const&), (const));
 };
 
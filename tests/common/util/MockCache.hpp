@@ -46,6 +46,11 @@ struct MockCache {
 
     MOCK_METHOD(std::optional<data::LedgerObject>, getPredecessor, (ripple::uint256 const& a, uint32_t b), (const));
 
+    MOCK_METHOD(void, setNumLedgers, (std::size_t), ());
+
+    MOCK_METHOD(void, enableCompression, (), ());
+    MOCK_METHOD(void, enableOwnerIndex, (), ());
+
     MOCK_METHOD(void, setDisabled, (), ());
 
     MOCK_METHOD(bool, isDisabled, (), (const));
@@ -32,4 +32,5 @@ public:
     MOCK_METHOD(bool, contains, (std::string const&), (const, override));
     MOCK_METHOD(std::optional<rpc::AnyHandler>, getHandler, (std::string const&), (const, override));
     MOCK_METHOD(bool, isClioOnly, (std::string const&), (const, override));
+    MOCK_METHOD(bool, isExpensive, (std::string const&), (const, override));
 };
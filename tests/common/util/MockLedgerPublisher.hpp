@@ -19,16 +19,25 @@
 
 #pragma once
 
+#include "data/Types.hpp"
+
 #include <gmock/gmock.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
 #include <chrono>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 struct MockLedgerPublisher {
     MOCK_METHOD(bool, publish, (uint32_t, std::optional<uint32_t>), ());
     MOCK_METHOD(void, publish, (ripple::LedgerHeader const&), ());
+    MOCK_METHOD(
+        void,
+        publish,
+        (ripple::LedgerHeader const&, std::vector<data::LedgerObject>, std::vector<data::TransactionAndMetadata>),
+        ()
+    );
     MOCK_METHOD(std::uint32_t, lastPublishAgeSeconds, (), (const));
     MOCK_METHOD(std::chrono::time_point<std::chrono::system_clock>, getLastPublish, (), (const));
     MOCK_METHOD(std::uint32_t, lastCloseAgeSeconds, (), (const));
@@ -79,6 +79,19 @@ struct MockSubscriptionManager : feed::SubscriptionManagerInterface {
 
     MOCK_METHOD(void, unsubBookChanges, (feed::SubscriberSharedPtr const&), (override));
 
+    MOCK_METHOD(void, subLedgerDiff, (feed::SubscriberSharedPtr const&), (override));
+
+    MOCK_METHOD(void, unsubLedgerDiff, (feed::SubscriberSharedPtr const&), (override));
+
+    MOCK_METHOD(
+        void,
+        pubLedgerDiff,
+        (ripple::LedgerHeader const&,
+         std::vector<data::LedgerObject> const&,
+         std::vector<data::TransactionAndMetadata> const&),
+        (const, override)
+    );
+
     MOCK_METHOD(void, subManifest, (feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, unsubManifest, (feed::SubscriberSharedPtr const&), (override));
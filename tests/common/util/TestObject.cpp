@@ -409,6 +409,18 @@ CreateOwnerDirLedgerObject(std::vector<ripple::uint256> indexes, std::string_vie
     return ownerDir;
 }
 
+ripple::STObject
+CreateBookDirLedgerObject(std::vector<ripple::uint256> indexes, std::string_view rootIndex)
+{
+    auto bookDir = CreateOwnerDirLedgerObject(std::move(indexes), rootIndex);
+    bookDir.setFieldH160(ripple::sfTakerPaysCurrency, ripple::xrpCurrency());
+    bookDir.setFieldH160(ripple::sfTakerPaysIssuer, ripple::xrpAccount());
+    bookDir.setFieldH160(ripple::sfTakerGetsCurrency, ripple::xrpCurrency());
+    bookDir.setFieldH160(ripple::sfTakerGetsIssuer, ripple::xrpAccount());
+    bookDir.setFieldU64(ripple::sfExchangeRate, ripple::getQuality(ripple::uint256{rootIndex}));
+    return bookDir;
+}
+
 ripple::STObject
 CreatePaymentChannelLedgerObject(
     std::string_view accountId,
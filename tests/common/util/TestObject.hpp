@@ -218,6 +218,12 @@ CreateMetaDataForCancelOffer(
 [[nodiscard]] ripple::STObject
 CreateOwnerDirLedgerObject(std::vector<ripple::uint256> indexes, std::string_view rootIndex);
 
+/*
+ * Create a book dir ledger object of XRP against XRP with the quality of the root index
+ */
+[[nodiscard]] ripple::STObject
+CreateBookDirLedgerObject(std::vector<ripple::uint256> indexes, std::string_view rootIndex);
+
 /*
  * Create a payment channel ledger object
  */
@@ -18,9 +18,21 @@
 //==============================================================================
 
 #include "util/LoggerFixtures.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Counter.hpp"
 
+#include <boost/json/parse.hpp>
+#include <fmt/core.h>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 using namespace util;
 
 // Used as a fixture for tests with enabled logging
@@ -84,3 +96,86 @@ TEST_F(NoLoggerTest, Basic)
     LogService::fatal() << "Still nothing";
     checkEmpty();
 }
+
+struct LogServiceAsyncTest : LoggerFixture {
+    std::filesystem::path const logDir = std::filesystem::temp_directory_path() / "clio_async_log_test";
+
+    ~LogServiceAsyncTest() override
+    {
+        std::filesystem::remove_all(logDir);
+    }
+};
+
+TEST_F(LogServiceAsyncTest, RecordsAreWrittenByBackgroundThread)
+{
+    Config const config{boost::json::parse(fmt::format(
+        R"JSON({{
+            "log_directory": "{}",
+            "log_async": {{"enabled": true, "overflow": "block"}}
+        }})JSON",
+        logDir.string()
+    ))};
+    LogService::init(config);
+
+    Logger const log{"General"};
+    for (auto i = 0; i < 1000; ++i)
+        log.info() << "Async line " << i;
+
+    LogService::shutdown();
+
+    std::ifstream file{logDir / "clio.log"};
+    std::string const content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    EXPECT_NE(content.find("General:NFO Async line 0"), std::string::npos);
+    EXPECT_NE(content.find("General:NFO Async line 999"), std::string::npos);
+    EXPECT_EQ(LogService::droppedRecords(), 0);
+}
+
+TEST_F(LogServiceAsyncTest, FatalRecordFlushesQueue)
+{
+    Config const config{boost::json::parse(fmt::format(
+        R"JSON({{
+            "log_directory": "{}",
+            "log_async": {{"enabled": true, "overflow": "drop"}}
+        }})JSON",
+        logDir.string()
+    ))};
+    LogService::init(config);
+
+    Logger const log{"General"};
+    for (auto i = 0; i < 1000; ++i)
+        log.info() << "Async line " << i;
+    log.fatal() << "Fatal line";
+
+    // read before shutdown: the fatal record must already be written together with everything queued before it
+    std::ifstream file{logDir / "clio.log"};
+    std::string const content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    EXPECT_NE(content.find("General:NFO Async line 999"), std::string::npos);
+    EXPECT_NE(content.find("General:FTL Fatal line"), std::string::npos);
+
+    LogService::shutdown();
+}
+
+TEST_F(LogServiceAsyncTest, InvalidOverflowPolicy)
+{
+    Config const config{boost::json::parse(fmt::format(
+        R"JSON({{
+            "log_directory": "{}",
+            "log_async": {{"enabled": true, "overflow": "wait"}}
+        }})JSON",
+        logDir.string()
+    ))};
+    EXPECT_THROW(LogService::init(config), std::runtime_error);
+}
+
+struct LogServiceMetricsTest : util::prometheus::WithMockPrometheus, LoggerFixture {};
+
+TEST_F(LogServiceMetricsTest, DroppedRecordsArePublished)
+{
+    auto& droppedRecordsMock = makeMock<util::prometheus::CounterInt>("log_dropped_records_total_number", "");
+
+    // records dropped before the metrics are up are published as well
+    EXPECT_CALL(droppedRecordsMock, add(LogService::droppedRecords()));
+    LogService::registerMetrics();
+
+    LogService::shutdown();
+}
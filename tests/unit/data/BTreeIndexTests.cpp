@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BTreeIndex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace data::impl;
+
+namespace {
+
+// small capacity to exercise splits and merges with a handful of keys
+using SmallIndex = BTreeIndex<std::uint64_t, std::uint64_t, 4>;
+
+}  // namespace
+
+TEST(BTreeIndexTests, EmptyIndex)
+{
+    SmallIndex const index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.find(1), nullptr);
+    EXPECT_FALSE(index.successor(0).has_value());
+    EXPECT_FALSE(index.predecessor(100).has_value());
+}
+
+TEST(BTreeIndexTests, EmplaceAndFind)
+{
+    SmallIndex index;
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        auto [value, inserted] = index.emplace(i * 2);
+        EXPECT_TRUE(inserted);
+        value = i;
+    }
+
+    auto [value, inserted] = index.emplace(10);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(value, 5u);
+
+    EXPECT_EQ(index.size(), 100u);
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        ASSERT_NE(index.find(i * 2), nullptr);
+        EXPECT_EQ(*index.find(i * 2), i);
+        EXPECT_EQ(index.find((i * 2) + 1), nullptr);
+    }
+}
+
+TEST(BTreeIndexTests, SuccessorAndPredecessor)
+{
+    SmallIndex index;
+    for (std::uint64_t i = 1; i <= 50; ++i)
+        index.emplace(i * 10).first = i;
+
+    auto const succ = index.successor(10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->first, 20u);
+    EXPECT_EQ(succ->second, 2u);
+
+    auto const succOfMissing = index.successor(15);
+    ASSERT_TRUE(succOfMissing.has_value());
+    EXPECT_EQ(succOfMissing->first, 20u);
+
+    EXPECT_FALSE(index.successor(500).has_value());
+
+    auto const pred = index.predecessor(20);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->first, 10u);
+
+    auto const predOfMissing = index.predecessor(501);
+    ASSERT_TRUE(predOfMissing.has_value());
+    EXPECT_EQ(predOfMissing->first, 500u);
+
+    EXPECT_FALSE(index.predecessor(10).has_value());
+}
+
+TEST(BTreeIndexTests, EraseEverything)
+{
+    SmallIndex index;
+    for (std::uint64_t i = 0; i < 100; ++i)
+        index.emplace(i).first = i;
+
+    EXPECT_FALSE(index.erase(1000).has_value());
+
+    for (std::uint64_t i = 0; i < 100; i += 2) {
+        auto const removed = index.erase(i);
+        ASSERT_TRUE(removed.has_value());
+        EXPECT_EQ(*removed, i);
+    }
+
+    EXPECT_EQ(index.size(), 50u);
+    auto succ = index.successor(10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->first, 11u);
+
+    for (std::uint64_t i = 1; i < 100; i += 2)
+        EXPECT_TRUE(index.erase(i).has_value());
+
+    EXPECT_TRUE(index.empty());
+    EXPECT_FALSE(index.successor(0).has_value());
+}
+
+TEST(BTreeIndexTests, ForEachVisitsKeysInOrder)
+{
+    SmallIndex index;
+    for (std::uint64_t const key : {5, 3, 9, 1, 7, 8, 2})
+        index.emplace(key).first = key * 10;
+
+    std::vector<std::uint64_t> keys;
+    index.forEach([&keys](auto const& key, auto const& value) {
+        EXPECT_EQ(value, key * 10);
+        keys.push_back(key);
+    });
+
+    EXPECT_EQ(keys, (std::vector<std::uint64_t>{1, 2, 3, 5, 7, 8, 9}));
+}
+
+TEST(BTreeIndexTests, MatchesStdMapUnderRandomOperations)
+{
+    SmallIndex index;
+    std::map<std::uint64_t, std::uint64_t> reference;
+    std::mt19937_64 rng{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+    for (std::uint64_t i = 0; i < 20000; ++i) {
+        auto const key = rng() % 1000;
+        if (rng() % 2 == 0) {
+            auto [value, inserted] = index.emplace(key);
+            EXPECT_EQ(inserted, reference.try_emplace(key).second);
+            value = i;
+            reference[key] = i;
+        } else {
+            auto const removed = index.erase(key);
+            EXPECT_EQ(removed.has_value(), reference.erase(key) == 1);
+        }
+
+        auto const probe = rng() % 1000;
+        auto const succ = index.successor(probe);
+        auto const it = reference.upper_bound(probe);
+        ASSERT_EQ(succ.has_value(), it != reference.end());
+        if (succ.has_value()) {
+            EXPECT_EQ(succ->first, it->first);
+            EXPECT_EQ(succ->second, it->second);
+        }
+    }
+
+    EXPECT_EQ(index.size(), reference.size());
+}
+
+TEST(BTreeIndexTests, SnapshotIsNotAffectedByLaterModifications)
+{
+    SmallIndex index;
+    std::map<std::uint64_t, std::uint64_t> reference;
+    std::vector<std::pair<SmallIndex, std::map<std::uint64_t, std::uint64_t>>> snapshots;
+    std::mt19937_64 rng{7};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+    for (std::uint64_t i = 0; i < 5000; ++i) {
+        auto const key = rng() % 300;
+        if (rng() % 3 != 0) {
+            index.emplace(key).first = i;
+            reference[key] = i;
+        } else {
+            index.erase(key);
+            reference.erase(key);
+        }
+
+        if (i % 500 == 0)
+            snapshots.emplace_back(index.snapshot(), reference);
+    }
+
+    for (auto const& [snapshot, expected] : snapshots) {
+        ASSERT_EQ(snapshot.size(), expected.size());
+
+        std::map<std::uint64_t, std::uint64_t> actual;
+        snapshot.forEach([&actual](auto const& key, auto const& value) { actual.emplace(key, value); });
+        EXPECT_EQ(actual, expected);
+    }
+}
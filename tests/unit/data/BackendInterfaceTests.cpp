@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include "data/Types.hpp"
 #include "etl/CorruptionDetector.hpp"
 #include "etl/SystemState.hpp"
 #include "util/AsioContextTestFixture.hpp"
@@ -30,8 +31,12 @@
 #include <xrpl/basics/XRPAmount.h>
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <utility>
 #include <vector>
 
 using namespace data;
@@ -137,3 +142,131 @@ TEST_F(BackendInterfaceTest, FetchLedgerPageWithoutCorruptionDetectorDoesNotDisa
     runSpawn([this](auto yield) { backend->fetchLedgerPage(std::nullopt, MAXSEQ, 10, false, yield); });
     EXPECT_FALSE(backend->cache().isDisabled());
 }
+
+struct BackendInterfaceBookOffersTest : BackendInterfaceTest {
+    ripple::uint256 const book{"1000000000000000000000000000000000000000000000000000000000000000"};
+    ripple::uint256 const dir{"1000000000000000000000000000000000000000000000000000000000000001"};
+    std::vector<ripple::uint256> const offers{
+        ripple::uint256{"A000000000000000000000000000000000000000000000000000000000000001"},
+        ripple::uint256{"A000000000000000000000000000000000000000000000000000000000000002"},
+        ripple::uint256{"A000000000000000000000000000000000000000000000000000000000000003"},
+    };
+
+    Blob
+    makeDirPage(std::vector<ripple::uint256> pageOffers, std::uint64_t next, std::uint64_t previous) const
+    {
+        auto page = CreateBookDirLedgerObject(std::move(pageOffers), ripple::to_string(dir));
+        page.setFieldU64(ripple::sfIndexNext, next);
+        page.setFieldU64(ripple::sfIndexPrevious, previous);
+        return page.getSerializer().peekData();
+    }
+};
+
+TEST_F(BackendInterfaceBookOffersTest, DirectoryPagesAreReadAhead)
+{
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    auto const page1 = ripple::keylet::page(dir, 1).key;
+    auto const page2 = ripple::keylet::page(dir, 2).key;
+
+    EXPECT_CALL(*backend, doFetchSuccessorKey(book, MAXSEQ, _)).WillOnce(Return(dir));
+    EXPECT_CALL(*backend, doFetchLedgerObject(dir, MAXSEQ, _)).WillOnce(Return(makeDirPage({offers[0]}, 1, 2)));
+    EXPECT_CALL(*backend, doFetchLedgerObjects(std::vector{page1, page2}, MAXSEQ, _))
+        .WillOnce(Return(std::vector{makeDirPage({offers[1]}, 2, 0), makeDirPage({offers[2]}, 0, 1)}));
+    EXPECT_CALL(*backend, doFetchLedgerObjects(offers, MAXSEQ, _)).WillOnce(Return(std::vector<Blob>(3, Blob{'s'})));
+    EXPECT_CALL(*backend, doFetchSuccessorKey(dir, MAXSEQ, _)).WillOnce(Return(std::nullopt));
+
+    runSpawn([&](auto yield) {
+        auto const page = backend->fetchBookOffers(book, MAXSEQ, 100, yield);
+        ASSERT_EQ(page.offers.size(), offers.size());
+        for (std::size_t i = 0; i < offers.size(); ++i)
+            EXPECT_EQ(page.offers[i].key, offers[i]);
+    });
+}
+
+TEST_F(BackendInterfaceBookOffersTest, FullCacheServesDirectoriesOfPreviousLedgers)
+{
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    std::vector<LedgerObject> objects{{.key = dir, .blob = makeDirPage({offers[0]}, 0, 0)}};
+    for (auto const& offer : offers)
+        objects.push_back({.key = offer, .blob = Blob{'s'}});
+
+    backend->cache().update(objects, MAXSEQ - 1);
+    backend->cache().setFull();
+    backend->cache().update({}, MAXSEQ);
+
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObjects).Times(0);
+
+    runSpawn([&](auto yield) {
+        auto const page = backend->fetchBookOffers(book, MAXSEQ - 1, 100, yield);
+        ASSERT_EQ(page.offers.size(), 1);
+        EXPECT_EQ(page.offers.front().key, offers[0]);
+    });
+}
+
+TEST_F(BackendInterfaceBookOffersTest, BookIndexServesLatestLedger)
+{
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    auto const page1 = ripple::keylet::page(dir, 1).key;
+    std::vector<LedgerObject> objects{
+        {.key = dir, .blob = makeDirPage({offers[0]}, 1, 1)}, {.key = page1, .blob = makeDirPage({offers[1]}, 0, 0)}
+    };
+    for (auto const& offer : offers)
+        objects.push_back({.key = offer, .blob = Blob{'s'}});
+
+    backend->cache().update(objects, MAXSEQ);
+    backend->cache().setFull();
+
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObjects).Times(0);
+
+    runSpawn([&](auto yield) {
+        auto const page = backend->fetchBookOffers(book, MAXSEQ, 100, yield);
+        ASSERT_EQ(page.offers.size(), 2);
+        EXPECT_EQ(page.offers[0].key, offers[0]);
+        EXPECT_EQ(page.offers[1].key, offers[1]);
+    });
+}
+
+TEST_F(BackendInterfaceBookOffersTest, BookIndexAndDatabaseFollowTheSameLimit)
+{
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    auto const page1 = ripple::keylet::page(dir, 1).key;
+    auto const rootPage = makeDirPage({offers[0]}, 1, 1);
+    auto const lastPage = makeDirPage({offers[1], offers[2]}, 0, 0);
+    auto const limitedOffers = std::vector{offers[0], offers[1]};
+
+    EXPECT_CALL(*backend, doFetchSuccessorKey(book, MAXSEQ, _)).WillOnce(Return(dir));
+    EXPECT_CALL(*backend, doFetchLedgerObject(dir, MAXSEQ, _)).WillOnce(Return(rootPage));
+    EXPECT_CALL(*backend, doFetchLedgerObject(page1, MAXSEQ, _)).WillOnce(Return(lastPage));
+    EXPECT_CALL(*backend, doFetchLedgerObjects(limitedOffers, MAXSEQ, _))
+        .WillOnce(Return(std::vector<Blob>(2, Blob{'s'})));
+
+    std::vector<ripple::uint256> fromDatabase;
+    runSpawn([&](auto yield) {
+        for (auto const& offer : backend->fetchBookOffers(book, MAXSEQ, 2, yield).offers)
+            fromDatabase.push_back(offer.key);
+    });
+
+    std::vector<LedgerObject> objects{{.key = dir, .blob = rootPage}, {.key = page1, .blob = lastPage}};
+    for (auto const& offer : offers)
+        objects.push_back({.key = offer, .blob = Blob{'s'}});
+
+    backend->cache().update(objects, MAXSEQ);
+    backend->cache().setFull();
+
+    std::vector<ripple::uint256> fromIndex;
+    runSpawn([&](auto yield) {
+        for (auto const& offer : backend->fetchBookOffers(book, MAXSEQ, 2, yield).offers)
+            fromIndex.push_back(offer.key);
+    });
+
+    EXPECT_EQ(fromDatabase, limitedOffers);
+    EXPECT_EQ(fromIndex, fromDatabase);
+}
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BlobArena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+using namespace data::impl;
+
+namespace {
+
+std::vector<unsigned char>
+makeBlob(std::size_t size, unsigned char fill)
+{
+    return std::vector<unsigned char>(size, fill);
+}
+
+std::vector<unsigned char>
+toVector(BlobArena::Handle const& handle)
+{
+    auto const bytes = handle.bytes();
+    return {bytes.begin(), bytes.end()};
+}
+
+}  // namespace
+
+TEST(BlobArenaTests, DefaultHandleIsEmpty)
+{
+    BlobArena::Handle const handle;
+    EXPECT_FALSE(handle.isValid());
+    EXPECT_TRUE(handle.bytes().empty());
+}
+
+TEST(BlobArenaTests, StoreAndRead)
+{
+    BlobArena arena;
+    auto const small = makeBlob(10, 'a');
+    auto const large = makeBlob(BlobArena::MAX_CLASS_SIZE * 2, 'b');
+
+    auto const smallHandle = arena.store(small);
+    auto const largeHandle = arena.store(large);
+
+    EXPECT_EQ(toVector(smallHandle), small);
+    EXPECT_EQ(toVector(largeHandle), large);
+    EXPECT_GE(arena.reservedBytes(), arena.usedBytes());
+    EXPECT_GE(arena.usedBytes(), small.size() + large.size());
+
+    arena.release(smallHandle);
+    arena.release(largeHandle);
+    EXPECT_EQ(arena.usedBytes(), 0u);
+    EXPECT_EQ(arena.reservedBytes(), BlobArena::CHUNK_SIZE);
+}
+
+TEST(BlobArenaTests, ReleasedSlotIsReused)
+{
+    BlobArena arena;
+    auto const first = arena.store(makeBlob(100, 'a'));
+    arena.release(first);
+
+    auto const second = arena.store(makeBlob(98, 'b'));
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(toVector(second), makeBlob(98, 'b'));
+}
+
+TEST(BlobArenaTests, DifferentSizeClassesDoNotShareSlots)
+{
+    BlobArena arena;
+    auto const first = arena.store(makeBlob(10, 'a'));
+    arena.release(first);
+
+    auto const second = arena.store(makeBlob(200, 'b'));
+    EXPECT_NE(first, second);
+}
@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/BlobCodec.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace data;
+using namespace data::impl;
+
+namespace {
+
+// blobs that share most of their structure with each other, like serialized ledger objects do
+Blob
+makeSimilarBlob(std::mt19937& rng)
+{
+    Blob blob{0x11, 0x00, 0x61, 0x22, 0x00, 0x00, 0x00, 0x00, 0x24};
+    for (auto i = 0; i < 4; ++i)
+        blob.push_back(static_cast<unsigned char>(rng() % 4));
+    blob.insert(blob.end(), {0x25, 0x05, 0x5E, 0x8F, 0x3A, 0x55});
+    for (auto i = 0; i < 32; ++i)
+        blob.push_back(static_cast<unsigned char>(rng()));
+    blob.insert(blob.end(), {0x81, 0x14, 0xB5, 0xF7, 0x62, 0x79, 0x8A, 0x53, 0xD5, 0x43, 0xA0, 0x14});
+    blob.insert(blob.end(), 40, 0x20);
+    return blob;
+}
+
+struct BlobCodecTest : ::testing::Test {
+    std::mt19937 rng{17};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<unsigned char> samples;
+    std::vector<std::size_t> sampleSizes;
+
+    BlobCodecTest()
+    {
+        for (auto i = 0; i < 2000; ++i) {
+            auto const blob = makeSimilarBlob(rng);
+            samples.insert(samples.end(), blob.begin(), blob.end());
+            sampleSizes.push_back(blob.size());
+        }
+    }
+};
+
+}  // namespace
+
+TEST_F(BlobCodecTest, CompressAndDecompress)
+{
+    auto const codec = BlobCodec::train(samples, sampleSizes);
+    ASSERT_NE(codec, nullptr);
+
+    auto const blob = makeSimilarBlob(rng);
+    auto const compressed = codec->compress(blob);
+    ASSERT_TRUE(compressed.has_value());
+    EXPECT_LT(compressed->size(), blob.size());
+    EXPECT_EQ(codec->decompress(*compressed), blob);
+}
+
+TEST_F(BlobCodecTest, IncompressibleBlobIsNotCompressed)
+{
+    auto const codec = BlobCodec::train(samples, sampleSizes);
+    ASSERT_NE(codec, nullptr);
+
+    Blob blob(64);
+    for (auto& byte : blob)
+        byte = static_cast<unsigned char>(rng());
+
+    EXPECT_FALSE(codec->compress(blob).has_value());
+}
+
+TEST_F(BlobCodecTest, TrainingFailsWithoutEnoughSamples)
+{
+    std::vector<std::size_t> const sizes{samples.size() / 2, samples.size() - (samples.size() / 2)};
+    EXPECT_EQ(BlobCodec::train(samples, sizes), nullptr);
+}
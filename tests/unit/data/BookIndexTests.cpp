@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/BookIndex.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/Blob.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace data;
+using namespace data::impl;
+
+namespace {
+
+constexpr std::uint32_t SEQ = 30;
+
+ripple::uint256 const BOOK{"ABABABABABABABABABABABABABABABABABABABABABABABAB0000000000000000"};
+ripple::uint256 const BEST_DIR{"ABABABABABABABABABABABABABABABABABABABABABABABAB0000000000000001"};
+ripple::uint256 const WORST_DIR{"ABABABABABABABABABABABABABABABABABABABABABABABAB0000000000000002"};
+ripple::uint256 const OTHER_BOOK_DIR{"CDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCDCD0000000000000001"};
+
+ripple::uint256 const OFFER1{"1000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const OFFER2{"2000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const OFFER3{"3000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const OFFER4{"4000000000000000000000000000000000000000000000000000000000000000"};
+
+Blob
+dirPage(ripple::uint256 const& root, std::vector<ripple::uint256> offers, std::uint64_t next = 0)
+{
+    auto page = CreateBookDirLedgerObject(std::move(offers), ripple::to_string(root));
+    page.setFieldU64(ripple::sfIndexNext, next);
+    return page.getSerializer().peekData();
+}
+
+void
+update(BookIndex& index, std::vector<LedgerObject> const& objs, std::uint32_t seq = SEQ)
+{
+    index.update({objs.begin(), objs.end()}, seq);
+}
+
+}  // namespace
+
+TEST(BookIndexTests, EmptyIndex)
+{
+    BookIndex const index;
+    EXPECT_EQ(index.numBooks(), 0u);
+    EXPECT_EQ(index.getOffers(BOOK, 0, 10), std::vector<ripple::uint256>{});
+}
+
+TEST(BookIndexTests, OffersAreInQualityAndPageOrder)
+{
+    BookIndex index;
+    auto const secondPage = ripple::keylet::page(BEST_DIR, 1).key;
+    update(
+        index,
+        {
+            {.key = WORST_DIR, .blob = dirPage(WORST_DIR, {OFFER4})},
+            {.key = secondPage, .blob = dirPage(BEST_DIR, {OFFER3})},
+            {.key = BEST_DIR, .blob = dirPage(BEST_DIR, {OFFER1, OFFER2}, 1)},
+            {.key = OTHER_BOOK_DIR, .blob = dirPage(OTHER_BOOK_DIR, {OFFER1})},
+        }
+    );
+
+    EXPECT_EQ(index.numBooks(), 2u);
+    EXPECT_EQ(index.getOffers(BOOK, SEQ, 10), (std::vector{OFFER1, OFFER2, OFFER3, OFFER4}));
+    EXPECT_EQ(index.getOffers(BOOK, SEQ, 3), (std::vector{OFFER1, OFFER2, OFFER3}));
+
+    // whole pages are returned, like the directories are walked in the database
+    EXPECT_EQ(index.getOffers(BOOK, SEQ, 1), (std::vector{OFFER1, OFFER2}));
+}
+
+TEST(BookIndexTests, OnlyLatestLedgerIsServed)
+{
+    BookIndex index;
+    update(index, {{.key = BEST_DIR, .blob = dirPage(BEST_DIR, {OFFER1})}});
+    update(index, {}, SEQ + 1);
+
+    EXPECT_FALSE(index.getOffers(BOOK, SEQ, 10).has_value());
+    EXPECT_EQ(index.getOffers(BOOK, SEQ + 1, 10), (std::vector{OFFER1}));
+}
+
+TEST(BookIndexTests, ModifiedAndDeletedDirectories)
+{
+    BookIndex index;
+    update(
+        index,
+        {
+            {.key = BEST_DIR, .blob = dirPage(BEST_DIR, {OFFER1})},
+            {.key = WORST_DIR, .blob = dirPage(WORST_DIR, {OFFER2})},
+        }
+    );
+
+    update(index, {{.key = BEST_DIR, .blob = dirPage(BEST_DIR, {OFFER3})}}, SEQ + 1);
+    EXPECT_EQ(index.getOffers(BOOK, SEQ + 1, 10), (std::vector{OFFER3, OFFER2}));
+
+    update(index, {{.key = BEST_DIR, .blob = {}}}, SEQ + 2);
+    EXPECT_EQ(index.getOffers(BOOK, SEQ + 2, 10), (std::vector{OFFER2}));
+
+    update(index, {{.key = WORST_DIR, .blob = {}}}, SEQ + 3);
+    EXPECT_EQ(index.getOffers(BOOK, SEQ + 3, 10), std::vector<ripple::uint256>{});
+    EXPECT_EQ(index.numBooks(), 0u);
+}
+
+TEST(BookIndexTests, OtherObjectsAreIgnored)
+{
+    auto ownerDir = CreateOwnerDirLedgerObject({OFFER1}, ripple::to_string(BEST_DIR));
+    ownerDir.setAccountID(ripple::sfOwner, GetAccountIDWithString("rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"));
+
+    // the directory of the NFT offers of a token has neither an owner nor an exchange rate
+    auto const nftOffersDir = CreateOwnerDirLedgerObject({OFFER2}, ripple::to_string(WORST_DIR));
+
+    BookIndex index;
+    update(
+        index,
+        {
+            {.key = BEST_DIR, .blob = ownerDir.getSerializer().peekData()},
+            {.key = WORST_DIR, .blob = nftOffersDir.getSerializer().peekData()},
+            {.key = OTHER_BOOK_DIR, .blob = {'a', 'b', 'c'}},
+            {.key = OFFER1, .blob = {}},
+        }
+    );
+
+    EXPECT_EQ(index.numBooks(), 0u);
+    EXPECT_EQ(index.getOffers(BOOK, SEQ, 10), std::vector<ripple::uint256>{});
+}
+
+TEST(BookIndexTests, MissingPageIsNotServed)
+{
+    BookIndex index;
+    update(index, {{.key = BEST_DIR, .blob = dirPage(BEST_DIR, {OFFER1}, 1)}});
+
+    EXPECT_EQ(index.getOffers(BOOK, SEQ, 1), (std::vector{OFFER1}));
+    EXPECT_FALSE(index.getOffers(BOOK, SEQ, 10).has_value());
+}
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/LedgerCacheFile.hpp"
+#include "data/Types.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr uint32_t SEQ = 30;
+
+ripple::uint256 const KEY1{"1000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const KEY2{"2000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const KEY3{"3000000000000000000000000000000000000000000000000000000000000000"};
+
+Blob const BLOB1{'a', 'b', 'c'};
+Blob const BLOB2{'d', 'e'};
+Blob const BLOB3{'f'};
+
+}  // namespace
+
+struct LedgerCacheFileTest : WithPrometheus {
+    TmpFile tmpFile{""};
+    LedgerCacheFile file{tmpFile.path};
+    LedgerCache cache;
+
+    LedgerCacheFileTest()
+    {
+        cache.update({{KEY2, BLOB2}, {KEY1, BLOB1}, {KEY3, BLOB3}}, SEQ);
+        cache.setFull();
+    }
+
+    std::vector<LedgerObject>
+    readAll(std::size_t pageSize = 2)
+    {
+        std::vector<LedgerObject> objects;
+        auto const seq = file.read(
+            [&objects](std::vector<LedgerObject> const& page, uint32_t seq) {
+                EXPECT_EQ(seq, SEQ);
+                objects.insert(objects.end(), page.begin(), page.end());
+            },
+            pageSize
+        );
+        EXPECT_EQ(seq, SEQ);
+        return objects;
+    }
+
+    void
+    overwriteByte(std::streamoff offset, char value) const
+    {
+        std::fstream stream{tmpFile.path, std::ios::in | std::ios::out | std::ios::binary};
+        stream.seekp(offset);
+        stream.put(value);
+    }
+};
+
+TEST_F(LedgerCacheFileTest, WriteAndRead)
+{
+    ASSERT_EQ(file.write(cache), SEQ);
+    EXPECT_EQ(file.readSequence(), SEQ);
+    EXPECT_FALSE(std::filesystem::exists(tmpFile.path + ".tmp"));
+
+    auto const objects = readAll();
+    ASSERT_EQ(objects.size(), 3u);
+    EXPECT_EQ(objects[0].key, KEY1);
+    EXPECT_EQ(objects[0].blob, BLOB1);
+    EXPECT_EQ(objects[1].key, KEY2);
+    EXPECT_EQ(objects[1].blob, BLOB2);
+    EXPECT_EQ(objects[2].key, KEY3);
+    EXPECT_EQ(objects[2].blob, BLOB3);
+}
+
+TEST_F(LedgerCacheFileTest, MissingFile)
+{
+    LedgerCacheFile const missing{tmpFile.path + ".missing"};
+    EXPECT_FALSE(missing.readSequence().has_value());
+    EXPECT_FALSE(missing.read([](auto const&, auto) { FAIL(); }, 2).has_value());
+}
+
+TEST_F(LedgerCacheFileTest, CorruptedObjectIsDetected)
+{
+    ASSERT_TRUE(file.write(cache).has_value());
+    overwriteByte(30, 'x');
+
+    // the header is still fine, the checksum is not
+    EXPECT_EQ(file.readSequence(), SEQ);
+    auto const result = file.read([](auto const&, auto) { FAIL(); }, 2);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), "Checksum mismatch");
+}
+
+TEST_F(LedgerCacheFileTest, OtherFileIsRejected)
+{
+    ASSERT_TRUE(file.write(cache).has_value());
+    overwriteByte(0, 'X');
+
+    EXPECT_FALSE(file.readSequence().has_value());
+    EXPECT_FALSE(file.read([](auto const&, auto) { FAIL(); }, 2).has_value());
+}
+
+TEST_F(LedgerCacheFileTest, NewerVersionIsRejected)
+{
+    ASSERT_TRUE(file.write(cache).has_value());
+    overwriteByte(8, static_cast<char>(LedgerCacheFile::VERSION + 1));
+
+    auto const result = file.readSequence();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), "Unsupported version 2");
+}
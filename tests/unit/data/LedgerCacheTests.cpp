@@ -0,0 +1,340 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr uint32_t SEQ = 30;
+
+ripple::uint256 const KEY1{"1000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const KEY2{"2000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const KEY3{"3000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const KEY4{"4000000000000000000000000000000000000000000000000000000000000000"};
+
+Blob const BLOB1{'a', 'b', 'c'};
+Blob const BLOB2{'d', 'e'};
+Blob const BLOB3{'f'};
+
+// objects large enough to be inspected for their type
+Blob const OBJECT1{0x11, 0x00, 0x61, 0x22, 0x00, 0x00, 0x00, 0x00};
+Blob const OBJECT2{0x11, 0x00, 0x72, 0x22, 0x00, 0x00, 0x00, 0x00};
+
+// the book base and two directories of the book
+ripple::uint256 const BOOK_BASE{"ABABABABABABABABABABABABABABABABABABABABABABABAB0000000000000000"};
+ripple::uint256 const BOOK_DIR1{"ABABABABABABABABABABABABABABABABABABABABABABABAB0000000000000001"};
+ripple::uint256 const BOOK_DIR2{"ABABABABABABABABABABABABABABABABABABABABABABABAB0000000000000002"};
+
+Blob
+bookDirBlob()
+{
+    auto const dir = CreateOwnerDirLedgerObject({}, "0000000000000000000000000000000000000000000000000000000000000000");
+    return dir.getSerializer().peekData();
+}
+
+}  // namespace
+
+struct LedgerCacheTest : WithPrometheus {
+    LedgerCache cache;
+};
+
+TEST_F(LedgerCacheTest, EmptyCache)
+{
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.latestLedgerSequence(), 0u);
+    EXPECT_FALSE(cache.get(KEY1, SEQ).has_value());
+}
+
+TEST_F(LedgerCacheTest, UpdateAndGet)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, SEQ);
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.latestLedgerSequence(), SEQ);
+    EXPECT_EQ(cache.get(KEY1, SEQ), BLOB1);
+    EXPECT_EQ(cache.get(KEY2, SEQ), BLOB2);
+    EXPECT_FALSE(cache.get(KEY3, SEQ).has_value());
+
+    // not available for sequences before the object was written nor after the latest sequence
+    EXPECT_FALSE(cache.get(KEY1, SEQ - 1).has_value());
+    EXPECT_FALSE(cache.get(KEY1, SEQ + 1).has_value());
+}
+
+TEST_F(LedgerCacheTest, ModifyAndDelete)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, SEQ);
+    cache.update({{KEY1, BLOB3}, {KEY2, {}}}, SEQ + 1);
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.get(KEY1, SEQ + 1), BLOB3);
+    EXPECT_FALSE(cache.get(KEY2, SEQ + 1).has_value());
+}
+
+TEST_F(LedgerCacheTest, RecentLedgersAreServed)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, SEQ);
+    cache.setFull();
+    cache.update({{KEY1, BLOB3}, {KEY2, {}}, {KEY3, BLOB3}}, SEQ + 1);
+
+    EXPECT_EQ(cache.get(KEY1, SEQ), BLOB1);
+    EXPECT_EQ(cache.get(KEY2, SEQ), BLOB2);
+    EXPECT_FALSE(cache.get(KEY3, SEQ).has_value());
+    EXPECT_EQ(cache.get(KEY1, SEQ + 1), BLOB3);
+    EXPECT_FALSE(cache.get(KEY2, SEQ + 1).has_value());
+
+    EXPECT_EQ(cache.getSuccessor(KEY1, SEQ)->key, KEY2);
+    EXPECT_EQ(cache.getSuccessor(KEY1, SEQ + 1)->key, KEY3);
+    EXPECT_EQ(cache.getPredecessor(KEY3, SEQ)->key, KEY2);
+    EXPECT_EQ(cache.getPredecessor(KEY3, SEQ + 1)->key, KEY1);
+}
+
+TEST_F(LedgerCacheTest, LedgersOutsideOfWindowAreNotServed)
+{
+    cache.setNumLedgers(2);
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, SEQ);
+    cache.setFull();
+    cache.update({{KEY1, BLOB2}}, SEQ + 1);
+    cache.update({{KEY1, BLOB3}}, SEQ + 2);
+
+    EXPECT_EQ(cache.get(KEY1, SEQ + 1), BLOB2);
+    EXPECT_FALSE(cache.get(KEY1, SEQ).has_value());
+    EXPECT_FALSE(cache.getSuccessor(KEY1, SEQ).has_value());
+
+    // objects that did not change since are still served
+    EXPECT_EQ(cache.get(KEY2, SEQ), BLOB2);
+}
+
+TEST_F(LedgerCacheTest, SuccessorIsNotServedForLedgersBeforeCacheWasFull)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, SEQ);
+    cache.update({{KEY3, BLOB3}}, SEQ + 1);
+    cache.setFull();
+
+    EXPECT_FALSE(cache.getSuccessor(KEY1, SEQ).has_value());
+    EXPECT_EQ(cache.getSuccessor(KEY2, SEQ + 1)->key, KEY3);
+}
+
+TEST_F(LedgerCacheTest, BackgroundUpdateDoesNotOverrideNewerData)
+{
+    cache.update({{KEY1, BLOB1}}, SEQ + 1);
+    cache.update({{KEY2, {}}}, SEQ + 2);
+
+    cache.update({{KEY1, BLOB2}, {KEY2, BLOB2}, {KEY3, BLOB3}}, SEQ, true);
+
+    EXPECT_EQ(cache.get(KEY1, SEQ + 2), BLOB1);
+    EXPECT_FALSE(cache.get(KEY2, SEQ + 2).has_value());
+    EXPECT_EQ(cache.get(KEY3, SEQ + 2), BLOB3);
+}
+
+TEST_F(LedgerCacheTest, SuccessorAndPredecessorRequireFullCache)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}, {KEY3, BLOB3}}, SEQ);
+    EXPECT_FALSE(cache.getSuccessor(KEY1, SEQ).has_value());
+    EXPECT_FALSE(cache.getPredecessor(KEY2, SEQ).has_value());
+
+    cache.setFull();
+
+    auto const succ = cache.getSuccessor(KEY1, SEQ);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, KEY2);
+    EXPECT_EQ(succ->blob, BLOB2);
+    EXPECT_FALSE(cache.getSuccessor(KEY3, SEQ).has_value());
+    EXPECT_EQ(cache.getSuccessor(firstKey, SEQ)->key, KEY1);
+
+    auto const pred = cache.getPredecessor(KEY2, SEQ);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->key, KEY1);
+    EXPECT_EQ(pred->blob, BLOB1);
+    EXPECT_FALSE(cache.getPredecessor(KEY1, SEQ).has_value());
+    EXPECT_EQ(cache.getPredecessor(lastKey, SEQ)->key, KEY3);
+
+    // only the latest sequence is served
+    EXPECT_FALSE(cache.getSuccessor(KEY1, SEQ - 1).has_value());
+}
+
+TEST_F(LedgerCacheTest, ReadersSeeConsistentLedgersWhileUpdating)
+{
+    static constexpr uint32_t NUM_LEDGERS = 500;
+
+    // every ledger writes its own sequence into both keys, so a reader must always see the same value in both
+    auto const blobFor = [](uint32_t seq) { return Blob(seq % 300 + 1, static_cast<unsigned char>(seq)); };
+
+    cache.update({{KEY1, blobFor(SEQ)}, {KEY2, blobFor(SEQ)}}, SEQ);
+    cache.setFull();
+
+    std::atomic_bool stop = false;
+    std::vector<std::thread> readers;
+    for (auto i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (not stop) {
+                auto const seq = cache.latestLedgerSequence();
+                // both can miss if a newer ledger was published in the meantime, but must never mix ledgers
+                if (auto const first = cache.get(KEY1, seq); first.has_value()) {
+                    EXPECT_EQ(*first, blobFor(seq));
+                }
+                if (auto const second = cache.getSuccessor(KEY1, seq); second.has_value()) {
+                    EXPECT_EQ(second->key, KEY2);
+                    EXPECT_EQ(second->blob, blobFor(seq));
+                }
+            }
+        });
+    }
+
+    for (auto seq = SEQ + 1; seq < SEQ + NUM_LEDGERS; ++seq)
+        cache.update({{KEY1, blobFor(seq)}, {KEY2, blobFor(seq)}}, seq);
+
+    stop = true;
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.get(KEY2, SEQ + NUM_LEDGERS - 1), blobFor(SEQ + NUM_LEDGERS - 1));
+}
+
+TEST_F(LedgerCacheTest, CompressedObjectsAreReadBack)
+{
+    cache.enableCompression();
+
+    // enough similar objects to train the dictionary and then some that are stored compressed
+    std::vector<LedgerObject> objects;
+    std::size_t totalSize = 0;
+    for (uint64_t i = 0; totalSize < 2 * LedgerCache::COMPRESSION_SAMPLE_BYTES; ++i) {
+        ripple::uint256 key;
+        std::memcpy(key.data(), &i, sizeof(i));
+        Blob blob(200, static_cast<unsigned char>(i % 7));
+        std::memcpy(blob.data() + 100, &i, sizeof(i));
+        totalSize += blob.size();
+        objects.push_back({key, std::move(blob)});
+    }
+
+    cache.update(objects, SEQ);
+    cache.setFull();
+
+    EXPECT_EQ(cache.size(), objects.size());
+    for (auto const& obj : objects)
+        ASSERT_EQ(cache.get(obj.key, SEQ), obj.blob);
+
+    auto const succ = cache.getSuccessor(objects.back().key, SEQ);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(cache.get(succ->key, SEQ), succ->blob);
+}
+
+TEST_F(LedgerCacheTest, SuccessorsOfCreatedAndDeletedObjects)
+{
+    cache.update({{KEY1, OBJECT1}, {KEY3, OBJECT1}}, SEQ);
+    cache.setFull();
+
+    auto const deltas =
+        cache.updateAndGetSuccessors({{KEY1, OBJECT2}, {KEY2, OBJECT1}, {KEY3, {}}, {KEY4, OBJECT1}}, SEQ + 1);
+
+    std::vector<LedgerCache::SuccessorDelta> const expected{
+        {.key = KEY1, .successor = KEY2}, {.key = KEY2, .successor = KEY4}, {.key = KEY4, .successor = lastKey}
+    };
+    EXPECT_EQ(deltas, expected);
+    EXPECT_EQ(cache.latestLedgerSequence(), SEQ + 1);
+    EXPECT_EQ(cache.get(KEY1, SEQ + 1), OBJECT2);
+    EXPECT_FALSE(cache.get(KEY3, SEQ + 1).has_value());
+}
+
+TEST_F(LedgerCacheTest, NoSuccessorsForModifiedObjects)
+{
+    cache.update({{KEY1, OBJECT1}, {KEY2, OBJECT1}}, SEQ);
+    cache.setFull();
+
+    EXPECT_TRUE(cache.updateAndGetSuccessors({{KEY1, OBJECT2}, {KEY2, OBJECT2}}, SEQ + 1).empty());
+    EXPECT_EQ(cache.get(KEY2, SEQ + 1), OBJECT2);
+}
+
+TEST_F(LedgerCacheTest, SuccessorsRequireNextLedger)
+{
+    cache.update({{KEY1, OBJECT1}}, SEQ);
+    cache.setFull();
+
+    EXPECT_THROW(cache.updateAndGetSuccessors({{KEY2, OBJECT1}}, SEQ), std::logic_error);
+    EXPECT_THROW(cache.updateAndGetSuccessors({{KEY2, OBJECT1}}, SEQ + 2), std::logic_error);
+    EXPECT_FALSE(cache.get(KEY2, SEQ).has_value());
+    EXPECT_EQ(cache.latestLedgerSequence(), SEQ);
+}
+
+TEST_F(LedgerCacheTest, SuccessorsOfBookBases)
+{
+    auto const dir = bookDirBlob();
+    cache.update({{BOOK_DIR2, dir}}, SEQ);
+    cache.setFull();
+
+    // a directory before the first one of the book
+    auto deltas = cache.updateAndGetSuccessors({{BOOK_DIR1, dir}}, SEQ + 1);
+    std::vector<LedgerCache::SuccessorDelta> expected{
+        {.key = firstKey, .successor = BOOK_DIR1},
+        {.key = BOOK_BASE, .successor = BOOK_DIR1},
+        {.key = BOOK_DIR1, .successor = BOOK_DIR2}
+    };
+    EXPECT_EQ(deltas, expected);
+
+    // the last directory is not the first one of the book
+    deltas = cache.updateAndGetSuccessors({{BOOK_DIR2, {}}}, SEQ + 2);
+    expected = {{.key = BOOK_DIR1, .successor = lastKey}};
+    EXPECT_EQ(deltas, expected);
+
+    // the first directory
+    deltas = cache.updateAndGetSuccessors({{BOOK_DIR1, {}}}, SEQ + 3);
+    expected = {{.key = firstKey, .successor = lastKey}, {.key = BOOK_BASE, .successor = lastKey}};
+    EXPECT_EQ(deltas, expected);
+}
+
+TEST_F(LedgerCacheTest, BookOffersRequireFullCacheAndLatestLedger)
+{
+    auto const dir = CreateBookDirLedgerObject({KEY1, KEY2}, ripple::to_string(BOOK_DIR1));
+    cache.update({{BOOK_DIR1, dir.getSerializer().peekData()}}, SEQ);
+    EXPECT_FALSE(cache.getBookOffers(BOOK_BASE, SEQ, 10).has_value());
+
+    cache.setFull();
+    EXPECT_EQ(cache.getBookOffers(BOOK_BASE, SEQ, 10), (std::vector{KEY1, KEY2}));
+
+    cache.update({{BOOK_DIR1, {}}}, SEQ + 1);
+    EXPECT_FALSE(cache.getBookOffers(BOOK_BASE, SEQ, 10).has_value());
+    EXPECT_EQ(cache.getBookOffers(BOOK_BASE, SEQ + 1, 10), std::vector<ripple::uint256>{});
+}
+
+TEST_F(LedgerCacheTest, DisabledCache)
+{
+    cache.setDisabled();
+    cache.update({{KEY1, BLOB1}}, SEQ);
+
+    EXPECT_TRUE(cache.isDisabled());
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_FALSE(cache.get(KEY1, SEQ).has_value());
+}
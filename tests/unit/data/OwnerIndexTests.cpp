@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/OwnerIndex.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/Blob.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace data;
+using namespace data::impl;
+
+namespace {
+
+constexpr std::uint32_t SEQ = 30;
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+
+ripple::uint256 const OBJECT1{"1000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const OBJECT2{"2000000000000000000000000000000000000000000000000000000000000000"};
+ripple::uint256 const OBJECT3{"3000000000000000000000000000000000000000000000000000000000000000"};
+
+Blob
+ownerDirPage(ripple::uint256 const& root, std::vector<ripple::uint256> entries, std::uint64_t next = 0)
+{
+    auto page = CreateOwnerDirLedgerObject(std::move(entries), ripple::to_string(root));
+    page.setAccountID(ripple::sfOwner, GetAccountIDWithString(ACCOUNT));
+    page.setFieldU64(ripple::sfIndexNext, next);
+    return page.getSerializer().peekData();
+}
+
+void
+update(OwnerIndex& index, std::vector<LedgerObject> const& objs, std::uint32_t seq = SEQ)
+{
+    index.update({objs.begin(), objs.end()}, seq);
+}
+
+}  // namespace
+
+struct OwnerIndexTests : testing::Test {
+    ripple::uint256 const root = ripple::keylet::ownerDir(GetAccountIDWithString(ACCOUNT)).key;
+    ripple::uint256 const secondPage = ripple::keylet::page(root, 5).key;
+    OwnerIndex index;
+};
+
+TEST_F(OwnerIndexTests, EmptyIndex)
+{
+    EXPECT_EQ(index.numPages(), 0u);
+    EXPECT_EQ(index.getPages(root, 0, 0, 10), std::vector<OwnerIndex::Page>{});
+}
+
+TEST_F(OwnerIndexTests, PagesAreReturnedInLinkOrder)
+{
+    update(
+        index,
+        {
+            {.key = secondPage, .blob = ownerDirPage(root, {OBJECT3})},
+            {.key = root, .blob = ownerDirPage(root, {OBJECT1, OBJECT2}, 5)},
+        }
+    );
+
+    OwnerIndex::Page const first{.number = 0, .entries = {OBJECT1, OBJECT2}};
+    OwnerIndex::Page const second{.number = 5, .entries = {OBJECT3}};
+
+    EXPECT_EQ(index.numPages(), 2u);
+    EXPECT_EQ(index.getPages(root, 0, SEQ, 10), (std::vector{first, second}));
+    EXPECT_EQ(index.getPages(root, 0, SEQ, 2), (std::vector{first}));
+    EXPECT_EQ(index.getPages(root, 5, SEQ, 10), (std::vector{second}));
+    EXPECT_EQ(index.getPages(root, 7, SEQ, 10), std::vector<OwnerIndex::Page>{});
+}
+
+TEST_F(OwnerIndexTests, OnlyLatestLedgerIsServed)
+{
+    update(index, {{.key = root, .blob = ownerDirPage(root, {OBJECT1})}});
+    update(index, {}, SEQ + 1);
+
+    EXPECT_FALSE(index.getPages(root, 0, SEQ, 10).has_value());
+    EXPECT_TRUE(index.getPages(root, 0, SEQ + 1, 10).has_value());
+}
+
+TEST_F(OwnerIndexTests, ModifiedAndDeletedPages)
+{
+    update(index, {{.key = root, .blob = ownerDirPage(root, {OBJECT1})}});
+    update(index, {{.key = root, .blob = ownerDirPage(root, {OBJECT1, OBJECT2})}}, SEQ + 1);
+    OwnerIndex::Page const modified{.number = 0, .entries = {OBJECT1, OBJECT2}};
+    EXPECT_EQ(index.getPages(root, 0, SEQ + 1, 10), (std::vector{modified}));
+
+    update(index, {{.key = root, .blob = {}}}, SEQ + 2);
+    EXPECT_EQ(index.getPages(root, 0, SEQ + 2, 10), std::vector<OwnerIndex::Page>{});
+    EXPECT_EQ(index.numPages(), 0u);
+}
+
+TEST_F(OwnerIndexTests, OtherObjectsAreIgnored)
+{
+    auto const bookDir = CreateOwnerDirLedgerObject({OBJECT1}, ripple::to_string(root));
+    update(
+        index,
+        {
+            {.key = root, .blob = bookDir.getSerializer().peekData()},
+            {.key = OBJECT1, .blob = {'a', 'b', 'c'}},
+            {.key = OBJECT2, .blob = {}},
+        }
+    );
+
+    EXPECT_EQ(index.numPages(), 0u);
+}
+
+TEST_F(OwnerIndexTests, MissingLinkedPageIsNotServed)
+{
+    update(index, {{.key = root, .blob = ownerDirPage(root, {OBJECT1}, 5)}});
+
+    EXPECT_TRUE(index.getPages(root, 0, SEQ, 1).has_value());
+    EXPECT_FALSE(index.getPages(root, 0, SEQ, 10).has_value());
+}
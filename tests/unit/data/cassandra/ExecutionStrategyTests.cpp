@@ -20,8 +20,10 @@
 #include "data/BackendInterface.hpp"
 #include "data/cassandra/FakesAndMocks.hpp"
 #include "data/cassandra/Types.hpp"
+#include "data/cassandra/impl/Batch.hpp"
 #include "data/cassandra/impl/ExecutionStrategy.hpp"
 #include "util/AsioContextTestFixture.hpp"
+#include "util/MockPrometheus.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/spawn.hpp>
@@ -37,6 +39,7 @@
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -44,7 +47,7 @@ using namespace data::cassandra;
 using namespace data::cassandra::impl;
 using namespace testing;
 
-class BackendCassandraExecutionStrategyTest : public SyncAsioContextTest {
+class BackendCassandraExecutionStrategyTest : public util::prometheus::WithPrometheus, public SyncAsioContextTest {
 protected:
     class MockBackendCounters {
     public:
@@ -405,6 +408,69 @@ TEST_F(BackendCassandraExecutionStrategyTest, WriteMultipleAndCallSyncSucceeds)
     thread.join();
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, SyncLedgerDoesNotWaitForLaterLedgers)
+{
+    auto strat = makeStrategy();
+    std::function<void(FakeResultOrError)> laterLedgerCallback;
+
+    ON_CALL(handle, asyncExecute(A<std::vector<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&laterLedgerCallback](auto const& statements, auto&& cb) {
+            // the batch of the earlier ledger finishes right away, the other one stays in flight
+            if (statements.size() == 1u) {
+                cb({});
+            } else {
+                laterLedgerCallback = std::forward<decltype(cb)>(cb);
+            }
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(
+        handle,
+        asyncExecute(A<std::vector<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>())
+    )
+        .Times(2);
+    EXPECT_CALL(*counters, registerWriteStarted()).Times(2);
+    EXPECT_CALL(*counters, registerWriteFinished(testing::_)).Times(2);
+
+    strat.writeForLedger(1u, std::vector<FakeStatement>(1));
+    strat.writeForLedger(2u, std::vector<FakeStatement>(2));
+
+    strat.syncLedger(1u);  // returns while the write of ledger 2 is still in flight
+    ASSERT_TRUE(laterLedgerCallback);
+
+    laterLedgerCallback({});
+    strat.syncLedger(2u);
+    strat.sync();
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, CoalescedWritesOfDifferentStatementsAreNotBatchedTogether)
+{
+    Settings settings;
+    settings.writeCoalescingWindow = std::chrono::seconds{10};  // only the sync below hands over the batches
+    auto strat = makeStrategy(settings);
+    FakePreparedStatement const insertHeader;
+    FakePreparedStatement const insertDiff;
+
+    // both statements are bound to the same ledger sequence first, i.e. the same partition key
+    EXPECT_CALL(
+        handle, asyncExecute(A<UnloggedBatch<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>())
+    )
+        .Times(2)
+        .WillRepeatedly([](auto const& batch, auto&& cb) {
+            EXPECT_EQ(batch.statements.size(), 2u);
+            cb({});
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(*counters, registerWriteStarted()).Times(2);
+    EXPECT_CALL(*counters, registerWriteFinished(testing::_)).Times(2);
+
+    strat.writeForLedger(1u, insertHeader, std::uint32_t{1}, std::string{"header"});
+    strat.writeForLedger(1u, insertDiff, std::uint32_t{1}, std::string{"key1"});
+    strat.writeForLedger(1u, insertHeader, std::uint32_t{1}, std::string{"header"});
+    strat.writeForLedger(1u, insertDiff, std::uint32_t{1}, std::string{"key2"});
+
+    strat.sync();
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, StatsCallsCountersReport)
 {
     auto strat = makeStrategy();
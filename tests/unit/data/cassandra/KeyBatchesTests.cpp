@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/KeyBatches.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <string_view>
+#include <vector>
+
+using namespace data::cassandra::impl;
+
+namespace {
+
+std::int64_t
+tokenOf(std::string_view key)
+{
+    return murmur3Token({reinterpret_cast<std::uint8_t const*>(key.data()), key.size()});
+}
+
+std::vector<ripple::uint256>
+makeKeys(std::size_t count)
+{
+    std::vector<ripple::uint256> keys;
+    for (std::size_t i = 0; i < count; ++i)
+        keys.emplace_back(i * 7919);
+
+    return keys;
+}
+
+}  // namespace
+
+TEST(BackendCassandraKeyBatchesTest, Murmur3TokenMatchesPartitioner)
+{
+    EXPECT_EQ(tokenOf(""), 0);
+
+    // the token of the int partition key 1
+    EXPECT_EQ(tokenOf(std::string_view{"\x00\x00\x00\x01", 4}), -4069959284402364209);
+
+    // the first half of the reference x64_128 hash of the string
+    EXPECT_EQ(
+        tokenOf("The quick brown fox jumps over the lazy dog"),
+        static_cast<std::int64_t>(0xe34b'bc7b'bc07'1b6cULL)
+    );
+}
+
+TEST(BackendCassandraKeyBatchesTest, EmptyKeys)
+{
+    EXPECT_TRUE(makeKeyBatches({}, 10).empty());
+}
+
+TEST(BackendCassandraKeyBatchesTest, BatchesAreOrderedByToken)
+{
+    auto const keys = makeKeys(95);
+    auto const batches = makeKeyBatches(keys, 10);
+    ASSERT_EQ(batches.size(), 10);
+
+    std::vector<std::int64_t> tokens;
+    for (auto const& batch : batches) {
+        EXPECT_LE(batch.size(), 10);
+        for (auto const& key : batch)
+            tokens.push_back(murmur3Token({key.data(), key.size()}));
+    }
+
+    EXPECT_EQ(tokens.size(), keys.size());
+    EXPECT_TRUE(std::ranges::is_sorted(tokens));
+}
+
+TEST(BackendCassandraKeyBatchesTest, EveryKeyIsReadOnce)
+{
+    auto keys = makeKeys(50);
+    auto const unique = std::set<ripple::uint256>(keys.begin(), keys.end());
+    keys.insert(keys.end(), keys.begin(), keys.begin() + 20);
+
+    std::set<ripple::uint256> batched;
+    std::size_t count = 0;
+    for (auto const& batch : makeKeyBatches(keys, 8)) {
+        count += batch.size();
+        batched.insert(batch.begin(), batch.end());
+    }
+
+    EXPECT_EQ(count, unique.size());
+    EXPECT_EQ(batched, unique);
+}
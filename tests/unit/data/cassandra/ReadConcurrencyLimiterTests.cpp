@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/ReadConcurrencyLimiter.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/prometheus/Gauge.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+using namespace data::cassandra::impl;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::uint32_t MAX_LIMIT = 1000;
+constexpr std::uint32_t MIN_LIMIT = 10;
+
+}  // namespace
+
+struct BackendCassandraReadConcurrencyLimiterTest : util::prometheus::WithPrometheus {
+    ReadConcurrencyLimiter limiter{MAX_LIMIT, MIN_LIMIT};
+
+    void
+    addSamples(std::size_t count, std::chrono::steady_clock::duration latency, std::uint32_t outstanding)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            limiter.addSample(latency, outstanding);
+    }
+
+    void
+    addSamplesAtLimit(std::size_t count, std::chrono::steady_clock::duration latency)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            limiter.addSample(latency, limiter.limit());
+    }
+};
+
+TEST_F(BackendCassandraReadConcurrencyLimiterTest, StartsAtMaxLimit)
+{
+    EXPECT_EQ(limiter.limit(), MAX_LIMIT);
+    EXPECT_FALSE(limiter.isExhausted(MAX_LIMIT - 1));
+    EXPECT_TRUE(limiter.isExhausted(MAX_LIMIT));
+}
+
+TEST_F(BackendCassandraReadConcurrencyLimiterTest, StaysAtMaxLimitWhileLatencyIsStable)
+{
+    addSamplesAtLimit(1000, 1ms);
+    EXPECT_EQ(limiter.limit(), MAX_LIMIT);
+}
+
+TEST_F(BackendCassandraReadConcurrencyLimiterTest, ShrinksWhenLatencyRises)
+{
+    addSamplesAtLimit(1000, 1ms);
+    addSamplesAtLimit(10, 20ms);
+
+    EXPECT_LT(limiter.limit(), MAX_LIMIT);
+    EXPECT_GE(limiter.limit(), MIN_LIMIT);
+    EXPECT_TRUE(limiter.isExhausted(limiter.limit()));
+}
+
+TEST_F(BackendCassandraReadConcurrencyLimiterTest, NeverGoesBelowMinLimit)
+{
+    addSamplesAtLimit(1000, 1ms);
+    for (auto latency = 2ms; latency < 10s; latency *= 2)
+        addSamplesAtLimit(10, latency);
+
+    EXPECT_EQ(limiter.limit(), MIN_LIMIT);
+}
+
+TEST_F(BackendCassandraReadConcurrencyLimiterTest, GrowsBackWhenLatencyRecovers)
+{
+    addSamplesAtLimit(1000, 1ms);
+    addSamplesAtLimit(10, 20ms);
+    auto const shrunk = limiter.limit();
+    ASSERT_LT(shrunk, MAX_LIMIT);
+
+    addSamplesAtLimit(1000, 1ms);
+    EXPECT_EQ(limiter.limit(), MAX_LIMIT);
+}
+
+TEST_F(BackendCassandraReadConcurrencyLimiterTest, DoesNotGrowWhileLimitIsNotUsed)
+{
+    addSamplesAtLimit(1000, 1ms);
+    addSamplesAtLimit(10, 20ms);
+    auto const shrunk = limiter.limit();
+    ASSERT_LT(shrunk, MAX_LIMIT);
+
+    addSamples(1000, 1ms, 1);
+    EXPECT_LE(limiter.limit(), shrunk);
+}
+
+TEST_F(BackendCassandraReadConcurrencyLimiterTest, MinLimitIsCappedByMaxLimit)
+{
+    ReadConcurrencyLimiter smallLimiter{5, MIN_LIMIT};
+    EXPECT_EQ(smallLimiter.limit(), 5);
+
+    smallLimiter.addSample(1ms, 5);
+    smallLimiter.addSample(1s, 5);
+    EXPECT_EQ(smallLimiter.limit(), 5);
+}
+
+struct BackendCassandraReadConcurrencyLimiterMetricsTest : util::prometheus::WithMockPrometheus {};
+
+TEST_F(BackendCassandraReadConcurrencyLimiterMetricsTest, ReportsLimitAndQueueingDelay)
+{
+    using util::prometheus::GaugeInt;
+    auto& limitMock = makeMock<GaugeInt>("backend_read_concurrency_limit", "");
+    auto& delayMock = makeMock<GaugeInt>("backend_read_queueing_delay_microseconds", "");
+
+    EXPECT_CALL(limitMock, set(MAX_LIMIT)).Times(2);
+    ReadConcurrencyLimiter limiter{MAX_LIMIT, MIN_LIMIT};
+
+    EXPECT_CALL(delayMock, set(0));
+    limiter.addSample(1ms, MAX_LIMIT);
+
+    // the short average moves toward the new sample faster than the baseline does
+    EXPECT_CALL(delayMock, set(testing::Gt(0)));
+    EXPECT_CALL(limitMock, set(testing::Lt(MAX_LIMIT)));
+    limiter.addSample(100ms, MAX_LIMIT);
+}
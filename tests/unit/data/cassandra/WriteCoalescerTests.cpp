@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/WriteCoalescer.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Histogram.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace data::cassandra::impl;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::size_t MAX_BATCH_SIZE = 3;
+
+// stand-ins for two prepared statements; only their addresses matter
+int const statement1 = 1;
+int const statement2 = 2;
+
+CoalescingKey
+key(std::string partition, void const* statement = &statement1)
+{
+    return {.statement = statement, .partition = std::move(partition)};
+}
+
+}  // namespace
+
+struct BackendCassandraWriteCoalescerTest : util::prometheus::WithPrometheus {
+    boost::asio::io_context ioc;
+    std::vector<std::vector<int>> batches;
+    WriteCoalescer<int> coalescer{ioc, MAX_BATCH_SIZE, 1ms, [this](std::vector<int>&& batch) {
+                                      batches.push_back(std::move(batch));
+                                  }};
+};
+
+TEST_F(BackendCassandraWriteCoalescerTest, FullBatchIsExecutedRightAway)
+{
+    coalescer.add(key("a"), 1);
+    coalescer.add(key("b"), 2);
+    coalescer.add(key("a"), 3);
+    EXPECT_TRUE(batches.empty());
+
+    coalescer.add(key("a"), 4);
+    EXPECT_EQ(batches, (std::vector<std::vector<int>>{{1, 3, 4}}));
+}
+
+TEST_F(BackendCassandraWriteCoalescerTest, PartialBatchesAreExecutedAfterWindow)
+{
+    coalescer.add(key("a"), 1);
+    coalescer.add(key("b"), 2);
+    coalescer.add(key("a"), 3);
+
+    while (batches.size() < 2)
+        ioc.run_one();
+
+    std::ranges::sort(batches);
+    EXPECT_EQ(batches, (std::vector<std::vector<int>>{{1, 3}, {2}}));
+}
+
+TEST_F(BackendCassandraWriteCoalescerTest, FlushExecutesPendingBatches)
+{
+    coalescer.flush();
+    EXPECT_TRUE(batches.empty());
+
+    coalescer.add(key("a"), 1);
+    coalescer.add(key("a"), 2);
+    coalescer.flush();
+    EXPECT_EQ(batches, (std::vector<std::vector<int>>{{1, 2}}));
+
+    // the timer that was scheduled for the flushed writes finds nothing left to do
+    ioc.run_for(10ms);
+    EXPECT_EQ(batches.size(), 1);
+}
+
+TEST_F(BackendCassandraWriteCoalescerTest, WritesAfterFlushAreStillExecutedAfterWindow)
+{
+    coalescer.add(key("a"), 1);
+    coalescer.flush();
+    coalescer.add(key("a"), 2);
+
+    while (batches.size() < 2)
+        ioc.run_one();
+
+    EXPECT_EQ(batches, (std::vector<std::vector<int>>{{1}, {2}}));
+}
+
+TEST_F(BackendCassandraWriteCoalescerTest, DifferentStatementsToSamePartitionAreNotBatchedTogether)
+{
+    coalescer.add(key("a", &statement1), 1);
+    coalescer.add(key("a", &statement2), 2);
+    coalescer.add(key("a", &statement1), 3);
+    coalescer.add(key("a", &statement2), 4);
+    coalescer.flush();
+
+    std::ranges::sort(batches);
+    EXPECT_EQ(batches, (std::vector<std::vector<int>>{{1, 3}, {2, 4}}));
+}
+
+TEST(BackendCassandraPartitionKeyTest, PartitionKeyOfFirstBoundValue)
+{
+    EXPECT_EQ(partitionKeyOf(std::string{"key"}, 1), "key");
+    EXPECT_EQ(partitionKeyOf(ripple::uint256{1}), partitionKeyOf(ripple::uint256{1}, std::string{"other"}));
+    EXPECT_NE(partitionKeyOf(ripple::uint256{1}), partitionKeyOf(ripple::uint256{2}));
+    EXPECT_EQ(partitionKeyOf(std::uint32_t{7}, ripple::uint256{1}), partitionKeyOf(std::uint32_t{7}));
+    EXPECT_NE(partitionKeyOf(std::uint32_t{7}), partitionKeyOf(std::uint32_t{8}));
+    EXPECT_EQ(partitionKeyOf(std::make_tuple(1u, 2u)), std::nullopt);
+    EXPECT_EQ(partitionKeyOf(), std::nullopt);
+}
+
+struct BackendCassandraWriteCoalescerMetricsTest : util::prometheus::WithMockPrometheus {
+    boost::asio::io_context ioc;
+};
+
+TEST_F(BackendCassandraWriteCoalescerMetricsTest, ReportsFillRatioAndReason)
+{
+    using util::prometheus::CounterInt;
+    using util::prometheus::HistogramDouble;
+    auto& fillRatio = makeMock<HistogramDouble>("backend_write_batch_fill_ratio", "");
+    auto& full = makeMock<CounterInt>("backend_write_batches_total_number", "{reason=\"full\"}");
+    auto& sync = makeMock<CounterInt>("backend_write_batches_total_number", "{reason=\"sync\"}");
+
+    WriteCoalescer<int> coalescer{ioc, 4, 1s, [](std::vector<int>&&) {}};
+
+    EXPECT_CALL(full, add(1));
+    EXPECT_CALL(fillRatio, observe(1.));
+    for (auto i = 0; i < 4; ++i)
+        coalescer.add(key("a"), int{i});
+
+    EXPECT_CALL(sync, add(1));
+    EXPECT_CALL(fillRatio, observe(0.25));
+    coalescer.add(key("b"), 5);
+    coalescer.flush();
+}
@@ -23,6 +23,8 @@
 #include <boost/json/parse.hpp>
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
 namespace json = boost::json;
 using namespace etl;
 using namespace testing;
@@ -70,6 +72,39 @@ TEST_F(CacheLoaderSettingsTest, PageFetchSizeCorrectlyPropagatedThroughConfig)
     EXPECT_EQ(settings.cachePageFetchSize, 42);
 }
 
+TEST_F(CacheLoaderSettingsTest, NumLedgersCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = util::Config{json::parse(R"({"cache": {"num_ledgers": 42}})")};
+    auto const settings = make_CacheLoaderSettings(cfg);
+
+    EXPECT_EQ(settings.numCachedLedgers, 42);
+}
+
+TEST_F(CacheLoaderSettingsTest, ZeroNumLedgersIsRejected)
+{
+    auto const cfg = util::Config{json::parse(R"({"cache": {"num_ledgers": 0}})")};
+    EXPECT_THROW(make_CacheLoaderSettings(cfg), std::runtime_error);
+}
+
+TEST_F(CacheLoaderSettingsTest, CompressionCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = util::Config{json::parse(R"({"cache": {"compression": "ZStd"}})")};
+    auto const settings = make_CacheLoaderSettings(cfg);
+
+    EXPECT_EQ(settings.compression, CacheLoaderSettings::Compression::ZSTD);
+    EXPECT_TRUE(settings.isCompressed());
+    EXPECT_FALSE(CacheLoaderSettings{}.isCompressed());
+}
+
+TEST_F(CacheLoaderSettingsTest, OwnerIndexCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = util::Config{json::parse(R"({"cache": {"owner_index": true}})")};
+    auto const settings = make_CacheLoaderSettings(cfg);
+
+    EXPECT_TRUE(settings.ownerIndex);
+    EXPECT_FALSE(CacheLoaderSettings{}.ownerIndex);
+}
+
 TEST_F(CacheLoaderSettingsTest, SyncLoadStyleCorrectlyPropagatedThroughConfig)
 {
     auto const cfg = util::Config{json::parse(R"({"cache": {"load": "sYNC"}})")};
@@ -88,6 +123,19 @@ TEST_F(CacheLoaderSettingsTest, AsyncLoadStyleCorrectlyPropagatedThroughConfig)
     EXPECT_TRUE(settings.isAsync());
 }
 
+TEST_F(CacheLoaderSettingsTest, SnapshotLoadStyleCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = util::Config{json::parse(
+        R"({"cache": {"load": "Snapshot", "snapshot_file": "/var/lib/clio/cache.bin", "snapshot_max_lag": 50}})"
+    )};
+    auto const settings = make_CacheLoaderSettings(cfg);
+
+    EXPECT_EQ(settings.loadStyle, CacheLoaderSettings::LoadStyle::SNAPSHOT);
+    EXPECT_TRUE(settings.isSnapshot());
+    EXPECT_EQ(settings.snapshotFile, "/var/lib/clio/cache.bin");
+    EXPECT_EQ(settings.snapshotMaxLag, 50);
+}
+
 TEST_F(CacheLoaderSettingsTest, NoLoadStyleCorrectlyPropagatedThroughConfig)
 {
     {
@@ -198,6 +198,7 @@ TEST_F(CacheLoaderTest, SyncCacheLoaderWaitsTillFullyLoaded)
     EXPECT_CALL(cache, updateImp).Times(loops);
     EXPECT_CALL(cache, isFull).WillOnce(Return(false)).WillRepeatedly(Return(true));
     EXPECT_CALL(cache, setFull).Times(1);
+    EXPECT_CALL(cache, setNumLedgers(etl::CacheLoaderSettings{}.numCachedLedgers));
 
     loader.load(SEQ);
 }
@@ -20,12 +20,14 @@
 #include "etl/impl/ForwardingSource.hpp"
 #include "rpc/Errors.hpp"
 #include "util/AsioContextTestFixture.hpp"
+#include "util/MockPrometheus.hpp"
 #include "util/TestWsServer.hpp"
 
 #include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
+#include <fmt/core.h>
 #include <gtest/gtest.h>
 
 #include <algorithm>
@@ -34,10 +36,11 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 using namespace etl::impl;
 
-struct ForwardingSourceTests : SyncAsioContextTest {
+struct ForwardingSourceTests : util::prometheus::WithPrometheus, SyncAsioContextTest {
     TestWsServer server_{ctx, "0.0.0.0"};
     ForwardingSource forwardingSource{
         "127.0.0.1",
@@ -191,3 +194,117 @@ TEST_F(ForwardingSourceOperationsTests, Success)
         EXPECT_EQ(*result, expectedReply) << *result;
     });
 }
+
+TEST_F(ForwardingSourceOperationsTests, ConnectionIsReused)
+{
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        auto connection = serverConnection(yield);
+
+        for (auto i = 0; i < 2; ++i) {
+            auto receivedMessage = connection.receive(yield);
+            [&]() { ASSERT_TRUE(receivedMessage); }();
+            EXPECT_EQ(boost::json::parse(*receivedMessage), boost::json::parse(message_)) << *receivedMessage;
+
+            auto sendError = connection.send(boost::json::serialize(reply_), yield);
+            [&]() { ASSERT_FALSE(sendError) << *sendError; }();
+        }
+    });
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        // the server accepts only one connection, so the second request must reuse it
+        for (auto i = 0; i < 2; ++i) {
+            auto result =
+                forwardingSource.forwardToRippled(boost::json::parse(message_).as_object(), "some_ip", {}, yield);
+            [&]() { ASSERT_TRUE(result); }();
+            EXPECT_EQ(result->at("reply"), reply_.at("reply"));
+        }
+    });
+}
+
+TEST_F(ForwardingSourceOperationsTests, ClosedConnectionIsReplaced)
+{
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        for (auto i = 0; i < 2; ++i) {
+            auto connection = serverConnection(yield);
+
+            auto receivedMessage = connection.receive(yield);
+            [&]() { ASSERT_TRUE(receivedMessage); }();
+
+            auto sendError = connection.send(boost::json::serialize(reply_), yield);
+            [&]() { ASSERT_FALSE(sendError) << *sendError; }();
+
+            connection.close(yield);
+        }
+    });
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        for (auto i = 0; i < 2; ++i) {
+            auto result = forwardingSource.forwardToRippled(boost::json::parse(message_).as_object(), {}, {}, yield);
+            [&]() { ASSERT_TRUE(result); }();
+            EXPECT_EQ(result->at("reply"), reply_.at("reply"));
+        }
+    });
+}
+
+TEST_F(ForwardingSourceOperationsTests, ConnectionsArePooledPerClient)
+{
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        for (auto i = 0; i < 2; ++i) {
+            auto connection = serverConnection(yield);
+
+            auto receivedMessage = connection.receive(yield);
+            [&]() { ASSERT_TRUE(receivedMessage); }();
+
+            auto sendError = connection.send(boost::json::serialize(reply_), yield);
+            [&]() { ASSERT_FALSE(sendError) << *sendError; }();
+        }
+    });
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        for (auto const* clientIp : {"some_ip", "other_ip"}) {
+            auto result =
+                forwardingSource.forwardToRippled(boost::json::parse(message_).as_object(), clientIp, {}, yield);
+            [&]() { ASSERT_TRUE(result); }();
+        }
+    });
+}
+
+TEST_F(ForwardingSourceOperationsTests, FullPoolEvictsLeastRecentlyUsedConnection)
+{
+    auto const numClients = ForwardingSource::MAX_IDLE_CONNECTIONS + 1;
+
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        std::vector<TestWsConnection> connections;
+        for (auto i = 0u; i < numClients; ++i) {
+            connections.push_back(serverConnection(yield));
+
+            auto receivedMessage = connections.back().receive(yield);
+            [&]() { ASSERT_TRUE(receivedMessage); }();
+
+            auto sendError = connections.back().send(boost::json::serialize(reply_), yield);
+            [&]() { ASSERT_FALSE(sendError) << *sendError; }();
+        }
+
+        // the last client's connection must have been kept although the pool was full
+        auto receivedMessage = connections.back().receive(yield);
+        [&]() { ASSERT_TRUE(receivedMessage); }();
+
+        auto sendError = connections.back().send(boost::json::serialize(reply_), yield);
+        [&]() { ASSERT_FALSE(sendError) << *sendError; }();
+    });
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        for (auto i = 0u; i < numClients; ++i) {
+            auto result = forwardingSource.forwardToRippled(
+                boost::json::parse(message_).as_object(), fmt::format("client_{}", i), {}, yield
+            );
+            [&]() { ASSERT_TRUE(result); }();
+        }
+
+        auto result = forwardingSource.forwardToRippled(
+            boost::json::parse(message_).as_object(), fmt::format("client_{}", numClients - 1), {}, yield
+        );
+        [&]() { ASSERT_TRUE(result); }();
+        EXPECT_EQ(result->at("reply"), reply_.at("reply"));
+    });
+}
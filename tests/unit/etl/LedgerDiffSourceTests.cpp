@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "etl/impl/LedgerDiffSource.hpp"
+#include "feed/impl/LedgerDiffFeed.hpp"
+#include "util/LoggerFixtures.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TestObject.hpp"
+#include "util/TestWsServer.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/json/serialize.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace etl::impl;
+
+namespace {
+
+constexpr auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto INDEX1 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr auto INDEX2 = "E6DBAFC99223B42257915A63DFC6B0C032D4070F9A574B255AD97466726FC321";
+constexpr auto SEQ = 30;
+
+}  // namespace
+
+struct LedgerDiffSourceTests : util::prometheus::WithPrometheus, NoLoggerFixture {
+    ~LedgerDiffSourceTests() override
+    {
+        diffSource_.stop();
+        if (ioThread_.joinable())
+            ioThread_.join();
+    }
+
+    // the writing Clio node: accepts the subscription and publishes the given messages
+    void
+    publishFromWriter(std::vector<std::string> messages)
+    {
+        boost::asio::spawn(ioContext_, [this, messages = std::move(messages)](boost::asio::yield_context yield) {
+            // The first one is an SSL attempt
+            auto failedConnection = wsServer_.acceptConnection(yield);
+            [&]() { ASSERT_FALSE(failedConnection); }();
+
+            auto connection = wsServer_.acceptConnection(yield);
+            [&]() { ASSERT_TRUE(connection) << connection.error().message(); }();
+
+            auto const subscribe = connection->receive(yield);
+            [&]() {
+                ASSERT_TRUE(subscribe);
+                EXPECT_EQ(subscribe.value(), R"({"command":"subscribe","streams":["ledger_diff"]})");
+            }();
+
+            for (auto const& message : messages) {
+                auto const error = connection->send(message, yield);
+                [&]() { ASSERT_FALSE(error) << *error; }();
+            }
+
+            // wait for the reader to go away
+            connection->receive(yield);
+        });
+
+        diffSource_.run();
+        ioThread_ = std::thread{[this] { ioContext_.run(); }};
+    }
+
+    // what the publisher does on its strand, without blocking it
+    void
+    waitWhileExpected(std::uint32_t sequence)
+    {
+        while (not diffSource_.isConnected())
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+
+        while (diffSource_.isExpected(sequence))
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    ripple::LedgerHeader const header_ = CreateLedgerHeader(LEDGERHASH, SEQ);
+    std::vector<data::LedgerObject> const objects_{
+        {.key = ripple::uint256{INDEX1}, .blob = {0x01, 0x02, 0x03}},
+        {.key = ripple::uint256{INDEX2}, .blob = {}},
+    };
+    std::vector<data::TransactionAndMetadata> const transactions_{
+        {data::Blob{0xAB, 0xCD}, data::Blob{0xEF}, SEQ, header_.closeTime.time_since_epoch().count()},
+    };
+
+    boost::asio::io_context ioContext_;
+    TestWsServer wsServer_{ioContext_, "0.0.0.0"};
+    LedgerDiffSource diffSource_{
+        ioContext_,
+        "127.0.0.1",
+        wsServer_.port(),
+        std::nullopt,
+        std::chrono::seconds{1},
+        std::chrono::milliseconds{5},
+        std::chrono::seconds{5}
+    };
+    std::thread ioThread_;
+};
+
+TEST_F(LedgerDiffSourceTests, ParseRoundTrip)
+{
+    auto const message = boost::json::serialize(
+        feed::impl::LedgerDiffFeed::makeLedgerDiffPubMessage(header_, objects_, transactions_)
+    );
+
+    auto const diff = LedgerDiffSource::parse(message);
+    ASSERT_TRUE(diff.has_value());
+    EXPECT_EQ(diff->header.seq, header_.seq);
+    EXPECT_EQ(diff->header.hash, header_.hash);
+    EXPECT_EQ(diff->objects, objects_);
+    EXPECT_EQ(diff->transactions, transactions_);
+}
+
+TEST_F(LedgerDiffSourceTests, ParseIgnoresOtherMessages)
+{
+    EXPECT_FALSE(LedgerDiffSource::parse(R"({"result":{},"status":"success","type":"response"})").has_value());
+    EXPECT_FALSE(LedgerDiffSource::parse(R"({"type":"ledgerClosed","ledger_index":30})").has_value());
+}
+
+TEST_F(LedgerDiffSourceTests, ParseMalformedDiffThrows)
+{
+    EXPECT_ANY_THROW(LedgerDiffSource::parse(R"({"type":"ledgerDiff","ledger_data":"XYZ"})"));
+    EXPECT_ANY_THROW(LedgerDiffSource::parse("something"));
+}
+
+TEST_F(LedgerDiffSourceTests, NotConnectedDiffIsNotExpected)
+{
+    EXPECT_FALSE(diffSource_.isExpected(SEQ));
+    EXPECT_FALSE(diffSource_.take(SEQ).has_value());
+}
+
+TEST_F(LedgerDiffSourceTests, ReceiveDiffOverLoopback)
+{
+    publishFromWriter({
+        R"({"result":{},"status":"success","type":"response"})",
+        boost::json::serialize(feed::impl::LedgerDiffFeed::makeLedgerDiffPubMessage(header_, objects_, transactions_)),
+    });
+
+    waitWhileExpected(SEQ);
+    auto const diff = diffSource_.take(SEQ);
+    ASSERT_TRUE(diff.has_value());
+    EXPECT_EQ(diff->header.hash, header_.hash);
+    EXPECT_EQ(diff->objects, objects_);
+    EXPECT_EQ(diff->transactions, transactions_);
+
+    // a diff is handed out only once
+    EXPECT_FALSE(diffSource_.take(SEQ).has_value());
+}
+
+TEST_F(LedgerDiffSourceTests, MissedDiffIsNotAwaitedOnceNewerOneArrived)
+{
+    auto const nextHeader = CreateLedgerHeader(LEDGERHASH, SEQ + 1);
+    publishFromWriter({
+        boost::json::serialize(feed::impl::LedgerDiffFeed::makeLedgerDiffPubMessage(nextHeader, objects_, {})),
+    });
+
+    // the diff of SEQ was lost; the caller falls back to the database as soon as the next one arrives
+    waitWhileExpected(SEQ);
+    EXPECT_FALSE(diffSource_.take(SEQ).has_value());
+
+    auto const diff = diffSource_.take(SEQ + 1);
+    ASSERT_TRUE(diff.has_value());
+    EXPECT_EQ(diff->header.seq, SEQ + 1);
+}
@@ -19,11 +19,13 @@
 
 #include "data/DBHelpers.hpp"
 #include "data/Types.hpp"
+#include "etl/LedgerDiffSourceInterface.hpp"
 #include "etl/SystemState.hpp"
 #include "etl/impl/LedgerPublisher.hpp"
 #include "util/AsioContextTestFixture.hpp"
 #include "util/MockBackendTestFixture.hpp"
 #include "util/MockCache.hpp"
+#include "util/MockLedgerDiffSource.hpp"
 #include "util/MockPrometheus.hpp"
 #include "util/MockSubscriptionManager.hpp"
 #include "util/TestObject.hpp"
@@ -38,6 +40,8 @@
 #include <xrpl/protocol/LedgerHeader.h>
 
 #include <chrono>
+#include <memory>
+#include <optional>
 #include <vector>
 
 using namespace testing;
@@ -48,6 +52,7 @@ using namespace std::chrono;
 static auto constexpr ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
 static auto constexpr ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
 static auto constexpr LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+static auto constexpr INDEX1 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
 static auto constexpr SEQ = 30;
 static auto constexpr AGE = 800;
 
@@ -293,3 +298,150 @@ TEST_F(ETLLedgerPublisherTest, PublishMultipleTxInOrder)
     // last publish time should be set
     EXPECT_TRUE(publisher.lastPublishAgeSeconds() <= 1);
 }
+
+TEST_F(ETLLedgerPublisherTest, PublishKnownTransactionsWithoutFetching)
+{
+    SystemState dummyState;
+    dummyState.isWriting = true;
+
+    auto const dummyLedgerHeader = CreateLedgerHeader(LEDGERHASH, SEQ, 0);  // age is 0
+    impl::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState);
+    backend->setRange(SEQ - 1, SEQ);
+
+    TransactionAndMetadata t1;
+    t1.transaction = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 100, 3, SEQ).getSerializer().peekData();
+    t1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30, 1).getSerializer().peekData();
+    t1.ledgerSequence = SEQ;
+    TransactionAndMetadata t2;
+    t2.transaction = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 100, 3, SEQ).getSerializer().peekData();
+    t2.metadata = CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30, 2).getSerializer().peekData();
+    t2.ledgerSequence = SEQ;
+
+    auto const objects = std::vector<LedgerObject>{{.key = ripple::uint256{LEDGERHASH}, .blob = {}}};
+    publisher.publish(dummyLedgerHeader, objects, std::vector<TransactionAndMetadata>{t1, t2});
+
+    EXPECT_CALL(*backend, doFetchLedgerObject(ripple::keylet::fees().key, SEQ, _))
+        .WillOnce(Return(CreateLegacyFeeSettingBlob(1, 2, 3, 4, 0)));
+    EXPECT_CALL(*backend, fetchAllTransactionsInLedger).Times(0);
+
+    // the written diff is handed over to read-only nodes
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubLedgerDiff(_, objects, std::vector<TransactionAndMetadata>{t1, t2}));
+
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubLedger(_, _, fmt::format("{}-{}", SEQ - 1, SEQ), 2));
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubBookChanges);
+    // transactions are published in the given order
+    Sequence const s;
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction(t1, _)).InSequence(s);
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction(t2, _)).InSequence(s);
+
+    ctx.run();
+    EXPECT_TRUE(publisher.lastPublishAgeSeconds() <= 1);
+}
+
+TEST_F(ETLLedgerPublisherTest, PublishPushedDiffWithoutFetching)
+{
+    SystemState dummyState;
+    dummyState.isWriting = false;
+
+    auto const dummyLedgerHeader = CreateLedgerHeader(LEDGERHASH, SEQ, 0);  // age is 0
+    auto const diffSource = std::make_shared<StrictMock<MockLedgerDiffSource>>();
+    impl::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState, diffSource);
+
+    TransactionAndMetadata t1;
+    t1.transaction = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 100, 3, SEQ).getSerializer().peekData();
+    t1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30).getSerializer().peekData();
+    t1.ledgerSequence = SEQ;
+
+    auto const objects = std::vector<LedgerObject>{{.key = ripple::uint256{LEDGERHASH}, .blob = {1, 2, 3}}};
+    EXPECT_CALL(*diffSource, isExpected(SEQ)).WillOnce(Return(false));
+    EXPECT_CALL(*diffSource, take(SEQ))
+        .WillOnce(Return(LedgerDiff{.header = dummyLedgerHeader, .objects = objects, .transactions = {t1}}));
+
+    publisher.publish(dummyLedgerHeader);
+
+    EXPECT_CALL(mockCache, isDisabled).WillOnce(Return(false));
+    EXPECT_CALL(*backend, fetchLedgerDiff).Times(0);
+    EXPECT_CALL(mockCache, updateImp(objects, SEQ, _));
+
+    EXPECT_CALL(*backend, doFetchLedgerObject(ripple::keylet::fees().key, SEQ, _))
+        .WillOnce(Return(CreateLegacyFeeSettingBlob(1, 2, 3, 4, 0)));
+    EXPECT_CALL(*backend, fetchAllTransactionsInLedger).Times(0);
+
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubLedger(_, _, fmt::format("{}-{}", SEQ, SEQ), 1));
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubBookChanges);
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction(t1, _));
+
+    ctx.run();
+    EXPECT_EQ(backend->fetchLedgerRange().value().maxSequence, SEQ);
+}
+
+TEST_F(ETLLedgerPublisherTest, PublishFetchesDiffWhenNotPushed)
+{
+    SystemState dummyState;
+    dummyState.isWriting = false;
+
+    auto const dummyLedgerHeader = CreateLedgerHeader(LEDGERHASH, SEQ, AGE);
+    auto const diffSource = std::make_shared<StrictMock<MockLedgerDiffSource>>();
+    impl::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState, diffSource);
+
+    EXPECT_CALL(*diffSource, isExpected(SEQ)).WillOnce(Return(false));
+    EXPECT_CALL(*diffSource, take(SEQ)).WillOnce(Return(std::nullopt));
+    publisher.publish(dummyLedgerHeader);
+
+    EXPECT_CALL(mockCache, isDisabled).WillOnce(Return(false));
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ, _)).WillOnce(Return(std::vector<LedgerObject>{}));
+    EXPECT_CALL(mockCache, updateImp);
+
+    ctx.run();
+}
+
+TEST_F(ETLLedgerPublisherTest, PublishFetchesDiffWhenPushedDiffDoesNotMatch)
+{
+    SystemState dummyState;
+    dummyState.isWriting = false;
+
+    auto const dummyLedgerHeader = CreateLedgerHeader(LEDGERHASH, SEQ, AGE);
+    auto const diffSource = std::make_shared<StrictMock<MockLedgerDiffSource>>();
+    impl::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState, diffSource);
+
+    auto const otherLedgerHeader = CreateLedgerHeader(INDEX1, SEQ, AGE);
+    EXPECT_CALL(*diffSource, isExpected(SEQ)).WillOnce(Return(false));
+    EXPECT_CALL(*diffSource, take(SEQ)).WillOnce(Return(LedgerDiff{.header = otherLedgerHeader}));
+    publisher.publish(dummyLedgerHeader);
+
+    EXPECT_CALL(mockCache, isDisabled).WillOnce(Return(false));
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ, _)).WillOnce(Return(std::vector<LedgerObject>{}));
+    EXPECT_CALL(mockCache, updateImp);
+
+    ctx.run();
+}
+
+TEST_F(ETLLedgerPublisherTest, PublishWaitsForExpectedDiffInOrder)
+{
+    SystemState dummyState;
+    dummyState.isWriting = false;
+
+    auto const dummyLedgerHeader = CreateLedgerHeader(LEDGERHASH, SEQ, AGE);
+    auto const nextLedgerHeader = CreateLedgerHeader(LEDGERHASH, SEQ + 1, AGE);
+    auto const diffSource = std::make_shared<StrictMock<MockLedgerDiffSource>>();
+    impl::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState, diffSource);
+
+    // the diff of SEQ arrives after two checks; SEQ + 1 must not be published before it
+    Sequence const s;
+    EXPECT_CALL(*diffSource, isExpected(SEQ)).Times(2).InSequence(s).WillRepeatedly(Return(true));
+    EXPECT_CALL(*diffSource, isExpected(SEQ)).InSequence(s).WillOnce(Return(false));
+    EXPECT_CALL(*diffSource, take(SEQ)).InSequence(s).WillOnce(Return(LedgerDiff{.header = dummyLedgerHeader}));
+    EXPECT_CALL(*diffSource, isExpected(SEQ + 1)).InSequence(s).WillOnce(Return(false));
+    EXPECT_CALL(*diffSource, take(SEQ + 1)).InSequence(s).WillOnce(Return(std::nullopt));
+
+    publisher.publish(dummyLedgerHeader);
+    publisher.publish(nextLedgerHeader);
+
+    EXPECT_CALL(mockCache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(mockCache, updateImp(std::vector<LedgerObject>{}, SEQ, _));
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ + 1, _)).WillOnce(Return(std::vector<LedgerObject>{}));
+    EXPECT_CALL(mockCache, updateImp(std::vector<LedgerObject>{}, SEQ + 1, _));
+
+    ctx.run();
+    EXPECT_EQ(publisher.getLastPublishedSequence(), SEQ + 1);
+}
@@ -44,6 +44,7 @@
 #include <chrono>
 #include <cstdint>
 #include <expected>
+#include <future>
 #include <memory>
 #include <optional>
 #include <stdexcept>
@@ -59,7 +60,9 @@ struct LoadBalancerConstructorTests : util::prometheus::WithPrometheus, MockBack
     StrictMockNetworkValidatedLedgersPtr networkManager_;
     StrictMockSourceFactory sourceFactory_{2};
     boost::asio::io_context ioContext_;
-    boost::json::value configJson_{{"etl_sources", {"source1", "source2"}}};
+    boost::json::value configJson_{
+        {"etl_sources", {{{"ip", "source1"}, {"grpc_port", "1"}}, {{"ip", "source2"}, {"grpc_port", "2"}}}}
+    };
 
     std::unique_ptr<LoadBalancer>
     makeLoadBalancer()
@@ -326,7 +329,11 @@ struct LoadBalancer3SourcesTests : LoadBalancerConstructorTests {
     LoadBalancer3SourcesTests()
     {
         sourceFactory_.setSourcesNumber(3);
-        configJson_.as_object()["etl_sources"] = {"source1", "source2", "source3"};
+        configJson_.as_object()["etl_sources"] = {
+            {{"ip", "source1"}, {"grpc_port", "1"}},
+            {{"ip", "source2"}, {"grpc_port", "2"}},
+            {{"ip", "source3"}, {"grpc_port", "3"}}
+        };
         EXPECT_CALL(sourceFactory_, makeSource).Times(3);
         EXPECT_CALL(sourceFactory_.sourceAt(0), forwardToRippled).WillOnce(Return(boost::json::object{}));
         EXPECT_CALL(sourceFactory_.sourceAt(0), run);
@@ -509,6 +516,104 @@ TEST_F(LoadBalancerFetchLegerTests, fetch_bothSourcesFail)
                     .has_value());
 }
 
+struct LoadBalancerHedgedFetchLedgerTests : LoadBalancerConstructorTests {
+    LoadBalancerHedgedFetchLedgerTests()
+    {
+        response_.second.set_validated(true);
+    }
+
+    void
+    makeHedgingLoadBalancer(double hedgeDelaySeconds)
+    {
+        configJson_.as_object()["fetch_hedge_delay"] = hedgeDelaySeconds;
+
+        EXPECT_CALL(sourceFactory_, makeSource).Times(2);
+        EXPECT_CALL(sourceFactory_.sourceAt(0), forwardToRippled).WillOnce(Return(boost::json::object{}));
+        EXPECT_CALL(sourceFactory_.sourceAt(0), run);
+        EXPECT_CALL(sourceFactory_.sourceAt(1), forwardToRippled).WillOnce(Return(boost::json::object{}));
+        EXPECT_CALL(sourceFactory_.sourceAt(1), run);
+        loadBalancer_ = makeLoadBalancer();
+
+        util::Random::setSeed(0);
+    }
+
+    static constexpr double SHORT_HEDGE_DELAY = 0.01;
+    static constexpr double LONG_HEDGE_DELAY = 60.;
+
+    std::unique_ptr<LoadBalancer> loadBalancer_;
+    uint32_t const sequence_ = 123;
+    bool const getObjects_ = true;
+    bool const getObjectNeighbors_ = false;
+    std::pair<grpc::Status, org::xrpl::rpc::v1::GetLedgerResponse> response_ =
+        std::make_pair(grpc::Status::OK, org::xrpl::rpc::v1::GetLedgerResponse{});
+};
+
+TEST_F(LoadBalancerHedgedFetchLedgerTests, fastFetchIsNotHedged)
+{
+    makeHedgingLoadBalancer(LONG_HEDGE_DELAY);
+
+    EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(true));
+    EXPECT_CALL(sourceFactory_.sourceAt(0), fetchLedger(sequence_, getObjects_, getObjectNeighbors_))
+        .WillOnce(Return(response_));
+
+    EXPECT_TRUE(loadBalancer_->fetchLedger(sequence_, getObjects_, getObjectNeighbors_).has_value());
+}
+
+TEST_F(LoadBalancerHedgedFetchLedgerTests, slowFetchIsHedgedToAnotherSource)
+{
+    makeHedgingLoadBalancer(SHORT_HEDGE_DELAY);
+
+    auto hedgedResponse = response_;
+    hedgedResponse.second.set_ledger_header("hedged");
+
+    // the first source only answers once the hedged fetch has won
+    std::promise<void> releaseFirstSource;
+    EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(true));
+    EXPECT_CALL(sourceFactory_.sourceAt(0), fetchLedger(sequence_, getObjects_, getObjectNeighbors_))
+        .WillOnce(testing::InvokeWithoutArgs([this, released = releaseFirstSource.get_future().share()]() {
+            released.wait();
+            return response_;
+        }));
+
+    EXPECT_CALL(sourceFactory_.sourceAt(1), hasLedger(sequence_)).WillOnce(Return(true));
+    EXPECT_CALL(sourceFactory_.sourceAt(1), fetchLedger(sequence_, getObjects_, getObjectNeighbors_))
+        .WillOnce(Return(hedgedResponse));
+
+    auto const response = loadBalancer_->fetchLedger(sequence_, getObjects_, getObjectNeighbors_);
+    releaseFirstSource.set_value();
+
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ(response->ledger_header(), "hedged");
+}
+
+TEST_F(LoadBalancerHedgedFetchLedgerTests, hedgedFetchFailureWaitsForFirstSource)
+{
+    makeHedgingLoadBalancer(SHORT_HEDGE_DELAY);
+
+    auto badResponse = response_;
+    badResponse.second.set_validated(false);
+
+    // the first source only answers once the hedged fetch has failed
+    std::promise<void> releaseFirstSource;
+    EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(true));
+    EXPECT_CALL(sourceFactory_.sourceAt(0), fetchLedger(sequence_, getObjects_, getObjectNeighbors_))
+        .WillOnce(testing::InvokeWithoutArgs([this, released = releaseFirstSource.get_future().share()]() {
+            released.wait();
+            return response_;
+        }));
+
+    EXPECT_CALL(sourceFactory_.sourceAt(1), hasLedger(sequence_)).WillOnce(Return(true));
+    EXPECT_CALL(sourceFactory_.sourceAt(1), fetchLedger(sequence_, getObjects_, getObjectNeighbors_))
+        .WillOnce(testing::InvokeWithoutArgs([&badResponse, &releaseFirstSource]() {
+            releaseFirstSource.set_value();
+            return badResponse;
+        }));
+
+    auto const response = loadBalancer_->fetchLedger(sequence_, getObjects_, getObjectNeighbors_);
+    ASSERT_TRUE(response.has_value());
+    EXPECT_TRUE(response->validated());
+}
+
 struct LoadBalancerForwardToRippledTests : LoadBalancerConstructorTests, SyncAsioContextTest {
     LoadBalancerForwardToRippledTests()
     {
@@ -539,6 +644,31 @@ TEST_F(LoadBalancerForwardToRippledTests, forward)
     });
 }
 
+TEST_F(LoadBalancerForwardToRippledTests, forwardToLeastLoadedSource)
+{
+    EXPECT_CALL(sourceFactory_, makeSource).Times(2);
+    auto loadBalancer = makeLoadBalancer();
+
+    // while source 0 is busy with the first request, the second one goes to source 1
+    EXPECT_CALL(
+        sourceFactory_.sourceAt(0),
+        forwardToRippled(request_, clientIP_, LoadBalancer::USER_FORWARDING_X_USER_VALUE, testing::_)
+    )
+        .WillOnce([&](auto&&, auto&&, auto&&, boost::asio::yield_context yield) {
+            EXPECT_EQ(loadBalancer->forwardToRippled(request_, clientIP_, false, yield), response_);
+            return response_;
+        });
+    EXPECT_CALL(
+        sourceFactory_.sourceAt(1),
+        forwardToRippled(request_, clientIP_, LoadBalancer::USER_FORWARDING_X_USER_VALUE, testing::_)
+    )
+        .WillOnce(Return(response_));
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        EXPECT_EQ(loadBalancer->forwardToRippled(request_, clientIP_, false, yield), response_);
+    });
+}
+
 TEST_F(LoadBalancerForwardToRippledTests, forwardWithXUserHeader)
 {
     EXPECT_CALL(sourceFactory_, makeSource).Times(2);
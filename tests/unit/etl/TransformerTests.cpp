@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include "etl/SystemState.hpp"
+#include "etl/impl/LedgerLoader.hpp"
 #include "etl/impl/Transformer.hpp"
 #include "util/FakeFetchResponse.hpp"
 #include "util/MockAmendmentBlockHandler.hpp"
@@ -30,8 +31,11 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <xrpl/protocol/LedgerHeader.h>
 
 #include <chrono>
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <optional>
 #include <thread>
@@ -85,7 +89,7 @@ TEST_F(ETLTransformerTest, StopsOnWriteConflict)
     state_.writeConflict = true;
 
     EXPECT_CALL(dataPipe_, popNext).Times(0);
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(_, _, _)).Times(0);
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
@@ -117,7 +121,7 @@ TEST_F(ETLTransformerTest, StopsOnEmptyFetchResponse)
     EXPECT_CALL(*backend, writeNFTs).Times(AtLeast(1));
     EXPECT_CALL(*backend, writeNFTTransactions).Times(AtLeast(1));
     EXPECT_CALL(*backend, doFinishWrites).Times(AtLeast(1));
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(AtLeast(1));
+    EXPECT_CALL(ledgerPublisher_, publish(_, _, _)).Times(AtLeast(1));
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
@@ -150,11 +154,74 @@ TEST_F(ETLTransformerTest, DoesNotPublishIfCanNotBuildNextLedger)
     EXPECT_CALL(*backend, doFinishWrites).Times(AtLeast(1));
 
     // should not call publish
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(_, _, _)).Times(0);
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
     );
 }
 
+TEST_F(ETLTransformerTest, CommitsAndPublishesLedgersInOrder)
+{
+    static constexpr auto NUM_LEDGERS = 3u;
+    static constexpr auto FIRST_SEQ = 1000u;
+    backend->cache().setFull();  // to avoid throwing exception in updateCache
+
+    // the sequence is the first field of a serialized ledger header
+    auto const makeHeader = [](uint32_t ledgerSeq) {
+        auto header = hexStringToBinaryString(RAW_HEADER);
+        for (auto i = 0u; i < 4u; ++i)
+            header[i] = static_cast<char>((ledgerSeq >> (8u * (3u - i))) & 0xFFu);
+        return header;
+    };
+    auto const hasSeq = [](uint32_t ledgerSeq) { return Field(&ripple::LedgerHeader::seq, ledgerSeq); };
+
+    ON_CALL(dataPipe_, popNext).WillByDefault([&makeHeader](uint32_t seq) -> std::optional<FakeFetchResponse> {
+        if (seq >= NUM_LEDGERS)
+            return std::nullopt;
+        return FakeFetchResponse{makeHeader(FIRST_SEQ + seq), seq};
+    });
+    ON_CALL(*backend, doFinishWrites).WillByDefault(Return(true));
+
+    // the commit of the first ledger only finishes once the second ledger is being prepared
+    std::promise<void> secondLedgerPrepared;
+    auto secondLedgerPreparedFuture = secondLedgerPrepared.get_future();
+    auto secondLedgerPreparedInTime = std::future_status::timeout;
+
+    EXPECT_CALL(dataPipe_, popNext).Times(NUM_LEDGERS + 1);
+    EXPECT_CALL(ledgerLoader_, insertTransactions).Times(NUM_LEDGERS - 1);
+    EXPECT_CALL(ledgerLoader_, insertTransactions(hasSeq(FIRST_SEQ + 1), _)).WillOnce([&](auto const&, auto&) {
+        secondLedgerPrepared.set_value();
+        return FormattedTransactionsData{};
+    });
+    EXPECT_CALL(*backend, writeAccountTransactions).Times(NUM_LEDGERS);
+    EXPECT_CALL(*backend, writeNFTs).Times(NUM_LEDGERS);
+    EXPECT_CALL(*backend, writeNFTTransactions).Times(NUM_LEDGERS);
+    EXPECT_CALL(*backend, startWrites).Times(NUM_LEDGERS);
+    {
+        // the ledger header must be written right before the writes are committed
+        InSequence const seq;
+        for (auto i = 0u; i < NUM_LEDGERS; ++i) {
+            EXPECT_CALL(*backend, writeLedger(hasSeq(FIRST_SEQ + i), _));
+            if (i == 0u) {
+                EXPECT_CALL(*backend, doFinishWrites).WillOnce([&] {
+                    secondLedgerPreparedInTime = secondLedgerPreparedFuture.wait_for(std::chrono::seconds{5});
+                    return true;
+                });
+            } else {
+                EXPECT_CALL(*backend, doFinishWrites);
+            }
+            EXPECT_CALL(ledgerPublisher_, publish(hasSeq(FIRST_SEQ + i), _, _));
+        }
+    }
+
+    transformer_ = std::make_unique<TransformerType>(
+        dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
+    );
+    transformer_->waitTillFinished();
+
+    EXPECT_EQ(secondLedgerPreparedInTime, std::future_status::ready);
+    EXPECT_FALSE(state_.writeConflict);
+}
+
 // TODO: implement tests for amendment block. requires more refactoring
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "feed/FeedTestUtil.hpp"
+#include "feed/impl/LedgerDiffFeed.hpp"
+#include "rpc/RPCHelpers.hpp"
+#include "util/TestObject.hpp"
+
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/strHex.h>
+
+#include <vector>
+
+using namespace feed::impl;
+
+constexpr static auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr static auto INDEX1 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr static auto INDEX2 = "E6DBAFC99223B42257915A63DFC6B0C032D4070F9A574B255AD97466726FC321";
+
+using FeedLedgerDiffTest = FeedBaseTest<LedgerDiffFeed>;
+
+TEST_F(FeedLedgerDiffTest, Pub)
+{
+    testFeedPtr->sub(sessionPtr);
+    EXPECT_EQ(testFeedPtr->count(), 1);
+
+    auto const ledgerHeader = CreateLedgerHeader(LEDGERHASH, 32);
+    auto const objects = std::vector<data::LedgerObject>{
+        {.key = ripple::uint256{INDEX1}, .blob = {0x01, 0x02, 0x03}},
+        {.key = ripple::uint256{INDEX2}, .blob = {}},
+    };
+    auto const transactions = std::vector<data::TransactionAndMetadata>{
+        {data::Blob{0xAB, 0xCD}, data::Blob{0xEF}, 32, 0},
+    };
+
+    auto const ledgerDiffPublish = fmt::format(
+        R"({{
+            "type":"ledgerDiff",
+            "ledger_index":32,
+            "ledger_hash":"{}",
+            "ledger_data":"{}",
+            "objects":
+            [
+                {{"index":"{}","data":"010203"}},
+                {{"index":"{}","data":""}}
+            ],
+            "transactions":
+            [
+                {{"tx_blob":"ABCD","meta":"EF"}}
+            ]
+        }})",
+        LEDGERHASH,
+        ripple::strHex(rpc::ledgerHeaderToBlob(ledgerHeader, true)),
+        INDEX1,
+        INDEX2
+    );
+
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(ledgerDiffPublish))).Times(1);
+    testFeedPtr->pub(ledgerHeader, objects, transactions);
+
+    testFeedPtr->unsub(sessionPtr);
+    EXPECT_EQ(testFeedPtr->count(), 0);
+    testFeedPtr->pub(ledgerHeader, objects, transactions);
+}
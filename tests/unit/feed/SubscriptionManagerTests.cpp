@@ -119,7 +119,8 @@ TEST_F(SubscriptionManagerTest, ReportCurrentSubscriber)
             "account":2,
             "accounts_proposed":2,
             "books":2,
-            "book_changes":2
+            "book_changes":2,
+            "ledger_diff":0
         })";
     std::shared_ptr<web::ConnectionBase> const session1 = std::make_shared<MockSession>();
     std::shared_ptr<web::ConnectionBase> session2 = std::make_shared<MockSession>();
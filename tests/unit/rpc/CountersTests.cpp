@@ -31,6 +31,8 @@
 
 #include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace rpc;
 
@@ -108,6 +110,31 @@ TEST_F(RPCCountersTest, CheckThatCountersAddUp)
     EXPECT_EQ(report.at("work_queue"), queue.report());  // Counters report includes queue report
 }
 
+TEST_F(RPCCountersTest, ConcurrentCallsToNewMethodsAddUp)
+{
+    static auto constexpr numThreads = 4;
+    static auto constexpr numMethods = 50u;
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < numThreads; ++i) {
+        threads.emplace_back([this] {
+            for (auto method = 0u; method < numMethods; ++method)
+                counters.rpcComplete(std::to_string(method), std::chrono::microseconds{1u});
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    auto const report = counters.report();
+    auto const& rpc = report.at(JS(rpc)).as_object();
+
+    EXPECT_EQ(rpc.size(), numMethods);
+    for (auto method = 0u; method < numMethods; ++method) {
+        auto const& info = rpc.at(std::to_string(method)).as_object();
+        EXPECT_EQ(boost::json::value_to<std::string>(info.at(JS(finished))), std::to_string(numThreads));
+    }
+}
+
 struct RPCCountersMockPrometheusTests : WithMockPrometheus {
     WorkQueue queue{4u, 1024u};  // todo: mock instead
     Counters counters{queue};
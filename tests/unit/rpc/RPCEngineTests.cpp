@@ -325,7 +325,7 @@ generateCacheTestValuesForParametersTest()
             "server": {"max_queue_size": 2},
             "workers": 4,
             "rpc": 
-            {"cache_timeout": 10}
+            {"cache_size": 10, "cache_commands": ["server_info"]}
          })JSON",
          .method = "server_info",
          .isAdmin = false,
@@ -339,20 +339,20 @@ generateCacheTestValuesForParametersTest()
          .method = "server_info",
          .isAdmin = false,
          .expectedCacheEnabled = false},
-        {.testName = "CacheDisabledWhenNoTimeout",
+        {.testName = "CacheDisabledWhenNoSize",
          .config = R"JSON({      
             "server": {"max_queue_size": 2},
             "workers": 4,
-            "rpc": {}
+            "rpc": {"cache_commands": ["server_info"]}
          })JSON",
          .method = "server_info",
          .isAdmin = false,
          .expectedCacheEnabled = false},
-        {.testName = "CacheDisabledWhenTimeoutIsZero",
+        {.testName = "CacheDisabledWhenSizeIsZero",
          .config = R"JSON({      
             "server": {"max_queue_size": 2},
             "workers": 4,
-            "rpc": {"cache_timeout": 0}
+            "rpc": {"cache_size": 0}
          })JSON",
          .method = "server_info",
          .isAdmin = false,
@@ -361,16 +361,52 @@ generateCacheTestValuesForParametersTest()
          .config = R"JSON({      
             "server": {"max_queue_size": 2},
             "workers": 4,
-            "rpc": { "cache_timeout": 10}
+            "rpc": {"cache_size": 10}
          })JSON",
          .method = "server_info",
          .isAdmin = true,
          .expectedCacheEnabled = false},
+        {.testName = "ServerInfoNotCachedByDefault",
+         .config = R"JSON({
+            "server": {"max_queue_size": 2},
+            "workers": 4,
+            "rpc": {"cache_size": 10}
+         })JSON",
+         .method = "server_info",
+         .isAdmin = false,
+         .expectedCacheEnabled = false},
+        {.testName = "ServerInfoCachedWithTimeout",
+         .config = R"JSON({
+            "server": {"max_queue_size": 2},
+            "workers": 4,
+            "rpc": {"cache_timeout": 10}
+         })JSON",
+         .method = "server_info",
+         .isAdmin = false,
+         .expectedCacheEnabled = true},
+        {.testName = "TimeoutCacheNotWorkForAdmin",
+         .config = R"JSON({
+            "server": {"max_queue_size": 2},
+            "workers": 4,
+            "rpc": {"cache_timeout": 10}
+         })JSON",
+         .method = "server_info",
+         .isAdmin = true,
+         .expectedCacheEnabled = false},
+        {.testName = "TimeoutCacheOnlyForServerInfo",
+         .config = R"JSON({
+            "server": {"max_queue_size": 2},
+            "workers": 4,
+            "rpc": {"cache_timeout": 10}
+         })JSON",
+         .method = "ledger",
+         .isAdmin = false,
+         .expectedCacheEnabled = false},
         {.testName = "CacheDisabledWhenCmdNotMatch",
          .config = R"JSON({      
             "server": {"max_queue_size": 2},
             "workers": 4,
-            "rpc": {"cache_timeout": 10}
+            "rpc": {"cache_size": 10}
          })JSON",
          .method = "server_info2",
          .isAdmin = false,
@@ -435,7 +471,7 @@ TEST_F(RPCEngineTest, NotCacheIfErrorHappen)
     auto const cfgCache = Config{json::parse(R"JSON({      
                                                       "server": {"max_queue_size": 2},
                                                       "workers": 4,
-                                                      "rpc": {"cache_timeout": 10}
+                                                      "rpc": {"cache_size": 10, "cache_timeout": 10}
                                                 })JSON")};
 
     auto const notAdmin = false;
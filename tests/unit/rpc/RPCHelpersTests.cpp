@@ -229,6 +229,56 @@ TEST_F(RPCHelpersTest, TraverseOwnedNodesNoInputMarkerReturnOtherPageMarker)
     ctx.run();
 }
 
+// the owner directory and the owned objects are served from memory when the owner index is enabled
+TEST_F(RPCHelpersTest, TraverseOwnedNodesFromOwnerIndex)
+{
+    constexpr static auto seq = 9;
+    constexpr static auto nextPage = 99;
+    constexpr static auto limit = 15;
+
+    auto const account = GetAccountIDWithString(ACCOUNT);
+    auto const ownerDirKk = ripple::keylet::ownerDir(account).key;
+    auto const ownerDir2Kk = ripple::keylet::page(ripple::keylet::ownerDir(account), nextPage).key;
+
+    std::vector<ripple::uint256> const indexes(10, ripple::uint256{INDEX1});
+    ripple::STObject ownerDir = CreateOwnerDirLedgerObject(indexes, INDEX1);
+    ownerDir.setAccountID(ripple::sfOwner, account);
+    ownerDir.setFieldU64(ripple::sfIndexNext, nextPage);
+    ripple::STObject ownerDir2 = CreateOwnerDirLedgerObject(indexes, INDEX1);
+    ownerDir2.setAccountID(ripple::sfOwner, account);
+    ripple::STObject const channel = CreatePaymentChannelLedgerObject(ACCOUNT, ACCOUNT2, 100, 10, 32, TXNID, 28);
+
+    backend->cache().enableOwnerIndex();
+    backend->cache().update(
+        {{ownerDirKk, ownerDir.getSerializer().peekData()},
+         {ownerDir2Kk, ownerDir2.getSerializer().peekData()},
+         {ripple::uint256{INDEX1}, channel.getSerializer().peekData()}},
+        seq
+    );
+    backend->cache().setFull();
+
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObjects).Times(0);
+
+    boost::asio::spawn(ctx, [&, this](boost::asio::yield_context yield) {
+        auto count = 0;
+        auto ret = traverseOwnedNodes(*backend, account, seq, limit, {}, yield, [&](auto) { count++; });
+        auto cursor = std::get_if<AccountCursor>(&ret);
+        ASSERT_TRUE(cursor != nullptr);
+        EXPECT_EQ(count, limit);
+        EXPECT_EQ(cursor->toString(), fmt::format("{},{}", INDEX1, nextPage));
+
+        ret = traverseOwnedNodes(
+            *backend, account, seq, limit, fmt::format("{},{}", INDEX2, nextPage), yield, [](auto) {}
+        );
+        auto status = std::get_if<Status>(&ret);
+        ASSERT_TRUE(status != nullptr);
+        EXPECT_EQ(*status, ripple::rpcINVALID_PARAMS);
+        EXPECT_EQ(status->message, "Invalid marker.");
+    });
+    ctx.run();
+}
+
 // Send a valid marker
 TEST_F(RPCHelpersTest, TraverseOwnedNodesWithMarkerReturnSamePageMarker)
 {
@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/ResponseCache.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/prometheus/Counter.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace rpc;
+
+namespace {
+
+constexpr std::uint32_t API_VERSION = 2;
+constexpr std::uint32_t SEQ = 30;
+
+boost::json::object
+params(char const* json)
+{
+    return boost::json::parse(json).as_object();
+}
+
+}  // namespace
+
+struct ResponseCacheTests : util::prometheus::WithPrometheus {
+    ResponseCache cache{100, {"ledger", "server_info"}};
+    boost::json::object response{{"key", "value"}};
+};
+
+TEST_F(ResponseCacheTests, NotCachedCommandHasNoKey)
+{
+    EXPECT_FALSE(cache.makeKey("account_tx", {}, API_VERSION, SEQ).has_value());
+}
+
+TEST_F(ResponseCacheTests, InvalidLedgerIndexHasNoKey)
+{
+    EXPECT_FALSE(cache.makeKey("ledger", params(R"JSON({"ledger_index": "abc"})JSON"), API_VERSION, SEQ));
+    EXPECT_FALSE(cache.makeKey("ledger", params(R"JSON({"ledger_index": -1})JSON"), API_VERSION, SEQ));
+}
+
+TEST_F(ResponseCacheTests, EquivalentRequestsShareKey)
+{
+    auto const key =
+        cache.makeKey("ledger", params(R"JSON({"transactions": true, "expand": false})JSON"), API_VERSION, SEQ);
+    ASSERT_TRUE(key.has_value());
+
+    for (auto const* json : {
+             R"JSON({"expand": false, "transactions": true})JSON",
+             R"JSON({"expand": false, "transactions": true, "ledger_index": "validated", "id": 1})JSON",
+             R"JSON({"expand": false, "transactions": true, "ledger_index": 30, "command": "ledger"})JSON",
+             R"JSON({"expand": false, "transactions": true, "ledger_index": "30", "api_version": 2})JSON",
+         }) {
+        auto const other = cache.makeKey("ledger", params(json), API_VERSION, SEQ);
+        ASSERT_TRUE(other.has_value()) << json;
+        EXPECT_EQ(other->value, key->value) << json;
+    }
+}
+
+TEST_F(ResponseCacheTests, DifferentRequestsHaveDifferentKeys)
+{
+    auto const key = cache.makeKey("ledger", params(R"JSON({"transactions": true})JSON"), API_VERSION, SEQ);
+    ASSERT_TRUE(key.has_value());
+
+    auto const otherParams = cache.makeKey("ledger", params(R"JSON({"transactions": false})JSON"), API_VERSION, SEQ);
+    auto const otherVersion = cache.makeKey("ledger", params(R"JSON({"transactions": true})JSON"), 1, SEQ);
+    auto const otherLedger =
+        cache.makeKey("ledger", params(R"JSON({"transactions": true, "ledger_index": 29})JSON"), API_VERSION, SEQ);
+    auto const otherMethod =
+        cache.makeKey("server_info", params(R"JSON({"transactions": true})JSON"), API_VERSION, SEQ);
+
+    for (auto const& other : {otherParams, otherVersion, otherLedger, otherMethod}) {
+        ASSERT_TRUE(other.has_value());
+        EXPECT_NE(other->value, key->value);
+    }
+}
+
+TEST_F(ResponseCacheTests, PutAndGet)
+{
+    auto const key = cache.makeKey("ledger", {}, API_VERSION, SEQ);
+    ASSERT_TRUE(key.has_value());
+    EXPECT_FALSE(cache.get(*key, SEQ).has_value());
+
+    cache.put(*key, SEQ, response);
+    auto const result = cache.get(*key, SEQ);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, response);
+}
+
+TEST_F(ResponseCacheTests, NewLedgerInvalidatesEntries)
+{
+    auto const key = cache.makeKey("ledger", params(R"JSON({"ledger_index": 10})JSON"), API_VERSION, SEQ);
+    ASSERT_TRUE(key.has_value());
+
+    cache.put(*key, SEQ, response);
+    EXPECT_TRUE(cache.get(*key, SEQ).has_value());
+    EXPECT_FALSE(cache.get(*key, SEQ + 1).has_value());
+}
+
+TEST_F(ResponseCacheTests, ResponseForOldLedgerIsNotStored)
+{
+    auto const key = cache.makeKey("ledger", {}, API_VERSION, SEQ);
+    ASSERT_TRUE(key.has_value());
+
+    EXPECT_FALSE(cache.get(*key, SEQ + 1).has_value());
+    cache.put(*key, SEQ, response);
+    EXPECT_FALSE(cache.get(*key, SEQ + 1).has_value());
+}
+
+TEST_F(ResponseCacheTests, Invalidate)
+{
+    auto const key = cache.makeKey("ledger", {}, API_VERSION, SEQ);
+    ASSERT_TRUE(key.has_value());
+
+    cache.put(*key, SEQ, response);
+    cache.invalidate();
+    EXPECT_FALSE(cache.get(*key, SEQ).has_value());
+}
+
+TEST_F(ResponseCacheTests, SizeIsBounded)
+{
+    // one entry per shard
+    ResponseCache smallCache{1, {"ledger"}};
+
+    std::vector<ResponseCache::Key> keys;
+    for (auto i = 0; i < 100; ++i) {
+        auto const key = smallCache.makeKey("ledger", boost::json::object{{"limit", i}}, API_VERSION, SEQ);
+        ASSERT_TRUE(key.has_value());
+        keys.push_back(*key);
+
+        // a full shard evicts its oldest entry rather than refusing the new one
+        smallCache.put(*key, SEQ, response);
+        EXPECT_TRUE(smallCache.get(*key, SEQ).has_value());
+    }
+
+    auto const stored =
+        std::ranges::count_if(keys, [&](auto const& key) { return smallCache.get(key, SEQ).has_value(); });
+    EXPECT_GT(stored, 0);
+    EXPECT_LE(stored, 16);
+}
+
+struct ResponseCacheMockPrometheusTests : util::prometheus::WithMockPrometheus {};
+
+TEST_F(ResponseCacheMockPrometheusTests, CountsHitsAndMisses)
+{
+    using util::prometheus::CounterInt;
+    auto& hits = makeMock<CounterInt>("rpc_response_cache_total_number", "{method=\"ledger\",result=\"hit\"}");
+    auto& misses = makeMock<CounterInt>("rpc_response_cache_total_number", "{method=\"ledger\",result=\"miss\"}");
+
+    ResponseCache cache{100, {"ledger"}};
+    auto const key = cache.makeKey("ledger", {}, API_VERSION, SEQ);
+    ASSERT_TRUE(key.has_value());
+
+    EXPECT_CALL(misses, add(1));
+    EXPECT_FALSE(cache.get(*key, SEQ).has_value());
+
+    cache.put(*key, SEQ, boost::json::object{{"key", "value"}});
+
+    EXPECT_CALL(hits, add(1));
+    EXPECT_TRUE(cache.get(*key, SEQ).has_value());
+}
@@ -23,6 +23,7 @@
 #include "util/config/Config.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/json/parse.hpp>
 #include <gmock/gmock.h>
@@ -32,6 +33,8 @@
 #include <cstdint>
 #include <mutex>
 #include <semaphore>
+#include <string>
+#include <vector>
 
 using namespace util;
 using namespace rpc;
@@ -76,6 +79,58 @@ TEST_F(WorkQueueTest, WhitelistedExecutionCountAddsUp)
     EXPECT_EQ(report.at("queued"), TOTAL);
     EXPECT_EQ(report.at("current_queue_size"), 0);
     EXPECT_EQ(report.at("max_queue_size"), 2);
+
+    for (auto const* lane : WorkQueue::LANE_NAMES)
+        EXPECT_EQ(report.at("lanes").at(lane).at("current_queue_size"), 0);
+    EXPECT_EQ(report.at("lanes").at("admin").at("weight"), WorkQueue::LANE_WEIGHTS[0]);
+}
+
+TEST_F(WorkQueueTest, LanesAreServedByWeight)
+{
+    WorkQueue singleWorkerQueue{1};
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    auto unblocked = false;
+    std::binary_semaphore started{0};
+    std::vector<std::string> executed;
+
+    // occupy the only worker until all other jobs are queued
+    EXPECT_TRUE(singleWorkerQueue.postCoro(
+        [&](auto /* yield */) {
+            started.release();
+            std::unique_lock lk{mtx};
+            cv.wait(lk, [&] { return unblocked; });
+        },
+        false
+    ));
+    started.acquire();
+
+    auto const post = [&](WorkQueue::Lane lane, std::string name) {
+        EXPECT_TRUE(singleWorkerQueue.postCoro(
+            [&executed, name = std::move(name)](auto /* yield */) { executed.push_back(name); }, false, lane
+        ));
+    };
+    for (auto i = 0; i < 4; ++i)
+        post(WorkQueue::Lane::Expensive, "expensive");
+    for (auto i = 0; i < 4; ++i)
+        post(WorkQueue::Lane::Cheap, "cheap");
+    for (auto i = 0; i < 2; ++i)
+        post(WorkQueue::Lane::Admin, "admin");
+
+    EXPECT_EQ(singleWorkerQueue.report().at("lanes").at("expensive").at("current_queue_size"), 4);
+
+    {
+        std::unique_lock const lk{mtx};
+        unblocked = true;
+        cv.notify_all();
+    }
+    singleWorkerQueue.join();
+
+    std::vector<std::string> const expected{
+        "admin", "cheap", "admin", "expensive", "cheap", "expensive", "cheap", "cheap", "expensive", "expensive"
+    };
+    EXPECT_EQ(executed, expected);
 }
 
 TEST_F(WorkQueueTest, NonWhitelistedPreventSchedulingAtQueueLimitExceeded)
@@ -165,11 +220,16 @@ TEST_F(WorkQueueMockPrometheusTest, postCoroCouhters)
     auto& queuedMock = makeMock<CounterInt>("work_queue_queued_total_number", "");
     auto& durationMock = makeMock<CounterInt>("work_queue_cumulitive_tasks_duration_us", "");
     auto& curSizeMock = makeMock<GaugeInt>("work_queue_current_size", "");
+    auto& laneSizeMock = makeMock<GaugeInt>("work_queue_lane_current_size", "{lane=\"cheap\"}");
+    auto& laneWaitMock = makeMock<HistogramInt>("work_queue_wait_duration_us_histogram", "{lane=\"cheap\"}");
 
     std::binary_semaphore semaphore{0};
 
     EXPECT_CALL(curSizeMock, value()).Times(2).WillRepeatedly(::testing::Return(0));
     EXPECT_CALL(curSizeMock, add(1));
+    EXPECT_CALL(laneSizeMock, add(1));
+    EXPECT_CALL(laneSizeMock, add(-1));
+    EXPECT_CALL(laneWaitMock, observe(::testing::Gt(0)));
     EXPECT_CALL(queuedMock, add(1));
     EXPECT_CALL(durationMock, add(::testing::Gt(0))).WillOnce([&](auto) {
         EXPECT_CALL(curSizeMock, add(-1));
@@ -32,6 +32,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/AccountID.h>
 
 #include <cstdint>
@@ -93,6 +94,27 @@ generateTestValuesForParametersTest()
             "outOfOrderMarkerNotInt"
         },
         LedgerDataParamTestCaseBundle{"markerNotString", R"({"marker": 123})", "invalidParams", "markerNotString"},
+        LedgerDataParamTestCaseBundle{"rangesNotInt", R"({"ranges": "xxx"})", "invalidParams", "Invalid parameters."},
+        LedgerDataParamTestCaseBundle{"rangesZero", R"({"ranges": 0})", "invalidParams", "Invalid parameters."},
+        LedgerDataParamTestCaseBundle{"rangesTooMany", R"({"ranges": 257})", "invalidParams", "Invalid parameters."},
+        LedgerDataParamTestCaseBundle{
+            "rangesWithMarker",
+            R"({
+                "marker": "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652",
+                "ranges": 4
+            })",
+            "invalidParams",
+            "rangesWithMarker"
+        },
+        LedgerDataParamTestCaseBundle{
+            "rangesOutOfOrder",
+            R"({"ranges": 4, "out_of_order": true})",
+            "invalidParams",
+            "outOfOrderRangesNotSupported"
+        },
+        LedgerDataParamTestCaseBundle{
+            "endMarkerInvalid", R"({"end_marker": "xxx"})", "invalidParams", "end_markerMalformed"
+        },
         LedgerDataParamTestCaseBundle{
             "typeNotString", R"({"type": 123})", "invalidParams", "Invalid field 'type', not string."
         },
@@ -641,6 +663,10 @@ TEST_F(RPCLedgerDataHandlerTest, Binary)
         EXPECT_TRUE(output.result->as_object().at("ledger").as_object().contains("ledger_data"));
         EXPECT_TRUE(output.result->as_object().at("ledger").as_object().at("closed").as_bool());
         EXPECT_EQ(output.result->as_object().at("state").as_array().size(), 10);
+        EXPECT_EQ(
+            output.result->as_object().at("state").as_array()[0].as_object().at("data").as_string(),
+            ripple::strHex(bbs[0])
+        );
         EXPECT_EQ(output.result->as_object().at("ledger_hash").as_string(), LEDGERHASH);
         EXPECT_EQ(output.result->as_object().at("ledger_index").as_uint64(), RANGEMAX);
     });
@@ -729,6 +755,99 @@ TEST_F(RPCLedgerDataHandlerTest, JsonLimitMoreThanMax)
     });
 }
 
+TEST_F(RPCLedgerDataHandlerTest, Ranges)
+{
+    static auto constexpr INDEX3 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+
+    backend->setRange(RANGEMIN, RANGEMAX);
+
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1);
+    ON_CALL(*backend, fetchLedgerBySequence(RANGEMAX, _))
+        .WillByDefault(Return(CreateLedgerHeader(LEDGERHASH, RANGEMAX)));
+
+    auto const blob = CreateRippleStateLedgerObject("USD", ACCOUNT2, 10, ACCOUNT, 100, ACCOUNT2, 200, TXNID, 123)
+                          .getSerializer()
+                          .peekData();
+
+    // INDEX1 is deleted in the latest ledger so it can't bound a range even though it was modified before
+    EXPECT_CALL(*backend, fetchLedgerDiff).Times(2);
+    ON_CALL(*backend, fetchLedgerDiff(RANGEMAX, _))
+        .WillByDefault(Return(std::vector<LedgerObject>{
+            {.key = ripple::uint256{INDEX1}, .blob = {}}, {.key = ripple::uint256{INDEX2}, .blob = blob}
+        }));
+    ON_CALL(*backend, fetchLedgerDiff(RANGEMAX - 1, _))
+        .WillByDefault(Return(std::vector<LedgerObject>{
+            {.key = ripple::uint256{INDEX1}, .blob = blob}, {.key = ripple::uint256{INDEX3}, .blob = blob}
+        }));
+
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObjects).Times(0);
+
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{LedgerDataHandler{backend}};
+        auto const req = json::parse(R"({"ranges": 3})");
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_TRUE(output);
+        EXPECT_TRUE(output.result->as_object().contains("ledger"));
+        EXPECT_TRUE(output.result->as_object().at("state").as_array().empty());
+        EXPECT_FALSE(output.result->as_object().contains("marker"));
+        EXPECT_EQ(
+            output.result->as_object().at("ranges"),
+            json::parse(fmt::format(
+                R"([
+                    {{"end_marker": "{}"}},
+                    {{"marker": "{}", "end_marker": "{}"}},
+                    {{"marker": "{}"}}
+                ])",
+                INDEX3,
+                INDEX3,
+                INDEX2,
+                INDEX2
+            ))
+        );
+    });
+}
+
+TEST_F(RPCLedgerDataHandlerTest, EndMarker)
+{
+    backend->setRange(RANGEMIN, RANGEMAX);
+
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1);
+    ON_CALL(*backend, fetchLedgerBySequence(RANGEMAX, _))
+        .WillByDefault(Return(CreateLedgerHeader(LEDGERHASH, RANGEMAX)));
+
+    auto const blob = CreateRippleStateLedgerObject("USD", ACCOUNT2, 10, ACCOUNT, 100, ACCOUNT2, 200, TXNID, 123)
+                          .getSerializer()
+                          .peekData();
+
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(1);
+    ON_CALL(*backend, doFetchLedgerObject(ripple::uint256{INDEX1}, RANGEMAX, _)).WillByDefault(Return(blob));
+
+    // the page stops at the end marker although the limit is not reached
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(1);
+    ON_CALL(*backend, doFetchSuccessorKey(ripple::uint256{INDEX1}, RANGEMAX, _))
+        .WillByDefault(Return(ripple::uint256{INDEX2}));
+
+    EXPECT_CALL(*backend, doFetchLedgerObjects).WillOnce(Return(std::vector<Blob>{blob}));
+
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{LedgerDataHandler{backend}};
+        auto const req = json::parse(fmt::format(
+            R"({{
+                "limit": 10,
+                "marker": "{}",
+                "end_marker": "{}"
+            }})",
+            INDEX1,
+            INDEX2
+        ));
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_TRUE(output);
+        EXPECT_FALSE(output.result->as_object().contains("marker"));
+        EXPECT_EQ(output.result->as_object().at("state").as_array().size(), 1);
+    });
+}
+
 TEST(RPCLedgerDataHandlerSpecTest, DeprecatedFields)
 {
     boost::json::value const json{
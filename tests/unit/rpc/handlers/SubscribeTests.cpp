@@ -606,6 +606,40 @@ TEST_F(RPCSubscribeHandlerTest, StreamsWithoutLedger)
     });
 }
 
+TEST_F(RPCSubscribeHandlerTest, StreamsLedgerDiff)
+{
+    auto const input = json::parse(
+        R"({
+            "streams": ["ledger_diff"]
+        })"
+    );
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{SubscribeHandler{backend, mockSubscriptionManagerPtr}};
+        EXPECT_CALL(*mockSubscriptionManagerPtr, subLedgerDiff).Times(1);
+
+        auto const output = handler.process(input, Context{.yield = yield, .session = session_, .isAdmin = true});
+        ASSERT_TRUE(output);
+        EXPECT_TRUE(output.result->as_object().empty());
+    });
+}
+
+TEST_F(RPCSubscribeHandlerTest, StreamsLedgerDiffRequiresAdmin)
+{
+    auto const input = json::parse(
+        R"({
+            "streams": ["ledger_diff"]
+        })"
+    );
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{SubscribeHandler{backend, mockSubscriptionManagerPtr}};
+
+        auto const output = handler.process(input, Context{yield, session_});
+        ASSERT_FALSE(output);
+        auto const err = rpc::makeError(output.result.error());
+        EXPECT_EQ(err.at("error").as_string(), "noPermission");
+    });
+}
+
 TEST_F(RPCSubscribeHandlerTest, StreamsLedger)
 {
     static auto constexpr expectedOutput =
@@ -532,7 +532,15 @@ TEST_F(RPCUnsubscribeTest, Streams)
 {
     auto const input = json::parse(
         R"({
-            "streams": ["transactions_proposed","transactions","validations","manifests","book_changes","ledger"]
+            "streams": [
+                "transactions_proposed",
+                "transactions",
+                "validations",
+                "manifests",
+                "book_changes",
+                "ledger",
+                "ledger_diff"
+            ]
         })"
     );
 
@@ -541,6 +549,7 @@ TEST_F(RPCUnsubscribeTest, Streams)
     EXPECT_CALL(*mockSubscriptionManagerPtr, unsubValidation).Times(1);
     EXPECT_CALL(*mockSubscriptionManagerPtr, unsubManifest).Times(1);
     EXPECT_CALL(*mockSubscriptionManagerPtr, unsubBookChanges).Times(1);
+    EXPECT_CALL(*mockSubscriptionManagerPtr, unsubLedgerDiff).Times(1);
     EXPECT_CALL(*mockSubscriptionManagerPtr, unsubProposedTransactions).Times(1);
 
     runSpawn([&, this](auto yield) {
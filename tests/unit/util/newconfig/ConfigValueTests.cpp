@@ -145,6 +145,15 @@ TEST(ConfigValue, SetValuesOnNumberConstraint)
     EXPECT_FALSE(positiveNum.setValue(99, "key"));
 }
 
+TEST(ConfigValue, NumCachedLedgersConstraint)
+{
+    auto numLedgers = ConfigValue{ConfigType::Integer}.defaultValue(4).withConstraint(validateNumCachedLedgers);
+    auto const err = numLedgers.setValue(0, "cache.num_ledgers");
+    ASSERT_TRUE(err.has_value());
+    EXPECT_EQ(err->error, fmt::format("cache.num_ledgers Number must be between {} and {}", 1, 65535));
+    EXPECT_FALSE(numLedgers.setValue(1, "cache.num_ledgers"));
+}
+
 TEST(ConfigValue, PositiveDoubleConstraint)
 {
     auto const doubleCons{PositiveDouble{}};
@@ -178,6 +187,7 @@ INSTANTIATE_TEST_SUITE_P(
         ConstraintTestBundle{"ApiVersionConstraint", validateApiVersion},
         ConstraintTestBundle{"Uint16Constraint", validateUint16},
         ConstraintTestBundle{"Uint32Constraint", validateUint32},
+        ConstraintTestBundle{"NumCachedLedgersConstraint", validateNumCachedLedgers},
         ConstraintTestBundle{"PositiveDoubleConstraint", validatePositiveDouble}
     ),
     [](testing::TestParamInfo<ConstraintTestBundle> const& info) { return info.param.name; }
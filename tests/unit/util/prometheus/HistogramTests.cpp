@@ -25,6 +25,7 @@
 
 #include <cstdint>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -119,3 +120,29 @@ TEST_F(HistogramTests, observe)
         "t_count{label1=\"value1\",label2=\"value2\"} 3\n"
     );
 }
+
+TEST_F(HistogramTests, multithreadObserve)
+{
+    static auto constexpr numThreads = 4;
+    static auto constexpr numObservations = 1000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < numObservations; ++j)
+                histogram.observe(2);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(
+        serialize(),
+        "t_bucket{label1=\"value1\",label2=\"value2\",le=\"1\"} 0\n"
+        "t_bucket{label1=\"value1\",label2=\"value2\",le=\"2\"} 4000\n"
+        "t_bucket{label1=\"value1\",label2=\"value2\",le=\"3\"} 4000\n"
+        "t_bucket{label1=\"value1\",label2=\"value2\",le=\"+Inf\"} 4000\n"
+        "t_sum{label1=\"value1\",label2=\"value2\"} 8000\n"
+        "t_count{label1=\"value1\",label2=\"value2\"} 4000\n"
+    );
+}
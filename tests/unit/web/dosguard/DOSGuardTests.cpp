@@ -26,7 +26,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <string_view>
+#include <thread>
 
 using namespace testing;
 using namespace util;
@@ -126,3 +128,56 @@ TEST_F(DOSGuardTest, RequestLimitOnTimer)
     guard.clear();
     EXPECT_TRUE(guard.isOk(IP));  // can request again
 }
+
+struct DOSGuardSlidingWindowTest : NoLoggerFixture {
+    static constexpr auto JSONData = R"JSON(
+    {
+        "dos_guard": {
+            "max_connections": 2,
+            "max_requests": 3,
+            "sweep_interval": 0.1
+        }
+    }
+)JSON";
+
+    static constexpr auto IP = "127.0.0.2";
+
+    Config cfg{json::parse(JSONData)};
+    NiceMock<DOSGuardTest::MockWhitelistHandler> whitelistHandler;
+    DOSGuard guard{cfg, whitelistHandler};
+};
+
+TEST_F(DOSGuardSlidingWindowTest, PreviousWindowDecays)
+{
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_FALSE(guard.request(IP));
+
+    // most of the previous window still overlaps the sliding one
+    std::this_thread::sleep_for(std::chrono::milliseconds{120});
+    EXPECT_TRUE(guard.isOk(IP));
+    EXPECT_FALSE(guard.request(IP));
+
+    // both windows are over
+    std::this_thread::sleep_for(std::chrono::milliseconds{250});
+    EXPECT_TRUE(guard.isOk(IP));
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_TRUE(guard.request(IP));
+}
+
+TEST_F(DOSGuardSlidingWindowTest, SweepKeepsConnections)
+{
+    guard.increment(IP);
+    guard.increment(IP);
+    guard.increment(IP);
+    EXPECT_FALSE(guard.isOk(IP));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{250});
+    guard.sweep();
+    EXPECT_FALSE(guard.isOk(IP));
+
+    guard.decrement(IP);
+    EXPECT_TRUE(guard.isOk(IP));
+}
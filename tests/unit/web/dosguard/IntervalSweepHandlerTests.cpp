@@ -42,6 +42,7 @@ protected:
 
     struct DosGuardMock : BaseDOSGuard {
         MOCK_METHOD(void, clear, (), (noexcept, override));
+        MOCK_METHOD(void, sweep, (), (noexcept, override));
     };
     testing::StrictMock<DosGuardMock> guardMock;
 
@@ -51,6 +52,6 @@ protected:
 
 TEST_F(IntervalSweepHandlerTest, SweepAfterInterval)
 {
-    EXPECT_CALL(guardMock, clear()).Times(testing::AtLeast(10));
+    EXPECT_CALL(guardMock, sweep()).Times(testing::AtLeast(10));
     runContextFor(std::chrono::milliseconds{20});
 }
@@ -64,6 +64,9 @@ TEST_F(WhitelistHandlerTest, TestWhiteListIPV4)
     EXPECT_FALSE(whitelistHandler.isWhiteListed("193.168.0.123"));
     EXPECT_TRUE(whitelistHandler.isWhiteListed("10.0.0.1"));
     EXPECT_FALSE(whitelistHandler.isWhiteListed("10.0.0.2"));
+    EXPECT_TRUE(whitelistHandler.isWhiteListed("192.168.3.255"));
+    EXPECT_FALSE(whitelistHandler.isWhiteListed("192.168.4.0"));
+    EXPECT_FALSE(whitelistHandler.isWhiteListed("not an ip"));
 }
 
 TEST_F(WhitelistHandlerTest, TestWhiteListResolvesHostname)